@@ -32,6 +32,7 @@ const char* Init(void)
     R3D_AddKeyframe(&curve, 0.0f, 0.0f);
     R3D_AddKeyframe(&curve, 0.5f, 1.0f);
     R3D_AddKeyframe(&curve, 1.0f, 0.0f);
+    R3D_BakeCurve(&curve, 256, R3D_CURVE_HERMITE);
 
     particles = R3D_LoadParticleSystem(2048);
     particles.initialVelocity = (Vector3){ 0, 10.0f, 0 };
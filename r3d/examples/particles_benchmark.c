@@ -0,0 +1,78 @@
+#include <r3d.h>
+#include <raylib.h>
+
+#include <stdio.h>
+
+/* === Configuration === */
+
+static const int particleCounts[] = { 10000, 100000, 1000000 };
+static const int threadCounts[] = { 1, 2, 4, 8, 0 };    // 0 uses every hardware thread
+
+#define FRAME_COUNT 60
+
+/* === Helper functions === */
+
+static R3D_ParticleSystem LoadSystem(int maxParticles, R3D_ParticleStorage storage)
+{
+    R3D_ParticleSystem system = R3D_LoadParticleSystemEx(maxParticles, storage);
+
+    system.initialVelocity = (Vector3) { 0, 10.0f, 0 };
+    system.velocityVariance = (Vector3) { 2.0f, 2.0f, 2.0f };
+    system.initialAngularVelocity = (Vector3) { 45.0f, 90.0f, 0.0f };
+    system.spreadAngle = 45.0f;
+    system.lifetime = 1000.0f;
+    system.autoEmission = false;
+
+    // Fill the system so that every frame updates the same amount of particles
+    R3D_EmitParticles(&system, maxParticles);
+
+    return system;
+}
+
+static double MeasureUpdate(int maxParticles, R3D_ParticleStorage storage)
+{
+    R3D_ParticleSystem system = LoadSystem(maxParticles, storage);
+
+    double start = GetTime();
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        R3D_UpdateParticleSystem(&system, 1.0f / 60.0f);
+    }
+    double elapsed = GetTime() - start;
+
+    R3D_UnloadParticleSystem(&system);
+
+    return 1000.0 * elapsed / FRAME_COUNT;
+}
+
+/* === Main program === */
+
+int main(void)
+{
+    // A hidden window is enough, the benchmark only measures CPU updates
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    SetTraceLogLevel(LOG_WARNING);
+    InitWindow(320, 240, "[r3d] - particles benchmark");
+    R3D_Init(320, 240, 0);
+
+    const char* storageNames[] = { "AoS", "SoA" };
+
+    printf("%-8s %-10s %-8s %-12s %-8s\n", "storage", "particles", "threads", "ms/update", "speedup");
+
+    for (int storage = 0; storage < 2; storage++) {
+        for (int p = 0; p < (int)(sizeof(particleCounts) / sizeof(*particleCounts)); p++) {
+            double reference = 0.0;
+            for (int t = 0; t < (int)(sizeof(threadCounts) / sizeof(*threadCounts)); t++) {
+                R3D_SetParticleThreadCount(threadCounts[t]);
+                double ms = MeasureUpdate(particleCounts[p], (R3D_ParticleStorage)storage);
+                if (t == 0) reference = ms;
+                printf("%-8s %-10i %-8i %-12.3f %-8.2f\n", storageNames[storage], particleCounts[p],
+                    R3D_GetParticleThreadCount(), ms, reference / ms);
+            }
+        }
+    }
+
+    R3D_Close();
+    CloseWindow();
+
+    return 0;
+}
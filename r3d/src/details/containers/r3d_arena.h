@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#ifndef R3D_ARENA_H
+#define R3D_ARENA_H
+
+#include <raylib.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Linear allocator for the data that only lives for one frame.
+ *
+ * Allocations bump an offset in the current block, a new block is chained when it is full.
+ * Everything is released at once by 'r3d_arena_reset', which also merges the chained blocks
+ * into a single one large enough for the whole frame, so frames of a similar size end up
+ * never touching the heap.
+ */
+
+/* Types definitions */
+
+#define R3D_ARENA_ALIGNMENT 16
+#define R3D_ARENA_MIN_BLOCK_SIZE (64 * 1024)
+
+typedef struct r3d_arena_block_t {
+    struct r3d_arena_block_t *prev; // Previous block of the chain
+    size_t capacity;                // Usable bytes after the header
+    size_t offset;                  // Bytes already allocated in this block
+} r3d_arena_block_t;
+
+typedef struct r3d_arena_t {
+    r3d_arena_block_t *block;   // Current block, older ones are chained through 'prev'
+    void *last;                 // Most recent allocation, the only one that can grow in place
+    size_t used;                // Bytes allocated since the last reset
+    size_t capacity;            // Usable bytes of all blocks
+    size_t last_frame;          // Bytes allocated between the two last resets
+    size_t high_water;          // Largest 'used' value reached
+    unsigned int block_count;   // Number of blocks in the chain
+    unsigned int heap_allocs;   // Number of blocks allocated since creation
+} r3d_arena_t;
+
+typedef struct r3d_arena_mark_t {
+    r3d_arena_block_t *block;
+    size_t offset;
+    size_t used;
+} r3d_arena_mark_t;
+
+/* Helper functions */
+
+static inline size_t
+r3d_arena_align(size_t size)
+{
+    return (size + R3D_ARENA_ALIGNMENT - 1) & ~(size_t)(R3D_ARENA_ALIGNMENT - 1);
+}
+
+static inline void*
+r3d_arena_block_data(r3d_arena_block_t* block)
+{
+    return (char*)block + r3d_arena_align(sizeof(r3d_arena_block_t));
+}
+
+static inline bool
+r3d_arena_push_block(r3d_arena_t* arena, size_t capacity)
+{
+    // NOTE: RL_MALLOC is expected to return memory aligned for any standard type,
+    //       16 bytes on every platform r3d targets
+    r3d_arena_block_t *block = RL_MALLOC(r3d_arena_align(sizeof(r3d_arena_block_t)) + capacity);
+    if (!block) return false;
+
+    block->prev = arena->block;
+    block->capacity = capacity;
+    block->offset = 0;
+
+    arena->block = block;
+    arena->capacity += capacity;
+    arena->block_count++;
+    arena->heap_allocs++;
+
+    return true;
+}
+
+/* Function definitions */
+
+static inline r3d_arena_t
+r3d_arena_create(size_t capacity)
+{
+    r3d_arena_t arena = { 0 };
+
+    if (capacity < R3D_ARENA_MIN_BLOCK_SIZE) {
+        capacity = R3D_ARENA_MIN_BLOCK_SIZE;
+    }
+
+    r3d_arena_push_block(&arena, r3d_arena_align(capacity));
+
+    return arena;
+}
+
+static inline void
+r3d_arena_destroy(r3d_arena_t* arena)
+{
+    r3d_arena_block_t *block = arena->block;
+    while (block) {
+        r3d_arena_block_t *prev = block->prev;
+        RL_FREE(block);
+        block = prev;
+    }
+    memset(arena, 0, sizeof(r3d_arena_t));
+}
+
+static inline void*
+r3d_arena_alloc(r3d_arena_t* arena, size_t size)
+{
+    size = r3d_arena_align(size > 0 ? size : 1);
+
+    r3d_arena_block_t *block = arena->block;
+
+    if (!block || block->offset + size > block->capacity) {
+        // Each new block at least doubles the arena so that a frame needs few of them
+        size_t capacity = (arena->capacity > R3D_ARENA_MIN_BLOCK_SIZE) ? arena->capacity : R3D_ARENA_MIN_BLOCK_SIZE;
+        if (capacity < size) capacity = size;
+        if (!r3d_arena_push_block(arena, capacity)) return NULL;
+        block = arena->block;
+    }
+
+    void *ptr = (char*)r3d_arena_block_data(block) + block->offset;
+    block->offset += size;
+
+    arena->last = ptr;
+    arena->used += size;
+    if (arena->used > arena->high_water) {
+        arena->high_water = arena->used;
+    }
+
+    return ptr;
+}
+
+static inline void*
+r3d_arena_realloc(r3d_arena_t* arena, void* ptr, size_t old_size, size_t new_size)
+{
+    if (!ptr) {
+        return r3d_arena_alloc(arena, new_size);
+    }
+
+    old_size = r3d_arena_align(old_size);
+    new_size = r3d_arena_align(new_size);
+
+    if (new_size <= old_size) {
+        return ptr;
+    }
+
+    // The last allocation grows in place when its block still has room
+    r3d_arena_block_t *block = arena->block;
+    if (ptr == arena->last && block->offset + (new_size - old_size) <= block->capacity) {
+        block->offset += new_size - old_size;
+        arena->used += new_size - old_size;
+        if (arena->used > arena->high_water) {
+            arena->high_water = arena->used;
+        }
+        return ptr;
+    }
+
+    // Otherwise the old range is abandoned until the next reset
+    void *new_ptr = r3d_arena_alloc(arena, new_size);
+    if (!new_ptr) return NULL;
+
+    memcpy(new_ptr, ptr, old_size);
+
+    return new_ptr;
+}
+
+static inline r3d_arena_mark_t
+r3d_arena_get_mark(const r3d_arena_t* arena)
+{
+    r3d_arena_mark_t mark = { 0 };
+
+    mark.block = arena->block;
+    mark.offset = arena->block ? arena->block->offset : 0;
+    mark.used = arena->used;
+
+    return mark;
+}
+
+static inline void
+r3d_arena_release(r3d_arena_t* arena, r3d_arena_mark_t mark)
+{
+    // Only rewinds when no block was chained since the mark,
+    // otherwise the memory is recovered by the next reset
+    if (arena->block == mark.block && mark.block) {
+        mark.block->offset = mark.offset;
+        arena->used = mark.used;
+        arena->last = NULL;
+    }
+}
+
+static inline void
+r3d_arena_reset(r3d_arena_t* arena)
+{
+    arena->last_frame = arena->used;
+    arena->used = 0;
+    arena->last = NULL;
+
+    // Merge the chain into one block holding the whole capacity
+    if (arena->block_count > 1) {
+        size_t capacity = arena->capacity;
+
+        r3d_arena_block_t *block = arena->block;
+        while (block) {
+            r3d_arena_block_t *prev = block->prev;
+            RL_FREE(block);
+            block = prev;
+        }
+
+        arena->block = NULL;
+        arena->capacity = 0;
+        arena->block_count = 0;
+
+        r3d_arena_push_block(arena, capacity);
+    }
+    else if (arena->block) {
+        arena->block->offset = 0;
+    }
+}
+
+#endif // R3D_ARENA_H
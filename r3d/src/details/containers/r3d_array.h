@@ -26,6 +26,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "./r3d_arena.h"
+
 /* Types definitions */
 
 enum r3d_retcode_array {
@@ -40,6 +42,7 @@ typedef struct r3d_array_t {
     size_t count;           // Number of elements currently in the array
     size_t capacity;        // Total array capacity (allocated space)
     size_t elem_size;       // Size of an element (in bytes)
+    r3d_arena_t *arena;     // Arena providing the memory, NULL for the heap
 } r3d_array_t;
 
 /* Function definitions */
@@ -63,16 +66,44 @@ r3d_array_create(size_t capacity, size_t elem_size)
     return vec;
 }
 
+static inline r3d_array_t
+r3d_array_create_in_arena(r3d_arena_t* arena, size_t capacity, size_t elem_size)
+{
+    r3d_array_t vec = { 0 };
+
+    if (elem_size == 0) {
+        return vec;
+    }
+
+    // Kept even without storage, so that the array can still grow from the arena
+    vec.elem_size = elem_size;
+    vec.arena = arena;
+
+    if (capacity == 0) {
+        return vec;
+    }
+
+    void *data = r3d_arena_alloc(arena, capacity * elem_size);
+    if (!data) return vec;
+
+    vec.data = data;
+    vec.capacity = capacity;
+
+    return vec;
+}
+
 static inline void
 r3d_array_destroy(r3d_array_t* vec)
 {
-    if (vec->data) {
+    // Arena memory is released with the arena itself
+    if (vec->data && !vec->arena) {
         RL_FREE(vec->data);
-        vec->data = NULL;
     }
+    vec->data = NULL;
     vec->count = 0;
     vec->capacity = 0;
     vec->elem_size = 0;
+    vec->arena = NULL;
 }
 
 static inline r3d_array_t
@@ -116,7 +147,10 @@ r3d_array_reserve(r3d_array_t* vec, size_t new_capacity)
         return R3D_ARRAY_SUCCESS;
     }
 
-    void *new_data = RL_REALLOC(vec->data, new_capacity * vec->elem_size);
+    void *new_data = vec->arena
+        ? r3d_arena_realloc(vec->arena, vec->data, vec->capacity * vec->elem_size, new_capacity * vec->elem_size)
+        : RL_REALLOC(vec->data, new_capacity * vec->elem_size);
+
     if (!new_data) return R3D_ARRAY_ERROR_OUT_OF_MEMORY;
 
     vec->data = new_data;
@@ -136,6 +170,11 @@ r3d_array_shrink_to_fit(r3d_array_t* vec)
         return R3D_ARRAY_EMPTY;
     }
 
+    // Arena memory cannot be given back before the next reset
+    if (vec->arena) {
+        return R3D_ARRAY_SUCCESS;
+    }
+
     void *new_data = RL_REALLOC(vec->data, vec->count * vec->elem_size);
     if (!new_data) return R3D_ARRAY_ERROR_OUT_OF_MEMORY;
 
@@ -25,12 +25,29 @@
 #include <stdlib.h>
 #include <string.h>
 
+/*
+ * Handles pack a slot index (plus one, so that 0 is never valid) in the low bits and
+ * the generation of that slot in the high bits. Removing an element bumps the generation
+ * of its slot, so handles kept after a removal no longer resolve, even once the slot
+ * is reused. Live elements are packed in 'elements' and can be iterated directly.
+ */
+
+#define R3D_REGISTRY_INDEX_BITS 20
+#define R3D_REGISTRY_INDEX_MASK ((1u << R3D_REGISTRY_INDEX_BITS) - 1)
+#define R3D_REGISTRY_GENERATION_MASK ((1u << (32 - R3D_REGISTRY_INDEX_BITS)) - 1)
+
+typedef struct {
+    unsigned int dense;         // Index of the element in 'elements'
+    unsigned int generation;    // Incremented each time the slot is freed
+    bool alive;
+} r3d_registry_slot_t;
+
 typedef struct {
-    r3d_array_t elements;    // Stocke les objets directement (contigu)
-    r3d_array_t valid_flags; // Stocke si un ID est valide (tableau boolen)
-    r3d_array_t free_ids;    // Liste des IDs librs
-    unsigned int next_id;    // Prochain ID  attribuer
-    size_t elem_size;        // Taille d'un lment
+    r3d_array_t elements;       // Live elements, packed
+    r3d_array_t handles;        // Handle of each element in 'elements'
+    r3d_array_t slots;          // Slot of each handle, indexed by 'handle & R3D_REGISTRY_INDEX_MASK' minus one
+    r3d_array_t free_slots;     // Slots available for reuse
+    size_t elem_size;
 } r3d_registry_t;
 
 static inline r3d_registry_t
@@ -38,9 +55,9 @@ r3d_registry_create(size_t capacity, size_t elem_size)
 {
     r3d_registry_t registry = { 0 };
     registry.elements = r3d_array_create(capacity, elem_size);
-    registry.valid_flags = r3d_array_create(capacity, sizeof(bool));
-    registry.free_ids = r3d_array_create(capacity, sizeof(unsigned int));
-    registry.next_id = 1;
+    registry.handles = r3d_array_create(capacity, sizeof(unsigned int));
+    registry.slots = r3d_array_create(capacity, sizeof(r3d_registry_slot_t));
+    registry.free_slots = r3d_array_create(capacity, sizeof(unsigned int));
     registry.elem_size = elem_size;
     return registry;
 }
@@ -48,38 +65,56 @@ r3d_registry_create(size_t capacity, size_t elem_size)
 static inline void
 r3d_registry_destroy(r3d_registry_t* registry)
 {
-    r3d_array_destroy(&registry->valid_flags);
-    r3d_array_destroy(&registry->free_ids);
+    r3d_array_destroy(&registry->free_slots);
+    r3d_array_destroy(&registry->slots);
+    r3d_array_destroy(&registry->handles);
     r3d_array_destroy(&registry->elements);
 }
 
+static inline r3d_registry_slot_t*
+r3d_registry_get_slot(r3d_registry_t* registry, unsigned int id)
+{
+    unsigned int index = id & R3D_REGISTRY_INDEX_MASK;
+    if (index == 0 || index > registry->slots.count) return NULL;
+
+    r3d_registry_slot_t* slot = (r3d_registry_slot_t*)registry->slots.data + (index - 1);
+    if (!slot->alive || slot->generation != (id >> R3D_REGISTRY_INDEX_BITS)) return NULL;
+
+    return slot;
+}
+
 static inline bool
 r3d_registry_is_valid(r3d_registry_t* registry, unsigned int id)
 {
-    if (id == 0 || id >= registry->next_id) return false;
-    return ((bool*)registry->valid_flags.data)[id - 1];
+    return r3d_registry_get_slot(registry, id) != NULL;
 }
 
 static inline unsigned int
 r3d_registry_add(r3d_registry_t* registry, void* element)
 {
-    unsigned int id = 0;
+    unsigned int index = 0;
 
-    if (registry->free_ids.count > 0) {
-        r3d_array_pop_back(&registry->free_ids, &id);
+    if (registry->free_slots.count > 0) {
+        r3d_array_pop_back(&registry->free_slots, &index);
     }
     else {
-        r3d_array_push_back(&registry->elements, NULL);
-        r3d_array_push_back(&registry->valid_flags, &(bool){true});
-        id = registry->next_id++;
+        if (registry->slots.count >= R3D_REGISTRY_INDEX_MASK) return 0;
+        if (r3d_array_push_back(&registry->slots, NULL) < 0) return 0;
+        index = (unsigned int)registry->slots.count - 1;
     }
 
-    void* elem = r3d_array_at(&registry->elements, id - 1);
+    r3d_registry_slot_t* slot = (r3d_registry_slot_t*)registry->slots.data + index;
+    unsigned int id = (slot->generation << R3D_REGISTRY_INDEX_BITS) | (index + 1);
 
-    if (element) memcpy(elem, element, registry->elem_size);
-    else memset(elem, 0, registry->elem_size);
+    if (r3d_array_push_back(&registry->elements, element) < 0 ||
+        r3d_array_push_back(&registry->handles, &id) < 0) {
+        registry->elements.count = registry->handles.count;
+        r3d_array_push_back(&registry->free_slots, &index);
+        return 0;
+    }
 
-    ((bool*)registry->valid_flags.data)[id - 1] = true;
+    slot->dense = (unsigned int)registry->elements.count - 1;
+    slot->alive = true;
 
     return id;
 }
@@ -87,23 +122,46 @@ r3d_registry_add(r3d_registry_t* registry, void* element)
 static inline void
 r3d_registry_remove(r3d_registry_t* registry, unsigned int id)
 {
-    if (!r3d_registry_is_valid(registry, id)) return;
+    r3d_registry_slot_t* slot = r3d_registry_get_slot(registry, id);
+    if (slot == NULL) return;
+
+    // Move the last element into the hole to keep the elements packed
+    unsigned int last = (unsigned int)registry->elements.count - 1;
+    if (slot->dense != last) {
+        unsigned int lastId = ((unsigned int*)registry->handles.data)[last];
+        memcpy(r3d_array_at(&registry->elements, slot->dense), r3d_array_at(&registry->elements, last), registry->elem_size);
+        ((unsigned int*)registry->handles.data)[slot->dense] = lastId;
+        ((r3d_registry_slot_t*)registry->slots.data)[(lastId & R3D_REGISTRY_INDEX_MASK) - 1].dense = slot->dense;
+    }
+
+    r3d_array_pop_back(&registry->elements, NULL);
+    r3d_array_pop_back(&registry->handles, NULL);
+
+    slot->alive = false;
+    slot->generation = (slot->generation + 1) & R3D_REGISTRY_GENERATION_MASK;
 
-    r3d_array_push_back(&registry->free_ids, &id);
-    ((bool*)registry->valid_flags.data)[id - 1] = false;
+    unsigned int index = (id & R3D_REGISTRY_INDEX_MASK) - 1;
+    r3d_array_push_back(&registry->free_slots, &index);
 }
 
 static inline void*
 r3d_registry_get(r3d_registry_t* registry, unsigned int id)
 {
-    if (!r3d_registry_is_valid(registry, id)) return NULL;
-    return r3d_array_at(&registry->elements, id - 1);
+    r3d_registry_slot_t* slot = r3d_registry_get_slot(registry, id);
+    if (slot == NULL) return NULL;
+    return r3d_array_at(&registry->elements, slot->dense);
 }
 
 static inline unsigned int
-r3d_registry_get_allocated_count(r3d_registry_t* registry)
+r3d_registry_get_count(r3d_registry_t* registry)
 {
     return (unsigned int)registry->elements.count;
 }
 
+static inline void*
+r3d_registry_at(r3d_registry_t* registry, unsigned int index)
+{
+    return r3d_array_at(&registry->elements, index);
+}
+
 #endif // R3D_REGISTRY_H
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_HASH_H
+#define R3D_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* === Defines === */
+
+#define R3D_HASH_FNV1A_SEED 0xCBF29CE484222325ULL
+
+/* === FNV-1a 64 bits === */
+
+static inline uint64_t r3d_hash_fnv1a(uint64_t hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+static inline uint64_t r3d_hash_fnv1a_str(uint64_t hash, const char* str)
+{
+    // The terminator is hashed too so that consecutive strings cannot alias
+    do {
+        hash ^= (unsigned char)*str;
+        hash *= 0x100000001B3ULL;
+    } while (*str++ != '\0');
+
+    return hash;
+}
+
+#endif // R3D_HASH_H
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#ifndef R3D_RANDOM_H
+#define R3D_RANDOM_H
+
+#include <stdint.h>
+
+/*
+ * PCG32 generator (XSH RR variant), 64 bits of state and 32 bits outputs.
+ * Each user owns its state, sequences are reproducible for a given seed and
+ * independent from raylib's global generator.
+ */
+
+/* === Defines === */
+
+#define R3D_PCG32_MULTIPLIER 6364136223846793005ULL
+#define R3D_PCG32_INCREMENT 1442695040888963407ULL
+
+/* === Functions === */
+
+static inline uint32_t r3d_pcg32_next(uint64_t* state)
+{
+    uint64_t old = *state;
+    *state = old * R3D_PCG32_MULTIPLIER + R3D_PCG32_INCREMENT;
+
+    uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = (uint32_t)(old >> 59u);
+
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31u));
+}
+
+static inline uint64_t r3d_pcg32_seed(uint64_t seed)
+{
+    uint64_t state = 0;
+    r3d_pcg32_next(&state);
+    state += seed;
+    r3d_pcg32_next(&state);
+    return state;
+}
+
+static inline float r3d_pcg32_next_float(uint64_t* state)
+{
+    // The 24 upper bits fill the float mantissa exactly, result in [0, 1)
+    return (float)(r3d_pcg32_next(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+static inline void r3d_pcg32_fill_floats(uint64_t* state, float* out, int count)
+{
+    // Working on a local copy lets the compiler keep the state in a register
+    uint64_t s = *state;
+    for (int i = 0; i < count; i++) {
+        out[i] = r3d_pcg32_next_float(&s);
+    }
+    *state = s;
+}
+
+#endif // R3D_RANDOM_H
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_SIMD_H
+#define R3D_SIMD_H
+
+#include <math.h>
+
+/*
+ * Minimal float vector abstraction used by the CPU kernels.
+ *
+ * The widest instruction set enabled at compile time is selected (AVX2, then SSE2),
+ * with a scalar fallback. Kernels are written once against these functions and
+ * process 'R3D_SIMD_WIDTH' floats per iteration. Loads and stores are aligned,
+ * arrays must be aligned on 'R3D_SIMD_ALIGNMENT' bytes.
+ */
+
+/* === Instruction set selection === */
+
+// NOTE: The 8 wide path requires AVX2, with AVX alone compilers split
+//       the lane extraction into slow sequences and SSE2 ends up faster
+#if defined(__AVX2__)
+#   define R3D_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define R3D_SIMD_SSE2
+#endif
+
+#if defined(R3D_SIMD_AVX)
+#   include <immintrin.h>
+#   define R3D_SIMD_WIDTH 8
+typedef __m256 r3d_simd_t;
+#elif defined(R3D_SIMD_SSE2)
+#   include <emmintrin.h>
+#   define R3D_SIMD_WIDTH 4
+typedef __m128 r3d_simd_t;
+#else
+#   define R3D_SIMD_WIDTH 1
+typedef float r3d_simd_t;
+#endif
+
+#define R3D_SIMD_ALIGNMENT 32   //< Enough for every supported width
+
+#define R3D_SIMD_PI 3.14159265358979323846f
+#define R3D_SIMD_HALF_PI 1.57079632679489661923f
+#define R3D_SIMD_INV_TWO_PI 0.15915494309189533577f
+#define R3D_SIMD_TWO_PI_HI 6.28125f
+#define R3D_SIMD_TWO_PI_LO 1.9353071795864769e-3f
+
+/* === Basic operations === */
+
+static inline r3d_simd_t r3d_simd_load(const float* p)
+{
+#if defined(R3D_SIMD_AVX)
+    return _mm256_load_ps(p);
+#elif defined(R3D_SIMD_SSE2)
+    return _mm_load_ps(p);
+#else
+    return *p;
+#endif
+}
+
+static inline void r3d_simd_store(float* p, r3d_simd_t v)
+{
+#if defined(R3D_SIMD_AVX)
+    _mm256_store_ps(p, v);
+#elif defined(R3D_SIMD_SSE2)
+    _mm_store_ps(p, v);
+#else
+    *p = v;
+#endif
+}
+
+static inline r3d_simd_t r3d_simd_set1(float x)
+{
+#if defined(R3D_SIMD_AVX)
+    return _mm256_set1_ps(x);
+#elif defined(R3D_SIMD_SSE2)
+    return _mm_set1_ps(x);
+#else
+    return x;
+#endif
+}
+
+static inline r3d_simd_t r3d_simd_add(r3d_simd_t a, r3d_simd_t b)
+{
+#if defined(R3D_SIMD_AVX)
+    return _mm256_add_ps(a, b);
+#elif defined(R3D_SIMD_SSE2)
+    return _mm_add_ps(a, b);
+#else
+    return a + b;
+#endif
+}
+
+static inline r3d_simd_t r3d_simd_sub(r3d_simd_t a, r3d_simd_t b)
+{
+#if defined(R3D_SIMD_AVX)
+    return _mm256_sub_ps(a, b);
+#elif defined(R3D_SIMD_SSE2)
+    return _mm_sub_ps(a, b);
+#else
+    return a - b;
+#endif
+}
+
+static inline r3d_simd_t r3d_simd_mul(r3d_simd_t a, r3d_simd_t b)
+{
+#if defined(R3D_SIMD_AVX)
+    return _mm256_mul_ps(a, b);
+#elif defined(R3D_SIMD_SSE2)
+    return _mm_mul_ps(a, b);
+#else
+    return a * b;
+#endif
+}
+
+static inline r3d_simd_t r3d_simd_div(r3d_simd_t a, r3d_simd_t b)
+{
+#if defined(R3D_SIMD_AVX)
+    return _mm256_div_ps(a, b);
+#elif defined(R3D_SIMD_SSE2)
+    return _mm_div_ps(a, b);
+#else
+    return a / b;
+#endif
+}
+
+static inline r3d_simd_t r3d_simd_min(r3d_simd_t a, r3d_simd_t b)
+{
+#if defined(R3D_SIMD_AVX)
+    return _mm256_min_ps(a, b);
+#elif defined(R3D_SIMD_SSE2)
+    return _mm_min_ps(a, b);
+#else
+    return (a < b) ? a : b;
+#endif
+}
+
+static inline r3d_simd_t r3d_simd_max(r3d_simd_t a, r3d_simd_t b)
+{
+#if defined(R3D_SIMD_AVX)
+    return _mm256_max_ps(a, b);
+#elif defined(R3D_SIMD_SSE2)
+    return _mm_max_ps(a, b);
+#else
+    return (a > b) ? a : b;
+#endif
+}
+
+static inline r3d_simd_t r3d_simd_select_gt(r3d_simd_t a, r3d_simd_t b, r3d_simd_t x, r3d_simd_t y)
+{
+    // Per lane: (a > b) ? x : y
+#if defined(R3D_SIMD_AVX)
+    return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_GT_OQ));
+#elif defined(R3D_SIMD_SSE2)
+    __m128 mask = _mm_cmpgt_ps(a, b);
+    return _mm_or_ps(_mm_and_ps(mask, x), _mm_andnot_ps(mask, y));
+#else
+    return (a > b) ? x : y;
+#endif
+}
+
+/* === Trigonometry === */
+
+#if defined(R3D_SIMD_AVX) || defined(R3D_SIMD_SSE2)
+
+static inline r3d_simd_t r3d_simd_round(r3d_simd_t v)
+{
+    // Round to nearest through an int conversion, enough for the trigonometric range reduction
+#if defined(R3D_SIMD_AVX)
+    return _mm256_cvtepi32_ps(_mm256_cvtps_epi32(v));
+#else
+    return _mm_cvtepi32_ps(_mm_cvtps_epi32(v));
+#endif
+}
+
+static inline r3d_simd_t r3d_simd_sin_reduced(r3d_simd_t x)
+{
+    // Bring x into [-PI, PI], 2*PI is split in two parts to limit the rounding error
+    r3d_simd_t k = r3d_simd_round(r3d_simd_mul(x, r3d_simd_set1(R3D_SIMD_INV_TWO_PI)));
+    x = r3d_simd_sub(x, r3d_simd_mul(k, r3d_simd_set1(R3D_SIMD_TWO_PI_HI)));
+    x = r3d_simd_sub(x, r3d_simd_mul(k, r3d_simd_set1(R3D_SIMD_TWO_PI_LO)));
+
+    // Fold into [-PI/2, PI/2] using sin(x) = sin(PI - x) = sin(-PI - x)
+    x = r3d_simd_select_gt(x, r3d_simd_set1(R3D_SIMD_HALF_PI), r3d_simd_sub(r3d_simd_set1(R3D_SIMD_PI), x), x);
+    x = r3d_simd_select_gt(r3d_simd_set1(-R3D_SIMD_HALF_PI), x, r3d_simd_sub(r3d_simd_set1(-R3D_SIMD_PI), x), x);
+
+    // Taylor series up to x^11, error below 1e-7 on [-PI/2, PI/2]
+    r3d_simd_t x2 = r3d_simd_mul(x, x);
+    r3d_simd_t p = r3d_simd_set1(-2.5052108385e-08f);
+    p = r3d_simd_add(r3d_simd_mul(p, x2), r3d_simd_set1(2.7557319224e-06f));
+    p = r3d_simd_add(r3d_simd_mul(p, x2), r3d_simd_set1(-1.9841269841e-04f));
+    p = r3d_simd_add(r3d_simd_mul(p, x2), r3d_simd_set1(8.3333333333e-03f));
+    p = r3d_simd_add(r3d_simd_mul(p, x2), r3d_simd_set1(-1.6666666667e-01f));
+    p = r3d_simd_add(r3d_simd_mul(p, x2), r3d_simd_set1(1.0f));
+
+    return r3d_simd_mul(p, x);
+}
+
+#endif
+
+static inline void r3d_simd_sincos(r3d_simd_t x, r3d_simd_t* s, r3d_simd_t* c)
+{
+#if defined(R3D_SIMD_AVX) || defined(R3D_SIMD_SSE2)
+    *s = r3d_simd_sin_reduced(x);
+    *c = r3d_simd_sin_reduced(r3d_simd_add(x, r3d_simd_set1(R3D_SIMD_HALF_PI)));
+#else
+    *s = sinf(x);
+    *c = cosf(x);
+#endif
+}
+
+#endif // R3D_SIMD_H
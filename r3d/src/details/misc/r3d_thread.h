@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_MISC_THREAD_H
+#define R3D_DETAILS_MISC_THREAD_H
+
+// NOTE: Files including this header must not include raylib, 'windows.h' conflicts with several of its declarations
+
+#if defined(_WIN32)
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#else
+#   include <pthread.h>
+#   include <unistd.h>
+#endif
+
+/* === Platform wrappers === */
+
+#if defined(_WIN32)
+
+typedef HANDLE r3d_thread_t;
+typedef CRITICAL_SECTION r3d_mutex_t;
+typedef CONDITION_VARIABLE r3d_cond_t;
+
+#define r3d_mutex_init(m)       InitializeCriticalSection(m)
+#define r3d_mutex_destroy(m)    DeleteCriticalSection(m)
+#define r3d_mutex_lock(m)       EnterCriticalSection(m)
+#define r3d_mutex_unlock(m)     LeaveCriticalSection(m)
+#define r3d_cond_init(c)        InitializeConditionVariable(c)
+#define r3d_cond_destroy(c)     ((void)(c))
+#define r3d_cond_wait(c, m)     SleepConditionVariableCS(c, m, INFINITE)
+#define r3d_cond_broadcast(c)   WakeAllConditionVariable(c)
+
+#else
+
+typedef pthread_t r3d_thread_t;
+typedef pthread_mutex_t r3d_mutex_t;
+typedef pthread_cond_t r3d_cond_t;
+
+#define r3d_mutex_init(m)       pthread_mutex_init(m, NULL)
+#define r3d_mutex_destroy(m)    pthread_mutex_destroy(m)
+#define r3d_mutex_lock(m)       pthread_mutex_lock(m)
+#define r3d_mutex_unlock(m)     pthread_mutex_unlock(m)
+#define r3d_cond_init(c)        pthread_cond_init(c, NULL)
+#define r3d_cond_destroy(c)     pthread_cond_destroy(c)
+#define r3d_cond_wait(c, m)     pthread_cond_wait(c, m)
+#define r3d_cond_broadcast(c)   pthread_cond_broadcast(c)
+
+#endif
+
+#endif // R3D_DETAILS_MISC_THREAD_H
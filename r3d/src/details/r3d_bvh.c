@@ -0,0 +1,450 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_bvh.h"
+
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+
+/* === Internal constants === */
+
+#define R3D_BVH_BINS 8
+#define R3D_BVH_LEAF_SIZE 4         //< Nodes with this many items or less are never split
+#define R3D_BVH_MAX_LEAF_SIZE 8     //< Nodes with more items are split even when the heuristic disagrees
+#define R3D_BVH_SAH_DEPTH 32        //< Deeper nodes are split at the median, bounding the tree depth
+#define R3D_BVH_STACK_SIZE 64
+
+/* === Internal types === */
+
+typedef struct {
+    int node;
+    float dist;
+} r3d_bvh_ray_entry_t;
+
+/* === Internal functions === */
+
+static float r3d_bvh_axis(Vector3 v, int axis)
+{
+    return (axis == 0) ? v.x : (axis == 1) ? v.y : v.z;
+}
+
+static float r3d_bvh_area(Vector3 min, Vector3 max)
+{
+    float dx = max.x - min.x;
+    float dy = max.y - min.y;
+    float dz = max.z - min.z;
+
+    if (dx < 0.0f || dy < 0.0f || dz < 0.0f) {
+        return 0.0f;
+    }
+
+    return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+static void r3d_bvh_empty(Vector3* min, Vector3* max)
+{
+    *min = (Vector3) { FLT_MAX, FLT_MAX, FLT_MAX };
+    *max = (Vector3) { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+}
+
+static void r3d_bvh_grow(Vector3* min, Vector3* max, Vector3 pmin, Vector3 pmax)
+{
+    min->x = fminf(min->x, pmin.x);
+    min->y = fminf(min->y, pmin.y);
+    min->z = fminf(min->z, pmin.z);
+    max->x = fmaxf(max->x, pmax.x);
+    max->y = fmaxf(max->y, pmax.y);
+    max->z = fmaxf(max->z, pmax.z);
+}
+
+static bool r3d_bvh_reserve(r3d_bvh_t* bvh, int count)
+{
+    if (count <= bvh->capacity) {
+        return true;
+    }
+
+    int capacity = (bvh->capacity > 0) ? bvh->capacity : 64;
+    while (capacity < count) capacity *= 2;
+
+    r3d_bvh_node_t* nodes = RL_REALLOC(bvh->nodes, 2 * capacity * sizeof(r3d_bvh_node_t));
+    if (nodes == NULL) return false;
+    bvh->nodes = nodes;
+
+    int* items = RL_REALLOC(bvh->items, capacity * sizeof(int));
+    if (items == NULL) return false;
+    bvh->items = items;
+
+    Vector3* centroids = RL_REALLOC(bvh->centroids, capacity * sizeof(Vector3));
+    if (centroids == NULL) return false;
+    bvh->centroids = centroids;
+
+    bvh->capacity = capacity;
+
+    return true;
+}
+
+// Reorders the items so that the first half has the smaller centroids along 'axis'
+static int r3d_bvh_split_median(r3d_bvh_t* bvh, int start, int count, int axis)
+{
+    int* items = bvh->items;
+    int k = start + count / 2;
+    int lo = start;
+    int hi = start + count - 1;
+
+    while (lo < hi) {
+        float pivot = r3d_bvh_axis(bvh->centroids[items[(lo + hi) / 2]], axis);
+        int i = lo, j = hi;
+        while (i <= j) {
+            while (r3d_bvh_axis(bvh->centroids[items[i]], axis) < pivot) i++;
+            while (r3d_bvh_axis(bvh->centroids[items[j]], axis) > pivot) j--;
+            if (i <= j) {
+                int tmp = items[i];
+                items[i++] = items[j];
+                items[j--] = tmp;
+            }
+        }
+        if (k <= j) hi = j;
+        else if (k >= i) lo = i;
+        else break;
+    }
+
+    return count / 2;
+}
+
+// Partitions the items with the best binned split along 'axis', returns the left count,
+// zero when no split was found or -1 when the node is better kept as a leaf
+static int r3d_bvh_split_sah(r3d_bvh_t* bvh, const BoundingBox* boxes, int start, int count, int axis,
+                             float cmin, float extent, float nodeArea)
+{
+    int binCount[R3D_BVH_BINS] = { 0 };
+    Vector3 binMin[R3D_BVH_BINS], binMax[R3D_BVH_BINS];
+    float scale = R3D_BVH_BINS / extent;
+
+    for (int i = 0; i < R3D_BVH_BINS; i++) {
+        r3d_bvh_empty(&binMin[i], &binMax[i]);
+    }
+
+    for (int i = start; i < start + count; i++) {
+        int item = bvh->items[i];
+        int b = (int)((r3d_bvh_axis(bvh->centroids[item], axis) - cmin) * scale);
+        if (b > R3D_BVH_BINS - 1) b = R3D_BVH_BINS - 1;
+        binCount[b]++;
+        r3d_bvh_grow(&binMin[b], &binMax[b], boxes[item].min, boxes[item].max);
+    }
+
+    // Sweep from the right to get the cost of the right side of every split
+    float rightCost[R3D_BVH_BINS];
+    Vector3 min, max;
+    int n = 0;
+
+    r3d_bvh_empty(&min, &max);
+    for (int i = R3D_BVH_BINS - 1; i > 0; i--) {
+        r3d_bvh_grow(&min, &max, binMin[i], binMax[i]);
+        n += binCount[i];
+        rightCost[i - 1] = (n > 0) ? n * r3d_bvh_area(min, max) : -1.0f;
+    }
+
+    float bestCost = FLT_MAX;
+    int bestSplit = -1;
+    n = 0;
+
+    r3d_bvh_empty(&min, &max);
+    for (int i = 0; i < R3D_BVH_BINS - 1; i++) {
+        r3d_bvh_grow(&min, &max, binMin[i], binMax[i]);
+        n += binCount[i];
+        if (n == 0 || rightCost[i] < 0.0f) continue;
+        float cost = n * r3d_bvh_area(min, max) + rightCost[i];
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestSplit = i;
+        }
+    }
+
+    if (bestSplit < 0) {
+        return 0;
+    }
+
+    // Keep small nodes as leaves when no split is cheaper than testing all the items
+    bestCost = 0.125f + bestCost / fmaxf(nodeArea, FLT_MIN);
+    if (count <= R3D_BVH_MAX_LEAF_SIZE && bestCost >= (float)count) {
+        return -1;
+    }
+
+    int i = start, j = start + count - 1;
+    while (i <= j) {
+        int b = (int)((r3d_bvh_axis(bvh->centroids[bvh->items[i]], axis) - cmin) * scale);
+        if (b > R3D_BVH_BINS - 1) b = R3D_BVH_BINS - 1;
+        if (b <= bestSplit) {
+            i++;
+        }
+        else {
+            int tmp = bvh->items[i];
+            bvh->items[i] = bvh->items[j];
+            bvh->items[j--] = tmp;
+        }
+    }
+
+    return i - start;
+}
+
+static void r3d_bvh_build_node(r3d_bvh_t* bvh, const BoundingBox* boxes, int nodeIndex, int start, int count, int depth)
+{
+    r3d_bvh_node_t* node = &bvh->nodes[nodeIndex];
+
+    Vector3 cmin, cmax;
+    r3d_bvh_empty(&node->min, &node->max);
+    r3d_bvh_empty(&cmin, &cmax);
+
+    for (int i = start; i < start + count; i++) {
+        int item = bvh->items[i];
+        r3d_bvh_grow(&node->min, &node->max, boxes[item].min, boxes[item].max);
+        r3d_bvh_grow(&cmin, &cmax, bvh->centroids[item], bvh->centroids[item]);
+    }
+
+    node->offset = start;
+    node->count = count;
+
+    if (count <= R3D_BVH_LEAF_SIZE) {
+        return;
+    }
+
+    Vector3 extent = { cmax.x - cmin.x, cmax.y - cmin.y, cmax.z - cmin.z };
+    int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z) ? 1 : 2;
+    float axisExtent = r3d_bvh_axis(extent, axis);
+
+    int leftCount = 0;
+
+    if (axisExtent > 0.0f && depth < R3D_BVH_SAH_DEPTH) {
+        leftCount = r3d_bvh_split_sah(bvh, boxes, start, count, axis, r3d_bvh_axis(cmin, axis),
+                                      axisExtent, r3d_bvh_area(node->min, node->max));
+    }
+
+    if (leftCount < 0) {
+        return;
+    }
+
+    if (leftCount == 0) {
+        leftCount = r3d_bvh_split_median(bvh, start, count, axis);
+    }
+
+    int left = bvh->nodeCount++;
+    r3d_bvh_build_node(bvh, boxes, left, start, leftCount, depth + 1);
+
+    int right = bvh->nodeCount++;
+    r3d_bvh_build_node(bvh, boxes, right, start + leftCount, count - leftCount, depth + 1);
+
+    node->offset = right;
+    node->count = 0;
+}
+
+static float r3d_bvh_summed_area(const r3d_bvh_t* bvh)
+{
+    float area = 0.0f;
+
+    for (int i = 0; i < bvh->nodeCount; i++) {
+        area += r3d_bvh_area(bvh->nodes[i].min, bvh->nodes[i].max);
+    }
+
+    return area;
+}
+
+/* === Public functions === */
+
+void r3d_bvh_destroy(r3d_bvh_t* bvh)
+{
+    RL_FREE(bvh->nodes);
+    RL_FREE(bvh->items);
+    RL_FREE(bvh->centroids);
+    *bvh = (r3d_bvh_t) { 0 };
+}
+
+bool r3d_bvh_build(r3d_bvh_t* bvh, const BoundingBox* boxes, int count)
+{
+    bvh->nodeCount = 0;
+    bvh->itemCount = 0;
+    bvh->buildArea = 0.0f;
+
+    if (count <= 0) {
+        return true;
+    }
+
+    if (!r3d_bvh_reserve(bvh, count)) {
+        return false;
+    }
+
+    for (int i = 0; i < count; i++) {
+        bvh->items[i] = i;
+        bvh->centroids[i] = (Vector3) {
+            0.5f * (boxes[i].min.x + boxes[i].max.x),
+            0.5f * (boxes[i].min.y + boxes[i].max.y),
+            0.5f * (boxes[i].min.z + boxes[i].max.z)
+        };
+    }
+
+    bvh->itemCount = count;
+    bvh->nodeCount = 1;
+
+    r3d_bvh_build_node(bvh, boxes, 0, 0, count, 0);
+
+    bvh->buildArea = r3d_bvh_summed_area(bvh);
+
+    return true;
+}
+
+float r3d_bvh_refit(r3d_bvh_t* bvh, const BoundingBox* boxes)
+{
+    // Children always follow their parent, walking backwards updates them first
+    for (int i = bvh->nodeCount - 1; i >= 0; i--) {
+        r3d_bvh_node_t* node = &bvh->nodes[i];
+        r3d_bvh_empty(&node->min, &node->max);
+
+        if (node->count > 0) {
+            for (int j = node->offset; j < node->offset + node->count; j++) {
+                const BoundingBox* box = &boxes[bvh->items[j]];
+                r3d_bvh_grow(&node->min, &node->max, box->min, box->max);
+            }
+        }
+        else {
+            const r3d_bvh_node_t* left = &bvh->nodes[i + 1];
+            const r3d_bvh_node_t* right = &bvh->nodes[node->offset];
+            r3d_bvh_grow(&node->min, &node->max, left->min, left->max);
+            r3d_bvh_grow(&node->min, &node->max, right->min, right->max);
+        }
+    }
+
+    if (bvh->buildArea <= 0.0f) {
+        return 1.0f;
+    }
+
+    return r3d_bvh_summed_area(bvh) / bvh->buildArea;
+}
+
+float r3d_bvh_ray_box(Vector3 origin, Vector3 invDir, Vector3 min, Vector3 max, float maxDist)
+{
+    float tx1 = (min.x - origin.x) * invDir.x, tx2 = (max.x - origin.x) * invDir.x;
+    float ty1 = (min.y - origin.y) * invDir.y, ty2 = (max.y - origin.y) * invDir.y;
+    float tz1 = (min.z - origin.z) * invDir.z, tz2 = (max.z - origin.z) * invDir.z;
+
+    // fminf and fmaxf discard the NaN produced by rays lying on a slab plane
+    float tmin = fmaxf(fmaxf(fminf(tx1, tx2), fminf(ty1, ty2)), fmaxf(fminf(tz1, tz2), 0.0f));
+    float tmax = fminf(fminf(fmaxf(tx1, tx2), fmaxf(ty1, ty2)), fminf(fmaxf(tz1, tz2), maxDist));
+
+    return (tmin <= tmax) ? tmin : -1.0f;
+}
+
+float r3d_bvh_raycast(const r3d_bvh_t* bvh, Ray ray, float maxDist, r3d_bvh_ray_fn fn, void* user)
+{
+    if (bvh->nodeCount == 0) {
+        return maxDist;
+    }
+
+    Vector3 invDir = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+
+    if (r3d_bvh_ray_box(ray.position, invDir, bvh->nodes[0].min, bvh->nodes[0].max, maxDist) < 0.0f) {
+        return maxDist;
+    }
+
+    r3d_bvh_ray_entry_t stack[R3D_BVH_STACK_SIZE];
+    float closest = maxDist;
+    int size = 0;
+    int index = 0;
+
+    for (;;) {
+        const r3d_bvh_node_t* node = &bvh->nodes[index];
+
+        if (node->count > 0) {
+            for (int i = node->offset; i < node->offset + node->count; i++) {
+                float dist = fn(user, bvh->items[i], ray, closest);
+                if (dist < closest) closest = dist;
+            }
+        }
+        else {
+            int near = index + 1, far = node->offset;
+            float dNear = r3d_bvh_ray_box(ray.position, invDir, bvh->nodes[near].min, bvh->nodes[near].max, closest);
+            float dFar = r3d_bvh_ray_box(ray.position, invDir, bvh->nodes[far].min, bvh->nodes[far].max, closest);
+
+            if (dNear >= 0.0f && dFar >= 0.0f && dFar < dNear) {
+                int tmpIndex = near; near = far; far = tmpIndex;
+                float tmpDist = dNear; dNear = dFar; dFar = tmpDist;
+            }
+
+            if (dNear >= 0.0f) {
+                if (dFar >= 0.0f) {
+                    stack[size++] = (r3d_bvh_ray_entry_t) { far, dFar };
+                }
+                index = near;
+                continue;
+            }
+
+            if (dFar >= 0.0f) {
+                index = far;
+                continue;
+            }
+        }
+
+        // Resume with the nearest pending node that can still be closer than the current hit
+        index = -1;
+        while (size > 0) {
+            r3d_bvh_ray_entry_t entry = stack[--size];
+            if (entry.dist <= closest) {
+                index = entry.node;
+                break;
+            }
+        }
+
+        if (index < 0) {
+            break;
+        }
+    }
+
+    return closest;
+}
+
+void r3d_bvh_query(const r3d_bvh_t* bvh, BoundingBox box, r3d_bvh_box_fn fn, void* user)
+{
+    if (bvh->nodeCount == 0) {
+        return;
+    }
+
+    int stack[R3D_BVH_STACK_SIZE];
+    int size = 0;
+
+    stack[size++] = 0;
+
+    while (size > 0) {
+        const r3d_bvh_node_t* node = &bvh->nodes[stack[--size]];
+
+        if (node->min.x > box.max.x || node->max.x < box.min.x ||
+            node->min.y > box.max.y || node->max.y < box.min.y ||
+            node->min.z > box.max.z || node->max.z < box.min.z) {
+            continue;
+        }
+
+        if (node->count > 0) {
+            for (int i = node->offset; i < node->offset + node->count; i++) {
+                if (!fn(user, bvh->items[i])) return;
+            }
+        }
+        else {
+            stack[size++] = node->offset;
+            stack[size++] = (int)(node - bvh->nodes) + 1;
+        }
+    }
+}
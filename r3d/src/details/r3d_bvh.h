@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_BVH_H
+#define R3D_BVH_H
+
+#include <raylib.h>
+#include <stdbool.h>
+
+/*
+ * Bounding volume hierarchy over a set of axis aligned boxes.
+ *
+ * The tree is built with a binned surface area heuristic and stored depth first, the left
+ * child of an interior node directly follows it so only the right child index is kept.
+ * The items are referred to by their index in the box array given to the build, the same
+ * array layout must be given to a refit for the tree to stay valid.
+ */
+
+/* === Types === */
+
+typedef struct {
+    Vector3 min;
+    int offset;     //< First item of a leaf, right child of an interior node
+    Vector3 max;
+    int count;      //< Number of items of a leaf, zero for an interior node
+} r3d_bvh_node_t;
+
+typedef struct {
+    r3d_bvh_node_t* nodes;
+    int* items;         //< Box indices, referenced by the leaves
+    Vector3* centroids; //< Build scratch, indexed like the boxes
+    int nodeCount;
+    int itemCount;
+    int capacity;
+    float buildArea;    //< Summed node surface area right after the last build
+} r3d_bvh_t;
+
+// Called with each item of the leaves crossed by the ray, returns the hit distance or any value >= 'maxDist'
+typedef float (*r3d_bvh_ray_fn)(void* user, int item, Ray ray, float maxDist);
+
+// Called with each item of the leaves overlapping the query, returns false to stop the query
+typedef bool (*r3d_bvh_box_fn)(void* user, int item);
+
+/* === Functions === */
+
+// Releases the arrays, the structure can be reused afterwards
+void r3d_bvh_destroy(r3d_bvh_t* bvh);
+
+// Builds the tree over 'count' boxes, returns false on allocation failure
+bool r3d_bvh_build(r3d_bvh_t* bvh, const BoundingBox* boxes, int count);
+
+// Updates the node bounds from the moved boxes, returns the summed area relative to the last build
+float r3d_bvh_refit(r3d_bvh_t* bvh, const BoundingBox* boxes);
+
+// Visits the items near to far, returns the closest distance reported by 'fn' or 'maxDist'
+float r3d_bvh_raycast(const r3d_bvh_t* bvh, Ray ray, float maxDist, r3d_bvh_ray_fn fn, void* user);
+
+// Visits the items of every leaf overlapping 'box', the item boxes themselves are left to 'fn'
+void r3d_bvh_query(const r3d_bvh_t* bvh, BoundingBox box, r3d_bvh_box_fn fn, void* user);
+
+// Slab test, returns the entry distance or a negative value when the ray misses the box before 'maxDist'
+float r3d_bvh_ray_box(Vector3 origin, Vector3 invDir, Vector3 min, Vector3 max, float maxDist);
+
+#endif // R3D_BVH_H
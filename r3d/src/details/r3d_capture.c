@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "./r3d_capture.h"
+
+// NOTE: This file does not include raylib, 'windows.h' conflicts with several of its declarations
+
+#include "./misc/r3d_thread.h"
+#include <stdlib.h>
+#include <stdio.h>
+
+/* === Internal types === */
+
+struct r3d_capture {
+
+    FILE* file;
+    int width;
+    int height;
+
+    r3d_thread_t thread;
+    bool threaded;                  //< False if the thread could not be created, frames are then written on submit
+    r3d_mutex_t mutex;
+    r3d_cond_t cond;                //< Signaled when a frame is queued, released or on close
+
+    unsigned char* frames[R3D_CAPTURE_QUEUE_SIZE];
+    unsigned char* planes;          //< Y, U and V planes of the frame being written
+
+    int queue[R3D_CAPTURE_QUEUE_SIZE];
+    int queueHead;
+    int queueCount;
+
+    int freeList[R3D_CAPTURE_QUEUE_SIZE];
+    int freeCount;
+
+    int writtenFrames;
+    bool quit;
+
+};
+
+/* === Internal functions === */
+
+// BT.601 limited range, the default assumed by Y4M readers
+static void r3d_capture_write_frame(r3d_capture_t* capture, const unsigned char* rgb)
+{
+    int count = capture->width * capture->height;
+
+    unsigned char* y = capture->planes;
+    unsigned char* u = y + count;
+    unsigned char* v = u + count;
+
+    for (int i = 0; i < count; i++) {
+        int r = rgb[3 * i + 0];
+        int g = rgb[3 * i + 1];
+        int b = rgb[3 * i + 2];
+        y[i] = (unsigned char)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+        u[i] = (unsigned char)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+        v[i] = (unsigned char)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+    }
+
+    fputs("FRAME\n", capture->file);
+    fwrite(capture->planes, 1, 3 * count, capture->file);
+}
+
+static void r3d_capture_writer_loop(r3d_capture_t* capture)
+{
+    r3d_mutex_lock(&capture->mutex);
+
+    for (;;) {
+        while (!capture->quit && capture->queueCount == 0) {
+            r3d_cond_wait(&capture->cond, &capture->mutex);
+        }
+        if (capture->queueCount == 0) {
+            break;
+        }
+
+        int index = capture->queue[capture->queueHead];
+        capture->queueHead = (capture->queueHead + 1) % R3D_CAPTURE_QUEUE_SIZE;
+        capture->queueCount--;
+
+        // The conversion and the file write happen without holding the lock
+        r3d_mutex_unlock(&capture->mutex);
+        r3d_capture_write_frame(capture, capture->frames[index]);
+        r3d_mutex_lock(&capture->mutex);
+
+        capture->freeList[capture->freeCount++] = index;
+        capture->writtenFrames++;
+        r3d_cond_broadcast(&capture->cond);
+    }
+
+    r3d_mutex_unlock(&capture->mutex);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI r3d_capture_writer(LPVOID arg)
+{
+    r3d_capture_writer_loop(arg);
+    return 0;
+}
+#else
+static void* r3d_capture_writer(void* arg)
+{
+    r3d_capture_writer_loop(arg);
+    return NULL;
+}
+#endif
+
+/* === Public functions === */
+
+r3d_capture_t* r3d_capture_open(const char* fileName, int width, int height, int fps)
+{
+    r3d_capture_t* capture = calloc(1, sizeof(r3d_capture_t));
+    if (capture == NULL) {
+        return NULL;
+    }
+
+    size_t frameSize = (size_t)width * height * 3;
+
+    capture->planes = malloc(frameSize);
+    for (int i = 0; i < R3D_CAPTURE_QUEUE_SIZE; i++) {
+        capture->frames[i] = malloc(frameSize);
+        capture->freeList[i] = i;
+    }
+
+    bool allocated = (capture->planes != NULL);
+    for (int i = 0; i < R3D_CAPTURE_QUEUE_SIZE; i++) {
+        allocated = allocated && (capture->frames[i] != NULL);
+    }
+
+    capture->file = allocated ? fopen(fileName, "wb") : NULL;
+    if (capture->file == NULL) {
+        for (int i = 0; i < R3D_CAPTURE_QUEUE_SIZE; i++) {
+            free(capture->frames[i]);
+        }
+        free(capture->planes);
+        free(capture);
+        return NULL;
+    }
+
+    fprintf(capture->file, "YUV4MPEG2 W%i H%i F%i:1 Ip A1:1 C444\n", width, height, fps);
+
+    capture->width = width;
+    capture->height = height;
+    capture->freeCount = R3D_CAPTURE_QUEUE_SIZE;
+
+    r3d_mutex_init(&capture->mutex);
+    r3d_cond_init(&capture->cond);
+
+#if defined(_WIN32)
+    capture->thread = CreateThread(NULL, 0, r3d_capture_writer, capture, 0, NULL);
+    bool created = (capture->thread != NULL);
+#else
+    bool created = (pthread_create(&capture->thread, NULL, r3d_capture_writer, capture) == 0);
+#endif
+
+    capture->threaded = created;
+
+    return capture;
+}
+
+int r3d_capture_close(r3d_capture_t* capture)
+{
+    if (capture == NULL) {
+        return 0;
+    }
+
+    r3d_mutex_lock(&capture->mutex);
+    capture->quit = true;
+    r3d_cond_broadcast(&capture->cond);
+    r3d_mutex_unlock(&capture->mutex);
+
+    if (capture->threaded) {
+#if defined(_WIN32)
+        WaitForSingleObject(capture->thread, INFINITE);
+        CloseHandle(capture->thread);
+#else
+        pthread_join(capture->thread, NULL);
+#endif
+    }
+
+    r3d_cond_destroy(&capture->cond);
+    r3d_mutex_destroy(&capture->mutex);
+
+    int writtenFrames = capture->writtenFrames;
+
+    fclose(capture->file);
+
+    for (int i = 0; i < R3D_CAPTURE_QUEUE_SIZE; i++) {
+        free(capture->frames[i]);
+    }
+
+    free(capture->planes);
+    free(capture);
+
+    return writtenFrames;
+}
+
+unsigned char* r3d_capture_acquire(r3d_capture_t* capture)
+{
+    r3d_mutex_lock(&capture->mutex);
+
+    while (capture->freeCount == 0) {
+        r3d_cond_wait(&capture->cond, &capture->mutex);
+    }
+
+    unsigned char* frame = capture->frames[capture->freeList[--capture->freeCount]];
+
+    r3d_mutex_unlock(&capture->mutex);
+
+    return frame;
+}
+
+void r3d_capture_submit(r3d_capture_t* capture, unsigned char* frame)
+{
+    int index = 0;
+    while (capture->frames[index] != frame) {
+        index++;
+    }
+
+    if (!capture->threaded) {
+        r3d_capture_write_frame(capture, frame);
+        r3d_mutex_lock(&capture->mutex);
+        capture->freeList[capture->freeCount++] = index;
+        capture->writtenFrames++;
+        r3d_mutex_unlock(&capture->mutex);
+        return;
+    }
+
+    r3d_mutex_lock(&capture->mutex);
+
+    capture->queue[(capture->queueHead + capture->queueCount) % R3D_CAPTURE_QUEUE_SIZE] = index;
+    capture->queueCount++;
+    r3d_cond_broadcast(&capture->cond);
+
+    r3d_mutex_unlock(&capture->mutex);
+}
+
+void r3d_capture_release(r3d_capture_t* capture, unsigned char* frame)
+{
+    int index = 0;
+    while (capture->frames[index] != frame) {
+        index++;
+    }
+
+    r3d_mutex_lock(&capture->mutex);
+
+    capture->freeList[capture->freeCount++] = index;
+    r3d_cond_broadcast(&capture->cond);
+
+    r3d_mutex_unlock(&capture->mutex);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#ifndef R3D_DETAILS_CAPTURE_H
+#define R3D_DETAILS_CAPTURE_H
+
+#include <stdbool.h>
+
+/* === Defines === */
+
+#define R3D_CAPTURE_QUEUE_SIZE 4    //< Frames that can wait for the writer thread before 'r3d_capture_acquire' blocks
+
+/* === Types === */
+
+/*
+ * Streams RGB8 frames to a Y4M (YUV 4:4:4) file from a background thread.
+ * The frame buffers are owned by the writer: acquire one, fill it, then submit it.
+ */
+typedef struct r3d_capture r3d_capture_t;
+
+/* === Functions === */
+
+// Creates the file, writes the stream header and starts the writer thread, returns NULL on failure
+r3d_capture_t* r3d_capture_open(const char* fileName, int width, int height, int fps);
+
+// Writes the queued frames, joins the writer thread and closes the file, returns the number of frames written
+int r3d_capture_close(r3d_capture_t* capture);
+
+// Returns a free buffer of 'width * height * 3' bytes, blocks while all of them are queued
+unsigned char* r3d_capture_acquire(r3d_capture_t* capture);
+
+// Queues a buffer returned by 'r3d_capture_acquire', its rows are expected from top to bottom
+void r3d_capture_submit(r3d_capture_t* capture, unsigned char* frame);
+
+// Gives back a buffer returned by 'r3d_capture_acquire' without writing it
+void r3d_capture_release(r3d_capture_t* capture, unsigned char* frame);
+
+#endif // R3D_DETAILS_CAPTURE_H
@@ -33,7 +33,10 @@
 
 // This function supports instanced rendering when necessary
 static void r3d_draw_vertex_arrays(const r3d_drawcall_t* call);
-static void r3d_draw_vertex_arrays_inst(const r3d_drawcall_t* call, int locInstanceModel, int locInstanceColor);
+static void r3d_draw_vertex_arrays_inst(const r3d_drawcall_t* call, int locInstanceModel, int locInstanceColor, int locInstanceTexCoord);
+
+// Adds a draw to the frame statistics
+static void r3d_draw_count(const r3d_drawcall_t* call, int instances);
 
 // Comparison functions for sorting draw calls in the arrays
 static int r3d_drawcall_compare_front_to_back(const void* a, const void* b);
@@ -52,6 +55,40 @@ void r3d_drawcall_sort_back_to_front(r3d_drawcall_t* calls, size_t count)
     qsort(calls, count, sizeof(r3d_drawcall_t), r3d_drawcall_compare_back_to_front);
 }
 
+void r3d_drawcall_upload_instances(r3d_drawcall_t* call)
+{
+    // Buffers given by the caller are already on the GPU
+    if (call->instanced.buffer != 0 || call->instanced.count == 0) {
+        return;
+    }
+
+    // Same sizes as the uploads made for a single draw
+    if (call->instanced.transforms) {
+        size_t stride = (call->instanced.transStride == 0) ? sizeof(Matrix) : call->instanced.transStride;
+        call->instanced.vboTransforms = rlLoadVertexBuffer(call->instanced.transforms, (int)(call->instanced.count * stride), true);
+    }
+    if (call->instanced.colors) {
+        size_t stride = (call->instanced.colStride == 0) ? sizeof(Color) : call->instanced.colStride;
+        call->instanced.vboColors = rlLoadVertexBuffer(call->instanced.colors, (int)(call->instanced.count * stride), true);
+    }
+    if (call->instanced.texCoords) {
+        size_t stride = (call->instanced.texStride == 0) ? sizeof(Vector4) : call->instanced.texStride;
+        size_t size = (call->instanced.count - 1) * stride + sizeof(Vector4);
+        call->instanced.vboTexCoords = rlLoadVertexBuffer(call->instanced.texCoords, (int)size, true);
+    }
+}
+
+void r3d_drawcall_release_instances(r3d_drawcall_t* call)
+{
+    if (call->instanced.vboTransforms != 0) rlUnloadVertexBuffer(call->instanced.vboTransforms);
+    if (call->instanced.vboColors != 0) rlUnloadVertexBuffer(call->instanced.vboColors);
+    if (call->instanced.vboTexCoords != 0) rlUnloadVertexBuffer(call->instanced.vboTexCoords);
+
+    call->instanced.vboTransforms = 0;
+    call->instanced.vboColors = 0;
+    call->instanced.vboTexCoords = 0;
+}
+
 void r3d_drawcall_raster_depth(const r3d_drawcall_t* call)
 {
     if (call->geometryType != R3D_DRAWCALL_GEOMETRY_MESH) {
@@ -163,7 +200,7 @@ void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call)
     }
 
     // Draw vertex buffers
-    r3d_draw_vertex_arrays_inst(call, 10, -1);
+    r3d_draw_vertex_arrays_inst(call, 10, -1, 15);
 
     // Unbind vertex buffers
     rlDisableVertexArray();
@@ -286,7 +323,7 @@ void r3d_drawcall_raster_depth_cube_inst(const r3d_drawcall_t* call)
     }
 
     // Draw vertex buffers
-    r3d_draw_vertex_arrays_inst(call, 10, -1);
+    r3d_draw_vertex_arrays_inst(call, 10, -1, 15);
 
     // Unbind vertex buffers
     rlDisableVertexArray();
@@ -437,7 +474,7 @@ void r3d_drawcall_raster_geometry(const r3d_drawcall_t* call)
 
 void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call)
 {
-    if (call->instanced.count == 0 || call->instanced.transforms == NULL) {
+    if (call->instanced.count == 0 || (call->instanced.transforms == NULL && call->instanced.buffer == 0)) {
         return;
     }
 
@@ -560,7 +597,7 @@ void r3d_drawcall_raster_geometry_inst(const r3d_drawcall_t* call)
         r3d_shader_set_mat4(raster.geometryInst, uMatVP, matVP);
 
         // Rasterisation du mesh en tenant compte du rendu instanci� si besoin
-        r3d_draw_vertex_arrays_inst(call, 10, 14);
+        r3d_draw_vertex_arrays_inst(call, 10, 14, 15);
     }
 
     // Unbind all bound texture maps
@@ -724,7 +761,7 @@ void r3d_drawcall_raster_forward(const r3d_drawcall_t* call)
 
 void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call)
 {
-    if (call->instanced.count == 0 || call->instanced.transforms == NULL) {
+    if (call->instanced.count == 0 || (call->instanced.transforms == NULL && call->instanced.buffer == 0)) {
         return;
     }
 
@@ -850,7 +887,7 @@ void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call)
         r3d_shader_set_mat4(raster.forwardInst, uMatVP, matVP);
 
         // Raterization of the instantiated mesh
-        r3d_draw_vertex_arrays_inst(call, 10, 14);
+        r3d_draw_vertex_arrays_inst(call, 10, 14, 15);
     }
 
     // Unbind all bound texture maps
@@ -876,6 +913,8 @@ void r3d_drawcall_raster_forward_inst(const r3d_drawcall_t* call)
 
 void r3d_draw_vertex_arrays(const r3d_drawcall_t* call)
 {
+    r3d_draw_count(call, 1);
+
     if (call->geometryType == R3D_DRAWCALL_GEOMETRY_MESH) {
         if (call->geometry.mesh.indices == NULL) rlDrawVertexArray(0, call->geometry.mesh.vertexCount);
         else rlDrawVertexArrayElements(0, call->geometry.mesh.triangleCount * 3, 0);
@@ -885,7 +924,7 @@ void r3d_draw_vertex_arrays(const r3d_drawcall_t* call)
     }
 }
 
-void r3d_draw_vertex_arrays_inst(const r3d_drawcall_t* call, int locInstanceModel, int locInstanceColor)
+void r3d_draw_vertex_arrays_inst(const r3d_drawcall_t* call, int locInstanceModel, int locInstanceColor, int locInstanceTexCoord)
 {
     // WARNING: Always use the same attribute locations in shaders for instance matrices and colors.
     // If attribute locations differ between shaders (e.g., between the depth shader and the geometry shader),
@@ -896,11 +935,36 @@ void r3d_draw_vertex_arrays_inst(const r3d_drawcall_t* call, int locInstanceMode
 
     unsigned int vboTransforms = 0;
     unsigned int vboColors = 0;
+    unsigned int vboTexCoords = 0;
+
+    r3d_draw_count(call, (int)call->instanced.count);
+
+    // Sprites are drawn from the quad primitive, the instance attributes are set on its vertex array
+    if (call->geometryType == R3D_DRAWCALL_GEOMETRY_SPRITE) {
+        rlEnableVertexArray(R3D.primitive.quad.vao);
+    }
 
+    // Instance data already on the GPU is bound in place, it is owned by the caller
+    if (call->instanced.buffer != 0) {
+        rlEnableVertexBuffer(call->instanced.buffer);
+        if (locInstanceModel >= 0) {
+            for (int i = 0; i < 4; i++) {
+                rlSetVertexAttribute(locInstanceModel + i, 4, RL_FLOAT, false, (int)call->instanced.transStride, i * sizeof(Vector4));
+                rlSetVertexAttributeDivisor(locInstanceModel + i, 1);
+                rlEnableVertexAttribute(locInstanceModel + i);
+            }
+        }
+        if (locInstanceColor >= 0) {
+            rlSetVertexAttribute(locInstanceColor, 4, RL_UNSIGNED_BYTE, true, (int)call->instanced.colStride, (int)call->instanced.colOffset);
+            rlSetVertexAttributeDivisor(locInstanceColor, 1);
+            rlEnableVertexAttribute(locInstanceColor);
+        }
+    }
     // Enable the attribute for the transformation matrix (decomposed into 4 vec4 vectors)
-    if (locInstanceModel >= 0 && call->instanced.transforms) {
+    else if (locInstanceModel >= 0 && call->instanced.transforms) {
         size_t stride = (call->instanced.transStride == 0) ? sizeof(Matrix) : call->instanced.transStride;
-        vboTransforms = rlLoadVertexBuffer(call->instanced.transforms, (int)(call->instanced.count * stride), true);
+        vboTransforms = call->instanced.vboTransforms;
+        if (vboTransforms == 0) vboTransforms = rlLoadVertexBuffer(call->instanced.transforms, (int)(call->instanced.count * stride), true);
         rlEnableVertexBuffer(vboTransforms);
         for (int i = 0; i < 4; i++) {
             rlSetVertexAttribute(locInstanceModel + i, 4, RL_FLOAT, false, (int)stride, i * sizeof(Vector4));
@@ -922,20 +986,38 @@ void r3d_draw_vertex_arrays_inst(const r3d_drawcall_t* call, int locInstanceMode
     }
 
     // Handle per-instance colors if available
-    if (locInstanceColor >= 0 && call->instanced.colors) {
+    if (locInstanceColor >= 0 && call->instanced.buffer == 0 && call->instanced.colors) {
         size_t stride = (call->instanced.colStride == 0) ? sizeof(Color) : call->instanced.colStride;
-        vboColors = rlLoadVertexBuffer(call->instanced.colors, (int)(call->instanced.count * stride), true);
+        vboColors = call->instanced.vboColors;
+        if (vboColors == 0) vboColors = rlLoadVertexBuffer(call->instanced.colors, (int)(call->instanced.count * stride), true);
         rlEnableVertexBuffer(vboColors);
         rlSetVertexAttribute(locInstanceColor, 4, RL_UNSIGNED_BYTE, true, (int)call->instanced.colStride, 0);
         rlSetVertexAttributeDivisor(locInstanceColor, 1);
         rlEnableVertexAttribute(locInstanceColor);
     }
-    else if (locInstanceColor >= 0) {
+    else if (locInstanceColor >= 0 && call->instanced.buffer == 0) {
         const float defaultColor[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
         glVertexAttrib4fv(locInstanceColor, defaultColor);
         rlDisableVertexAttribute(locInstanceColor);
     }
 
+    // Handle per-instance texture coordinates, only read up to the last element when interleaved
+    if (locInstanceTexCoord >= 0 && call->instanced.buffer == 0 && call->instanced.texCoords) {
+        size_t stride = (call->instanced.texStride == 0) ? sizeof(Vector4) : call->instanced.texStride;
+        size_t size = (call->instanced.count - 1) * stride + sizeof(Vector4);
+        vboTexCoords = call->instanced.vboTexCoords;
+        if (vboTexCoords == 0) vboTexCoords = rlLoadVertexBuffer(call->instanced.texCoords, (int)size, true);
+        rlEnableVertexBuffer(vboTexCoords);
+        rlSetVertexAttribute(locInstanceTexCoord, 4, RL_FLOAT, false, (int)stride, 0);
+        rlSetVertexAttributeDivisor(locInstanceTexCoord, 1);
+        rlEnableVertexAttribute(locInstanceTexCoord);
+    }
+    else if (locInstanceTexCoord >= 0) {
+        const float defaultTexCoord[4] = { 0.0f, 0.0f, 1.0f, 1.0f };
+        glVertexAttrib4fv(locInstanceTexCoord, defaultTexCoord);
+        rlDisableVertexAttribute(locInstanceTexCoord);
+    }
+
     // Draw instances or a single object depending on the case
     if (call->geometryType == R3D_DRAWCALL_GEOMETRY_MESH) {
         if (call->geometry.mesh.indices != NULL) {
@@ -950,21 +1032,36 @@ void r3d_draw_vertex_arrays_inst(const r3d_drawcall_t* call, int locInstanceMode
         }
     }
     else if (call->geometryType == R3D_DRAWCALL_GEOMETRY_SPRITE) {
-        r3d_primitive_draw_quad();
+        rlDrawVertexArrayElementsInstanced(0, 6, 0, (int)call->instanced.count);
     }
 
     // Clean up resources
+    if (call->instanced.buffer != 0) {
+        for (int i = 0; i < 4 && locInstanceModel >= 0; i++) {
+            rlDisableVertexAttribute(locInstanceModel + i);
+            rlSetVertexAttributeDivisor(locInstanceModel + i, 0);
+        }
+        if (locInstanceColor >= 0) {
+            rlDisableVertexAttribute(locInstanceColor);
+            rlSetVertexAttributeDivisor(locInstanceColor, 0);
+        }
+    }
     if (vboTransforms > 0) {
         for (int i = 0; i < 4; i++) {
             rlDisableVertexAttribute(locInstanceModel + i);
             rlSetVertexAttributeDivisor(locInstanceModel + i, 0);
         }
-        rlUnloadVertexBuffer(vboTransforms);
+        if (vboTransforms != call->instanced.vboTransforms) rlUnloadVertexBuffer(vboTransforms);
     }
     if (vboColors > 0) {
         rlDisableVertexAttribute(locInstanceColor);
         rlSetVertexAttributeDivisor(locInstanceColor, 0);
-        rlUnloadVertexBuffer(vboColors);
+        if (vboColors != call->instanced.vboColors) rlUnloadVertexBuffer(vboColors);
+    }
+    if (vboTexCoords > 0) {
+        rlDisableVertexAttribute(locInstanceTexCoord);
+        rlSetVertexAttributeDivisor(locInstanceTexCoord, 0);
+        if (vboTexCoords != call->instanced.vboTexCoords) rlUnloadVertexBuffer(vboTexCoords);
     }
 }
 
@@ -1011,3 +1108,18 @@ int r3d_drawcall_compare_back_to_front(const void* a, const void* b)
 
     return (distA < distB) - (distA > distB);
 }
+
+void r3d_draw_count(const r3d_drawcall_t* call, int instances)
+{
+    int triangles = 2;
+
+    if (call->geometryType == R3D_DRAWCALL_GEOMETRY_MESH) {
+        triangles = (call->geometry.mesh.indices != NULL)
+            ? call->geometry.mesh.triangleCount
+            : call->geometry.mesh.vertexCount / 3;
+    }
+
+    R3D.state.stats.drawCalls++;
+    R3D.state.stats.instances += instances;
+    R3D.state.stats.triangles += triangles * instances;
+}
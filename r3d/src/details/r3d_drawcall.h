@@ -52,9 +52,18 @@ typedef struct {
         R3D_BillboardMode billboardMode;
         const Matrix* transforms;
         const Color* colors;
+        const Vector4* texCoords;   // UV offset in xy and scale in zw, applied before the material ones
         size_t transStride;
         size_t colStride;
+        size_t texStride;
         size_t count;
+        // GPU buffer holding both transforms and colors, used instead of the arrays when not zero
+        unsigned int buffer;
+        size_t colOffset;
+        // Copies of the arrays shared by all the draws of the frame, uploaded if not zero
+        unsigned int vboTransforms;
+        unsigned int vboColors;
+        unsigned int vboTexCoords;
     } instanced;
 
     struct {
@@ -65,6 +74,8 @@ typedef struct {
     R3D_ShadowCastMode shadowCastMode;
     r3d_drawcall_geometry_e geometryType;
 
+    int queryId;    // Reported by the scene queries, negative to leave the call out
+
 } r3d_drawcall_t;
 
 /* === Functions === */
@@ -72,6 +83,10 @@ typedef struct {
 void r3d_drawcall_sort_front_to_back(r3d_drawcall_t* calls, size_t count);
 void r3d_drawcall_sort_back_to_front(r3d_drawcall_t* calls, size_t count);
 
+// Uploads the instance arrays once for all the following draws of the call
+void r3d_drawcall_upload_instances(r3d_drawcall_t* call);
+void r3d_drawcall_release_instances(r3d_drawcall_t* call);
+
 void r3d_drawcall_raster_depth(const r3d_drawcall_t* call);
 void r3d_drawcall_raster_depth_inst(const r3d_drawcall_t* call);
 
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_gpu_timer.h"
+
+#include <string.h>
+#include <glad.h>
+
+/* === Public functions === */
+
+void r3d_gpu_timer_destroy(r3d_gpu_timer_t* timer)
+{
+    if (timer->queries[0][0] != 0) {
+        glDeleteQueries(2 * R3D_GPU_TIMER_LATENCY, &timer->queries[0][0]);
+    }
+
+    memset(timer, 0, sizeof(*timer));
+}
+
+void r3d_gpu_timer_begin(r3d_gpu_timer_t* timer)
+{
+    if (timer->queries[0][0] == 0) {
+        glGenQueries(2 * R3D_GPU_TIMER_LATENCY, &timer->queries[0][0]);
+    }
+
+    timer->measuring = (timer->pending < R3D_GPU_TIMER_LATENCY);
+
+    if (timer->measuring) {
+        glQueryCounter(timer->queries[timer->head][0], GL_TIMESTAMP);
+    }
+}
+
+void r3d_gpu_timer_end(r3d_gpu_timer_t* timer)
+{
+    if (!timer->measuring) {
+        return;
+    }
+
+    glQueryCounter(timer->queries[timer->head][1], GL_TIMESTAMP);
+
+    timer->head = (timer->head + 1) % R3D_GPU_TIMER_LATENCY;
+    timer->pending++;
+    timer->measuring = false;
+}
+
+bool r3d_gpu_timer_poll(r3d_gpu_timer_t* timer, double* ms)
+{
+    bool collected = false;
+
+    while (timer->pending > 0) {
+        int tail = (timer->head - timer->pending + R3D_GPU_TIMER_LATENCY) % R3D_GPU_TIMER_LATENCY;
+
+        // The end timestamp is available once the GPU went through the whole measure
+        GLint available = GL_FALSE;
+        glGetQueryObjectiv(timer->queries[tail][1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            break;
+        }
+
+        GLuint64 start = 0, end = 0;
+        glGetQueryObjectui64v(timer->queries[tail][0], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(timer->queries[tail][1], GL_QUERY_RESULT, &end);
+
+        *ms = (double)(end - start) * 1e-6;
+        timer->pending--;
+        collected = true;
+    }
+
+    return collected;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_DETAILS_GPU_TIMER_H
+#define R3D_DETAILS_GPU_TIMER_H
+
+#include <stdbool.h>
+
+/* === Defines === */
+
+#define R3D_GPU_TIMER_LATENCY 4     //< Measures that can be in flight, results are read this many frames late at most
+
+/* === Types === */
+
+/*
+ * Measures GPU time between two points of the command stream with timestamp queries.
+ * Results are collected without blocking once the GPU has reached them, a few frames later.
+ * Timestamps, unlike elapsed time queries, allow several timers to be nested.
+ */
+typedef struct {
+
+    unsigned int queries[R3D_GPU_TIMER_LATENCY][2];     //< Start and end timestamp of each measure
+    int head;                       //< Next measure to issue
+    int pending;                    //< Measures issued and not collected yet
+    bool measuring;                 //< True between begin and end when a query was available
+
+} r3d_gpu_timer_t;
+
+/* === Functions === */
+
+// Deletes the queries
+void r3d_gpu_timer_destroy(r3d_gpu_timer_t* timer);
+
+// Records the start timestamp, the measure is skipped if all the queries are still in flight
+void r3d_gpu_timer_begin(r3d_gpu_timer_t* timer);
+
+// Records the end timestamp of the measure started by 'r3d_gpu_timer_begin'
+void r3d_gpu_timer_end(r3d_gpu_timer_t* timer);
+
+// Collects the finished measures in order, returns true and the last one in 'ms' if there was any
+bool r3d_gpu_timer_poll(r3d_gpu_timer_t* timer, double* ms);
+
+#endif // R3D_DETAILS_GPU_TIMER_H
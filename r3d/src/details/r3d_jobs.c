@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "./r3d_jobs.h"
+
+// NOTE: This file does not include raylib, 'windows.h' conflicts with several of its declarations
+
+#include "./misc/r3d_thread.h"
+#include <stdlib.h>
+
+/* === Internal data === */
+
+static struct {
+
+    r3d_thread_t* threads;
+    int workerCount;
+
+    r3d_mutex_t mutex;
+    r3d_cond_t wakeCond;        //< Signaled when jobs are available or on shutdown
+    r3d_cond_t doneCond;        //< Signaled when the last job of a dispatch is done
+
+    r3d_job_func_t func;
+    void* data;
+
+    int jobCount;
+    int nextJob;
+    int pendingJobs;
+
+    bool running;
+    bool quit;
+
+} r3d_jobs;
+
+/* === Internal functions === */
+
+// Must be called with the mutex locked, returns with the mutex locked
+static void r3d_jobs_run_pending(void)
+{
+    while (r3d_jobs.nextJob < r3d_jobs.jobCount) {
+        r3d_job_func_t func = r3d_jobs.func;
+        void* data = r3d_jobs.data;
+        int index = r3d_jobs.nextJob++;
+
+        r3d_mutex_unlock(&r3d_jobs.mutex);
+        func(data, index);
+        r3d_mutex_lock(&r3d_jobs.mutex);
+
+        if (--r3d_jobs.pendingJobs == 0) {
+            r3d_cond_broadcast(&r3d_jobs.doneCond);
+        }
+    }
+}
+
+static void r3d_jobs_worker_loop(void)
+{
+    r3d_mutex_lock(&r3d_jobs.mutex);
+
+    for (;;) {
+        while (!r3d_jobs.quit && r3d_jobs.nextJob >= r3d_jobs.jobCount) {
+            r3d_cond_wait(&r3d_jobs.wakeCond, &r3d_jobs.mutex);
+        }
+        if (r3d_jobs.quit) {
+            break;
+        }
+        r3d_jobs_run_pending();
+    }
+
+    r3d_mutex_unlock(&r3d_jobs.mutex);
+}
+
+#if defined(_WIN32)
+static DWORD WINAPI r3d_jobs_worker(LPVOID arg)
+{
+    (void)arg;
+    r3d_jobs_worker_loop();
+    return 0;
+}
+#else
+static void* r3d_jobs_worker(void* arg)
+{
+    (void)arg;
+    r3d_jobs_worker_loop();
+    return NULL;
+}
+#endif
+
+/* === Public functions === */
+
+bool r3d_jobs_init(int threadCount)
+{
+    r3d_jobs_shutdown();
+
+    if (threadCount <= 0) {
+        threadCount = r3d_jobs_get_hardware_thread_count();
+    }
+
+    // The calling thread takes part in every dispatch
+    int workerCount = threadCount - 1;
+    if (workerCount <= 0) {
+        return true;
+    }
+
+    r3d_jobs.threads = malloc(workerCount * sizeof(r3d_thread_t));
+    if (r3d_jobs.threads == NULL) {
+        return false;
+    }
+
+    r3d_mutex_init(&r3d_jobs.mutex);
+    r3d_cond_init(&r3d_jobs.wakeCond);
+    r3d_cond_init(&r3d_jobs.doneCond);
+
+    r3d_jobs.jobCount = 0;
+    r3d_jobs.nextJob = 0;
+    r3d_jobs.pendingJobs = 0;
+    r3d_jobs.quit = false;
+    r3d_jobs.running = true;
+    r3d_jobs.workerCount = 0;
+
+    for (int i = 0; i < workerCount; i++) {
+#if defined(_WIN32)
+        r3d_jobs.threads[i] = CreateThread(NULL, 0, r3d_jobs_worker, NULL, 0, NULL);
+        bool created = (r3d_jobs.threads[i] != NULL);
+#else
+        bool created = (pthread_create(&r3d_jobs.threads[i], NULL, r3d_jobs_worker, NULL) == 0);
+#endif
+        if (!created) break;
+        r3d_jobs.workerCount++;
+    }
+
+    if (r3d_jobs.workerCount == 0) {
+        r3d_jobs_shutdown();
+        return false;
+    }
+
+    return true;
+}
+
+void r3d_jobs_shutdown(void)
+{
+    if (!r3d_jobs.running) {
+        return;
+    }
+
+    r3d_mutex_lock(&r3d_jobs.mutex);
+    r3d_jobs.quit = true;
+    r3d_cond_broadcast(&r3d_jobs.wakeCond);
+    r3d_mutex_unlock(&r3d_jobs.mutex);
+
+    for (int i = 0; i < r3d_jobs.workerCount; i++) {
+#if defined(_WIN32)
+        WaitForSingleObject(r3d_jobs.threads[i], INFINITE);
+        CloseHandle(r3d_jobs.threads[i]);
+#else
+        pthread_join(r3d_jobs.threads[i], NULL);
+#endif
+    }
+
+    r3d_cond_destroy(&r3d_jobs.doneCond);
+    r3d_cond_destroy(&r3d_jobs.wakeCond);
+    r3d_mutex_destroy(&r3d_jobs.mutex);
+
+    free(r3d_jobs.threads);
+
+    r3d_jobs.threads = NULL;
+    r3d_jobs.workerCount = 0;
+    r3d_jobs.running = false;
+}
+
+int r3d_jobs_get_thread_count(void)
+{
+    return r3d_jobs.running ? r3d_jobs.workerCount + 1 : 1;
+}
+
+int r3d_jobs_get_hardware_thread_count(void)
+{
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    int count = (int)info.dwNumberOfProcessors;
+#else
+    int count = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+
+    return (count > 0) ? count : 1;
+}
+
+void r3d_jobs_dispatch(r3d_job_func_t func, void* data, int count)
+{
+    if (count <= 0) {
+        return;
+    }
+
+    if (!r3d_jobs.running || count == 1) {
+        for (int i = 0; i < count; i++) {
+            func(data, i);
+        }
+        return;
+    }
+
+    r3d_mutex_lock(&r3d_jobs.mutex);
+
+    r3d_jobs.func = func;
+    r3d_jobs.data = data;
+    r3d_jobs.jobCount = count;
+    r3d_jobs.nextJob = 0;
+    r3d_jobs.pendingJobs = count;
+
+    r3d_cond_broadcast(&r3d_jobs.wakeCond);
+
+    // The calling thread works too, then waits for the jobs still running on workers
+    r3d_jobs_run_pending();
+    while (r3d_jobs.pendingJobs > 0) {
+        r3d_cond_wait(&r3d_jobs.doneCond, &r3d_jobs.mutex);
+    }
+
+    r3d_jobs.jobCount = 0;
+    r3d_jobs.nextJob = 0;
+
+    r3d_mutex_unlock(&r3d_jobs.mutex);
+}
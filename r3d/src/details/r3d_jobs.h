@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#ifndef R3D_DETAILS_JOBS_H
+#define R3D_DETAILS_JOBS_H
+
+#include <stdbool.h>
+
+/* === Types === */
+
+/*
+ * Function executed for each job index of a dispatch.
+ * Jobs of a same dispatch run concurrently and must not write to shared data.
+ */
+typedef void (*r3d_job_func_t)(void* data, int index);
+
+/* === Functions === */
+
+// Starts the pool with 'threadCount' threads including the calling one, 0 uses all hardware threads
+bool r3d_jobs_init(int threadCount);
+
+// Stops and joins the worker threads, safe to call when the pool is not running
+void r3d_jobs_shutdown(void);
+
+// Returns the number of threads taking part in a dispatch, 1 when the pool is not running
+int r3d_jobs_get_thread_count(void);
+
+// Returns the number of hardware threads reported by the system
+int r3d_jobs_get_hardware_thread_count(void);
+
+// Runs 'func' for every index in [0, count) and returns once all of them are done
+void r3d_jobs_dispatch(r3d_job_func_t func, void* data, int count);
+
+#endif // R3D_DETAILS_JOBS_H
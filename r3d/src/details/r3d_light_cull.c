@@ -0,0 +1,419 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "./r3d_light_cull.h"
+
+#include "./misc/r3d_simd.h"
+#include "./r3d_jobs.h"
+
+#include <math.h>
+
+/* === Internal constants === */
+
+#define R3D_LIGHT_CULL_FLOAT_ARRAYS 26
+#define R3D_LIGHT_CULL_CHUNK_SIZE 1024  //< Lights per job, multiple of every SIMD width
+
+/* === Internal types === */
+
+typedef struct {
+    float cornerX[8], cornerY[8], cornerW[8];   //< Clip space offsets of the unit cube corners
+    float m[16];                                //< View projection matrix, column major
+    Vector3 viewPos;
+    float halfW, halfH;
+    float screenW, screenH;
+} r3d_light_cull_view_t;
+
+typedef struct {
+    r3d_light_cull_t* cull;
+    const r3d_light_cull_view_t* view;
+    int omniChunks;
+} r3d_light_cull_job_t;
+
+/* === Internal functions === */
+
+static void r3d_light_cull_get_float_arrays(r3d_light_cull_t* cull, float** out[R3D_LIGHT_CULL_FLOAT_ARRAYS])
+{
+    float** fields[R3D_LIGHT_CULL_FLOAT_ARRAYS] = {
+        &cull->omniX, &cull->omniY, &cull->omniZ, &cull->omniRadius,
+        &cull->spotX, &cull->spotY, &cull->spotZ,
+        &cull->spotDirX, &cull->spotDirY, &cull->spotDirZ,
+        &cull->spotLength, &cull->spotRadius,
+        &cull->spotRightX, &cull->spotRightY, &cull->spotRightZ,
+        &cull->spotUpX, &cull->spotUpY, &cull->spotUpZ,
+        &cull->omniRectX, &cull->omniRectY, &cull->omniRectW, &cull->omniRectH,
+        &cull->spotRectX, &cull->spotRectY, &cull->spotRectW, &cull->spotRectH
+    };
+
+    for (int i = 0; i < R3D_LIGHT_CULL_FLOAT_ARRAYS; i++) {
+        out[i] = fields[i];
+    }
+}
+
+static bool r3d_light_cull_alloc(r3d_light_cull_t* cull, int capacity)
+{
+    // Capacity is padded so the kernels can always process full vectors, 8 being the widest
+    size_t padded = (size_t)((capacity + 7) & ~7);
+    size_t floatBytes = padded * sizeof(float);
+
+    size_t total = R3D_SIMD_ALIGNMENT
+        + R3D_LIGHT_CULL_FLOAT_ARRAYS * floatBytes
+        + padded * sizeof(Rectangle)
+        + padded * sizeof(r3d_light_t*)
+        + 2 * padded * sizeof(int);
+
+    unsigned char* memory = RL_CALLOC(total, 1);
+    if (memory == NULL) return false;
+
+    // Each float array size is a multiple of 32 bytes, aligning the first one aligns them all
+    unsigned char* ptr = (unsigned char*)(((size_t)memory + R3D_SIMD_ALIGNMENT - 1) & ~(size_t)(R3D_SIMD_ALIGNMENT - 1));
+
+    float** fields[R3D_LIGHT_CULL_FLOAT_ARRAYS];
+    r3d_light_cull_get_float_arrays(cull, fields);
+
+    for (int i = 0; i < R3D_LIGHT_CULL_FLOAT_ARRAYS; i++) {
+        *fields[i] = (float*)ptr;
+        ptr += floatBytes;
+    }
+
+    cull->rects = (Rectangle*)ptr;
+    ptr += padded * sizeof(Rectangle);
+
+    cull->lights = (r3d_light_t**)ptr;
+    ptr += padded * sizeof(r3d_light_t*);
+
+    cull->omniSlot = (int*)ptr;
+    ptr += padded * sizeof(int);
+
+    cull->spotSlot = (int*)ptr;
+
+    RL_FREE(cull->memory);
+    cull->memory = memory;
+    cull->capacity = (int)padded;
+
+    return true;
+}
+
+static inline void r3d_light_cull_accumulate(
+    r3d_simd_t x, r3d_simd_t y, r3d_simd_t w, const r3d_light_cull_view_t* view,
+    r3d_simd_t* minX, r3d_simd_t* minY, r3d_simd_t* maxX, r3d_simd_t* maxY)
+{
+    r3d_simd_t zero = r3d_simd_set1(0.0f);
+    r3d_simd_t halfW = r3d_simd_set1(view->halfW);
+    r3d_simd_t halfH = r3d_simd_set1(view->halfH);
+
+    // Perspective divide then NDC to pixels, 'x = (ndc + 1) * w / 2' and 'y = (1 - ndc) * h / 2' so 'y' goes down on screen
+    r3d_simd_t sx = r3d_simd_add(r3d_simd_mul(r3d_simd_div(x, w), halfW), halfW);
+    r3d_simd_t sy = r3d_simd_sub(halfH, r3d_simd_mul(r3d_simd_div(y, w), halfH));
+
+    // Points behind the near plane are ignored
+    *minX = r3d_simd_select_gt(w, zero, r3d_simd_min(*minX, sx), *minX);
+    *minY = r3d_simd_select_gt(w, zero, r3d_simd_min(*minY, sy), *minY);
+    *maxX = r3d_simd_select_gt(w, zero, r3d_simd_max(*maxX, sx), *maxX);
+    *maxY = r3d_simd_select_gt(w, zero, r3d_simd_max(*maxY, sy), *maxY);
+}
+
+static inline void r3d_light_cull_store(
+    float* outX, float* outY, float* outW, float* outH, int i,
+    r3d_simd_t inside, const r3d_light_cull_view_t* view,
+    r3d_simd_t minX, r3d_simd_t minY, r3d_simd_t maxX, r3d_simd_t maxY)
+{
+    // When the camera is inside the volume the whole screen is assumed affected, the corner projection
+    // would not be tighter since some corners fall behind the near plane and are ignored
+    r3d_simd_t half = r3d_simd_set1(0.5f);
+    r3d_simd_t zero = r3d_simd_set1(0.0f);
+
+    r3d_simd_store(outX + i, r3d_simd_select_gt(inside, half, zero, minX));
+    r3d_simd_store(outY + i, r3d_simd_select_gt(inside, half, zero, minY));
+    r3d_simd_store(outW + i, r3d_simd_select_gt(inside, half, r3d_simd_set1(view->screenW), r3d_simd_sub(maxX, minX)));
+    r3d_simd_store(outH + i, r3d_simd_select_gt(inside, half, r3d_simd_set1(view->screenH), r3d_simd_sub(maxY, minY)));
+}
+
+static void r3d_light_cull_omni(r3d_light_cull_t* cull, const r3d_light_cull_view_t* view, int start, int end)
+{
+    const float* m = view->m;
+
+    for (int i = start; i < end; i += R3D_SIMD_WIDTH) {
+        r3d_simd_t x = r3d_simd_load(cull->omniX + i);
+        r3d_simd_t y = r3d_simd_load(cull->omniY + i);
+        r3d_simd_t z = r3d_simd_load(cull->omniZ + i);
+        r3d_simd_t r = r3d_simd_load(cull->omniRadius + i);
+
+        // Camera inside the sphere
+        r3d_simd_t dx = r3d_simd_sub(x, r3d_simd_set1(view->viewPos.x));
+        r3d_simd_t dy = r3d_simd_sub(y, r3d_simd_set1(view->viewPos.y));
+        r3d_simd_t dz = r3d_simd_sub(z, r3d_simd_set1(view->viewPos.z));
+        r3d_simd_t d2 = r3d_simd_add(r3d_simd_add(r3d_simd_mul(dx, dx), r3d_simd_mul(dy, dy)), r3d_simd_mul(dz, dz));
+        r3d_simd_t inside = r3d_simd_select_gt(r3d_simd_mul(r, r), d2, r3d_simd_set1(1.0f), r3d_simd_set1(0.0f));
+
+        // Clip space center, the cube corners are offsets scaled by the radius
+        r3d_simd_t cx = r3d_simd_add(r3d_simd_add(r3d_simd_mul(x, r3d_simd_set1(m[0])), r3d_simd_mul(y, r3d_simd_set1(m[4]))), r3d_simd_add(r3d_simd_mul(z, r3d_simd_set1(m[8])), r3d_simd_set1(m[12])));
+        r3d_simd_t cy = r3d_simd_add(r3d_simd_add(r3d_simd_mul(x, r3d_simd_set1(m[1])), r3d_simd_mul(y, r3d_simd_set1(m[5]))), r3d_simd_add(r3d_simd_mul(z, r3d_simd_set1(m[9])), r3d_simd_set1(m[13])));
+        r3d_simd_t cw = r3d_simd_add(r3d_simd_add(r3d_simd_mul(x, r3d_simd_set1(m[3])), r3d_simd_mul(y, r3d_simd_set1(m[7]))), r3d_simd_add(r3d_simd_mul(z, r3d_simd_set1(m[11])), r3d_simd_set1(m[15])));
+
+        r3d_simd_t minX = r3d_simd_set1(view->screenW);
+        r3d_simd_t minY = r3d_simd_set1(view->screenH);
+        r3d_simd_t maxX = r3d_simd_set1(0.0f);
+        r3d_simd_t maxY = r3d_simd_set1(0.0f);
+
+        for (int k = 0; k < 8; k++) {
+            r3d_simd_t px = r3d_simd_add(cx, r3d_simd_mul(r, r3d_simd_set1(view->cornerX[k])));
+            r3d_simd_t py = r3d_simd_add(cy, r3d_simd_mul(r, r3d_simd_set1(view->cornerY[k])));
+            r3d_simd_t pw = r3d_simd_add(cw, r3d_simd_mul(r, r3d_simd_set1(view->cornerW[k])));
+            r3d_light_cull_accumulate(px, py, pw, view, &minX, &minY, &maxX, &maxY);
+        }
+
+        r3d_light_cull_store(cull->omniRectX, cull->omniRectY, cull->omniRectW, cull->omniRectH, i, inside, view, minX, minY, maxX, maxY);
+    }
+
+    for (int i = start; i < end && i < cull->omniCount; i++) {
+        cull->rects[cull->omniSlot[i]] = (Rectangle) {
+            cull->omniRectX[i], cull->omniRectY[i], cull->omniRectW[i], cull->omniRectH[i]
+        };
+    }
+}
+
+static void r3d_light_cull_spot(r3d_light_cull_t* cull, const r3d_light_cull_view_t* view, int start, int end)
+{
+    // Base circle sampled on 8 points every 45 degrees, the projected cone is bounded by its tip and these points
+    static const float circleCos[8] = { 1.0f, 0.70710678f, 0.0f, -0.70710678f, -1.0f, -0.70710678f, 0.0f, 0.70710678f };
+    static const float circleSin[8] = { 0.0f, 0.70710678f, 1.0f, 0.70710678f, 0.0f, -0.70710678f, -1.0f, -0.70710678f };
+
+    const float* m = view->m;
+
+    r3d_simd_t m0 = r3d_simd_set1(m[0]), m4 = r3d_simd_set1(m[4]), m8 = r3d_simd_set1(m[8]);
+    r3d_simd_t m1 = r3d_simd_set1(m[1]), m5 = r3d_simd_set1(m[5]), m9 = r3d_simd_set1(m[9]);
+    r3d_simd_t m3 = r3d_simd_set1(m[3]), m7 = r3d_simd_set1(m[7]), m11 = r3d_simd_set1(m[11]);
+
+    for (int i = start; i < end; i += R3D_SIMD_WIDTH) {
+        r3d_simd_t x = r3d_simd_load(cull->spotX + i);
+        r3d_simd_t y = r3d_simd_load(cull->spotY + i);
+        r3d_simd_t z = r3d_simd_load(cull->spotZ + i);
+        r3d_simd_t dx = r3d_simd_load(cull->spotDirX + i);
+        r3d_simd_t dy = r3d_simd_load(cull->spotDirY + i);
+        r3d_simd_t dz = r3d_simd_load(cull->spotDirZ + i);
+        r3d_simd_t length = r3d_simd_load(cull->spotLength + i);
+        r3d_simd_t radius = r3d_simd_load(cull->spotRadius + i);
+
+        // Camera inside the cone, see 'r3d_collision_check_point_in_cone'
+        r3d_simd_t tx = r3d_simd_sub(r3d_simd_set1(view->viewPos.x), x);
+        r3d_simd_t ty = r3d_simd_sub(r3d_simd_set1(view->viewPos.y), y);
+        r3d_simd_t tz = r3d_simd_sub(r3d_simd_set1(view->viewPos.z), z);
+        r3d_simd_t proj = r3d_simd_add(r3d_simd_add(r3d_simd_mul(tx, dx), r3d_simd_mul(ty, dy)), r3d_simd_mul(tz, dz));
+        r3d_simd_t dist2 = r3d_simd_add(r3d_simd_add(r3d_simd_mul(tx, tx), r3d_simd_mul(ty, ty)), r3d_simd_mul(tz, tz));
+        r3d_simd_t perp2 = r3d_simd_sub(dist2, r3d_simd_mul(proj, proj));
+        r3d_simd_t coneRadius = r3d_simd_div(r3d_simd_mul(proj, radius), length);
+
+        r3d_simd_t one = r3d_simd_set1(1.0f);
+        r3d_simd_t zero = r3d_simd_set1(0.0f);
+        r3d_simd_t inside = r3d_simd_select_gt(r3d_simd_mul(coneRadius, coneRadius), perp2, one, zero);
+        inside = r3d_simd_select_gt(length, proj, inside, zero);
+        inside = r3d_simd_select_gt(proj, zero, inside, zero);
+
+        // Clip space tip, the base points are offsets along the axis and the circle basis
+        r3d_simd_t cx = r3d_simd_add(r3d_simd_add(r3d_simd_mul(x, m0), r3d_simd_mul(y, m4)), r3d_simd_add(r3d_simd_mul(z, m8), r3d_simd_set1(m[12])));
+        r3d_simd_t cy = r3d_simd_add(r3d_simd_add(r3d_simd_mul(x, m1), r3d_simd_mul(y, m5)), r3d_simd_add(r3d_simd_mul(z, m9), r3d_simd_set1(m[13])));
+        r3d_simd_t cw = r3d_simd_add(r3d_simd_add(r3d_simd_mul(x, m3), r3d_simd_mul(y, m7)), r3d_simd_add(r3d_simd_mul(z, m11), r3d_simd_set1(m[15])));
+
+        r3d_simd_t minX = r3d_simd_set1(view->screenW);
+        r3d_simd_t minY = r3d_simd_set1(view->screenH);
+        r3d_simd_t maxX = r3d_simd_set1(0.0f);
+        r3d_simd_t maxY = r3d_simd_set1(0.0f);
+
+        r3d_light_cull_accumulate(cx, cy, cw, view, &minX, &minY, &maxX, &maxY);
+
+        r3d_simd_t lx = r3d_simd_mul(dx, length);
+        r3d_simd_t ly = r3d_simd_mul(dy, length);
+        r3d_simd_t lz = r3d_simd_mul(dz, length);
+        r3d_simd_t bx = r3d_simd_add(cx, r3d_simd_add(r3d_simd_add(r3d_simd_mul(lx, m0), r3d_simd_mul(ly, m4)), r3d_simd_mul(lz, m8)));
+        r3d_simd_t by = r3d_simd_add(cy, r3d_simd_add(r3d_simd_add(r3d_simd_mul(lx, m1), r3d_simd_mul(ly, m5)), r3d_simd_mul(lz, m9)));
+        r3d_simd_t bw = r3d_simd_add(cw, r3d_simd_add(r3d_simd_add(r3d_simd_mul(lx, m3), r3d_simd_mul(ly, m7)), r3d_simd_mul(lz, m11)));
+
+        r3d_simd_t rx = r3d_simd_load(cull->spotRightX + i);
+        r3d_simd_t ry = r3d_simd_load(cull->spotRightY + i);
+        r3d_simd_t rz = r3d_simd_load(cull->spotRightZ + i);
+        r3d_simd_t rcx = r3d_simd_add(r3d_simd_add(r3d_simd_mul(rx, m0), r3d_simd_mul(ry, m4)), r3d_simd_mul(rz, m8));
+        r3d_simd_t rcy = r3d_simd_add(r3d_simd_add(r3d_simd_mul(rx, m1), r3d_simd_mul(ry, m5)), r3d_simd_mul(rz, m9));
+        r3d_simd_t rcw = r3d_simd_add(r3d_simd_add(r3d_simd_mul(rx, m3), r3d_simd_mul(ry, m7)), r3d_simd_mul(rz, m11));
+
+        r3d_simd_t ux = r3d_simd_load(cull->spotUpX + i);
+        r3d_simd_t uy = r3d_simd_load(cull->spotUpY + i);
+        r3d_simd_t uz = r3d_simd_load(cull->spotUpZ + i);
+        r3d_simd_t ucx = r3d_simd_add(r3d_simd_add(r3d_simd_mul(ux, m0), r3d_simd_mul(uy, m4)), r3d_simd_mul(uz, m8));
+        r3d_simd_t ucy = r3d_simd_add(r3d_simd_add(r3d_simd_mul(ux, m1), r3d_simd_mul(uy, m5)), r3d_simd_mul(uz, m9));
+        r3d_simd_t ucw = r3d_simd_add(r3d_simd_add(r3d_simd_mul(ux, m3), r3d_simd_mul(uy, m7)), r3d_simd_mul(uz, m11));
+
+        for (int k = 0; k < 8; k++) {
+            r3d_simd_t c = r3d_simd_set1(circleCos[k]);
+            r3d_simd_t s = r3d_simd_set1(circleSin[k]);
+            r3d_simd_t px = r3d_simd_add(bx, r3d_simd_add(r3d_simd_mul(c, rcx), r3d_simd_mul(s, ucx)));
+            r3d_simd_t py = r3d_simd_add(by, r3d_simd_add(r3d_simd_mul(c, rcy), r3d_simd_mul(s, ucy)));
+            r3d_simd_t pw = r3d_simd_add(bw, r3d_simd_add(r3d_simd_mul(c, rcw), r3d_simd_mul(s, ucw)));
+            r3d_light_cull_accumulate(px, py, pw, view, &minX, &minY, &maxX, &maxY);
+        }
+
+        r3d_light_cull_store(cull->spotRectX, cull->spotRectY, cull->spotRectW, cull->spotRectH, i, inside, view, minX, minY, maxX, maxY);
+    }
+
+    for (int i = start; i < end && i < cull->spotCount; i++) {
+        cull->rects[cull->spotSlot[i]] = (Rectangle) {
+            cull->spotRectX[i], cull->spotRectY[i], cull->spotRectW[i], cull->spotRectH[i]
+        };
+    }
+}
+
+static void r3d_light_cull_job(void* data, int index)
+{
+    const r3d_light_cull_job_t* job = data;
+    r3d_light_cull_t* cull = job->cull;
+
+    // Omni chunks come first, then spot chunks, the last chunk of a stream is rounded up to full vectors
+    if (index < job->omniChunks) {
+        int start = index * R3D_LIGHT_CULL_CHUNK_SIZE;
+        int end = start + R3D_LIGHT_CULL_CHUNK_SIZE;
+        if (end > cull->omniCount) end = (cull->omniCount + R3D_SIMD_WIDTH - 1) & ~(R3D_SIMD_WIDTH - 1);
+        r3d_light_cull_omni(cull, job->view, start, end);
+    }
+    else {
+        int start = (index - job->omniChunks) * R3D_LIGHT_CULL_CHUNK_SIZE;
+        int end = start + R3D_LIGHT_CULL_CHUNK_SIZE;
+        if (end > cull->spotCount) end = (cull->spotCount + R3D_SIMD_WIDTH - 1) & ~(R3D_SIMD_WIDTH - 1);
+        r3d_light_cull_spot(cull, job->view, start, end);
+    }
+}
+
+/* === Public functions === */
+
+void r3d_light_cull_destroy(r3d_light_cull_t* cull)
+{
+    RL_FREE(cull->memory);
+    *cull = (r3d_light_cull_t) { 0 };
+}
+
+bool r3d_light_cull_begin(r3d_light_cull_t* cull, int count)
+{
+    cull->omniCount = 0;
+    cull->spotCount = 0;
+    cull->count = 0;
+
+    if (count <= cull->capacity) {
+        return true;
+    }
+
+    // Grow geometrically so that lights added one by one do not reallocate every frame
+    int capacity = (cull->capacity > 0) ? cull->capacity : 64;
+    while (capacity < count) capacity *= 2;
+
+    return r3d_light_cull_alloc(cull, capacity);
+}
+
+void r3d_light_cull_push(r3d_light_cull_t* cull, r3d_light_t* light, int screenWidth, int screenHeight)
+{
+    int slot = cull->count++;
+    cull->lights[slot] = light;
+
+    switch (light->type) {
+    case R3D_LIGHT_DIR:
+        cull->rects[slot] = (Rectangle) { 0, 0, (float)screenWidth, (float)screenHeight };
+        break;
+    case R3D_LIGHT_OMNI: {
+        int i = cull->omniCount++;
+        cull->omniX[i] = light->position.x;
+        cull->omniY[i] = light->position.y;
+        cull->omniZ[i] = light->position.z;
+        cull->omniRadius[i] = light->range;
+        cull->omniSlot[i] = slot;
+    } break;
+    case R3D_LIGHT_SPOT: {
+        int i = cull->spotCount++;
+        Vector3 dir = light->direction;
+        float radius = fabsf(light->range * light->outerCutOff); //< r = h * cos(phi)
+
+        cull->spotX[i] = light->position.x;
+        cull->spotY[i] = light->position.y;
+        cull->spotZ[i] = light->position.z;
+        cull->spotDirX[i] = dir.x;
+        cull->spotDirY[i] = dir.y;
+        cull->spotDirZ[i] = dir.z;
+        cull->spotLength[i] = light->range;
+        cull->spotRadius[i] = radius;
+        cull->spotSlot[i] = slot;
+
+        // Base circle basis, 'right' is perpendicular to the direction by swapping out its smallest component,
+        // then scaled to the base radius, and 'up' completes it as 'dir x right'
+        Vector3 right = { 0 };
+        if (fabsf(dir.x) < fabsf(dir.y) && fabsf(dir.x) < fabsf(dir.z)) {
+            right = (Vector3) { 0, -dir.z, dir.y };
+        }
+        else if (fabsf(dir.y) < fabsf(dir.z)) {
+            right = (Vector3) { -dir.z, 0, dir.x };
+        }
+        else {
+            right = (Vector3) { -dir.y, dir.x, 0 };
+        }
+
+        float scale = radius / sqrtf(right.x * right.x + right.y * right.y + right.z * right.z);
+        right.x *= scale, right.y *= scale, right.z *= scale;
+
+        cull->spotRightX[i] = right.x;
+        cull->spotRightY[i] = right.y;
+        cull->spotRightZ[i] = right.z;
+        cull->spotUpX[i] = dir.y * right.z - dir.z * right.y;
+        cull->spotUpY[i] = dir.z * right.x - dir.x * right.z;
+        cull->spotUpZ[i] = dir.x * right.y - dir.y * right.x;
+    } break;
+    }
+}
+
+void r3d_light_cull_compute(r3d_light_cull_t* cull, Vector3 viewPos, Matrix viewProj, int screenWidth, int screenHeight)
+{
+    r3d_light_cull_view_t view = {
+        .m = {
+            viewProj.m0, viewProj.m1, viewProj.m2, viewProj.m3,
+            viewProj.m4, viewProj.m5, viewProj.m6, viewProj.m7,
+            viewProj.m8, viewProj.m9, viewProj.m10, viewProj.m11,
+            viewProj.m12, viewProj.m13, viewProj.m14, viewProj.m15
+        },
+        .viewPos = viewPos,
+        .halfW = 0.5f * screenWidth,
+        .halfH = 0.5f * screenHeight,
+        .screenW = (float)screenWidth,
+        .screenH = (float)screenHeight
+    };
+
+    for (int k = 0; k < 8; k++) {
+        float sx = (k & 1) ? 1.0f : -1.0f;
+        float sy = (k & 2) ? 1.0f : -1.0f;
+        float sz = (k & 4) ? 1.0f : -1.0f;
+        view.cornerX[k] = sx * viewProj.m0 + sy * viewProj.m4 + sz * viewProj.m8;
+        view.cornerY[k] = sx * viewProj.m1 + sy * viewProj.m5 + sz * viewProj.m9;
+        view.cornerW[k] = sx * viewProj.m3 + sy * viewProj.m7 + sz * viewProj.m11;
+    }
+
+    r3d_light_cull_job_t job = {
+        .cull = cull,
+        .view = &view,
+        .omniChunks = (cull->omniCount + R3D_LIGHT_CULL_CHUNK_SIZE - 1) / R3D_LIGHT_CULL_CHUNK_SIZE
+    };
+
+    int spotChunks = (cull->spotCount + R3D_LIGHT_CULL_CHUNK_SIZE - 1) / R3D_LIGHT_CULL_CHUNK_SIZE;
+
+    // Chunks write to disjoint ranges and slots, they can run on any thread
+    r3d_jobs_dispatch(r3d_light_cull_job, &job, job.omniChunks + spotChunks);
+}
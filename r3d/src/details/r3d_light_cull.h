@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#ifndef R3D_LIGHT_CULL_H
+#define R3D_LIGHT_CULL_H
+
+#include "./r3d_light.h"
+#include <raylib.h>
+
+/*
+ * Screen space culling of all the lights of a frame at once.
+ *
+ * The lights are first gathered into one array per attribute, omni and spot lights in
+ * separate streams, then projected by SIMD kernels processing several lights per iteration.
+ * The resulting rectangles are stored in gather order, each light keeping the slot returned
+ * when it was pushed.
+ */
+
+/* === Types === */
+
+typedef struct {
+
+    // Omni stream, bounding sphere of each light
+    float* omniX;
+    float* omniY;
+    float* omniZ;
+    float* omniRadius;
+    int* omniSlot;
+    int omniCount;
+
+    // Spot stream, cone tip and axis, base circle basis scaled by its radius
+    float* spotX;
+    float* spotY;
+    float* spotZ;
+    float* spotDirX;
+    float* spotDirY;
+    float* spotDirZ;
+    float* spotLength;
+    float* spotRadius;
+    float* spotRightX;
+    float* spotRightY;
+    float* spotRightZ;
+    float* spotUpX;
+    float* spotUpY;
+    float* spotUpZ;
+    int* spotSlot;
+    int spotCount;
+
+    // Kernel outputs of both streams, indexed like their inputs
+    float* omniRectX;
+    float* omniRectY;
+    float* omniRectW;
+    float* omniRectH;
+    float* spotRectX;
+    float* spotRectY;
+    float* spotRectW;
+    float* spotRectH;
+
+    // Per slot results
+    r3d_light_t** lights;
+    Rectangle* rects;
+    int count;
+
+    int capacity;
+    void* memory;
+
+} r3d_light_cull_t;
+
+/* === Functions === */
+
+// Releases the arrays, the structure can be reused afterwards
+void r3d_light_cull_destroy(r3d_light_cull_t* cull);
+
+// Clears the streams and makes room for 'count' lights, returns false on allocation failure
+bool r3d_light_cull_begin(r3d_light_cull_t* cull, int count);
+
+// Adds a light to its stream, directional lights directly cover the whole screen
+void r3d_light_cull_push(r3d_light_cull_t* cull, r3d_light_t* light, int screenWidth, int screenHeight);
+
+// Projects every pushed light, splits the work on the job threads when there are enough lights
+void r3d_light_cull_compute(r3d_light_cull_t* cull, Vector3 viewPos, Matrix viewProj, int screenWidth, int screenHeight);
+
+#endif // R3D_LIGHT_CULL_H
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "./r3d_readback.h"
+
+#include <string.h>
+#include <glad.h>
+
+/* === Internal functions === */
+
+static void r3d_readback_release(r3d_readback_slot_t* slot)
+{
+    glDeleteSync((GLsync)slot->fence);
+    slot->fence = NULL;
+    slot->request = 0;
+}
+
+/* === Public functions === */
+
+r3d_readback_slot_t* r3d_readback_find(r3d_readback_ring_t* ring, unsigned int request)
+{
+    if (request == 0) {
+        return NULL;
+    }
+
+    for (int i = 0; i < R3D_READBACK_RING_SIZE; i++) {
+        if (ring->slots[i].request == request) {
+            return &ring->slots[i];
+        }
+    }
+
+    return NULL;
+}
+
+void r3d_readback_destroy(r3d_readback_ring_t* ring)
+{
+    for (int i = 0; i < R3D_READBACK_RING_SIZE; i++) {
+        r3d_readback_slot_t* slot = &ring->slots[i];
+        if (slot->request != 0) {
+            r3d_readback_release(slot);
+        }
+        if (slot->pbo != 0) {
+            glDeleteBuffers(1, &slot->pbo);
+        }
+    }
+
+    memset(ring, 0, sizeof(*ring));
+}
+
+unsigned int r3d_readback_push(r3d_readback_ring_t* ring, unsigned int fbo, int width, int height, bool depth)
+{
+    r3d_readback_slot_t* slot = NULL;
+
+    for (int i = 0; i < R3D_READBACK_RING_SIZE; i++) {
+        if (ring->slots[i].request == 0) {
+            slot = &ring->slots[i];
+            break;
+        }
+    }
+
+    if (slot == NULL) {
+        return 0;
+    }
+
+    slot->width = width;
+    slot->height = height;
+    slot->pixelSize = depth ? 4 : 3;
+
+    int size = width * height * slot->pixelSize;
+
+    if (slot->pbo == 0) {
+        glGenBuffers(1, &slot->pbo);
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+
+    if (slot->capacity != size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+        slot->capacity = size;
+    }
+
+    GLint prevReadFbo = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &prevReadFbo);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+
+    // The copy is only queued here, glReadPixels returns immediately when a PBO is bound
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    if (depth) {
+        glReadPixels(0, 0, width, height, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+    }
+    else {
+        glReadBuffer(GL_COLOR_ATTACHMENT0);
+        glReadPixels(0, 0, width, height, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+    }
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, prevReadFbo);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    if (++ring->lastRequest == 0) {
+        ring->lastRequest = 1;
+    }
+
+    slot->request = ring->lastRequest;
+
+    return slot->request;
+}
+
+unsigned int r3d_readback_oldest(const r3d_readback_ring_t* ring)
+{
+    unsigned int oldest = 0;
+    unsigned int oldestAge = 0;
+
+    for (int i = 0; i < R3D_READBACK_RING_SIZE; i++) {
+        unsigned int request = ring->slots[i].request;
+        if (request == 0) continue;
+
+        // Unsigned difference stays correct when the identifiers wrap around
+        unsigned int age = ring->lastRequest - request;
+        if (oldest == 0 || age > oldestAge) {
+            oldest = request;
+            oldestAge = age;
+        }
+    }
+
+    return oldest;
+}
+
+r3d_readback_status_t r3d_readback_poll(r3d_readback_ring_t* ring, unsigned int request, bool wait)
+{
+    r3d_readback_slot_t* slot = r3d_readback_find(ring, request);
+    if (slot == NULL) {
+        return R3D_READBACK_STATUS_INVALID;
+    }
+
+    GLenum result = glClientWaitSync((GLsync)slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+
+    while (wait && result == GL_TIMEOUT_EXPIRED) {
+        result = glClientWaitSync((GLsync)slot->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    }
+
+    if (result == GL_TIMEOUT_EXPIRED) {
+        return R3D_READBACK_STATUS_PENDING;
+    }
+
+    if (result == GL_WAIT_FAILED) {
+        r3d_readback_release(slot);
+        return R3D_READBACK_STATUS_INVALID;
+    }
+
+    return R3D_READBACK_STATUS_READY;
+}
+
+r3d_readback_status_t r3d_readback_fetch(r3d_readback_ring_t* ring, unsigned int request, void* dst, bool wait)
+{
+    r3d_readback_status_t status = r3d_readback_poll(ring, request, wait);
+    if (status != R3D_READBACK_STATUS_READY) {
+        return status;
+    }
+
+    r3d_readback_slot_t* slot = r3d_readback_find(ring, request);
+
+    int pitch = slot->width * slot->pixelSize;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->pbo);
+
+    const unsigned char* src = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, pitch * slot->height, GL_MAP_READ_BIT);
+    if (src != NULL) {
+        // OpenGL rows go from bottom to top
+        for (int y = 0; y < slot->height; y++) {
+            memcpy((unsigned char*)dst + y * pitch, src + (slot->height - 1 - y) * pitch, pitch);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    r3d_readback_release(slot);
+
+    return (src != NULL) ? R3D_READBACK_STATUS_READY : R3D_READBACK_STATUS_INVALID;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#ifndef R3D_DETAILS_READBACK_H
+#define R3D_DETAILS_READBACK_H
+
+#include <stdbool.h>
+
+/* === Defines === */
+
+#define R3D_READBACK_RING_SIZE 4    //< Readbacks that can be in flight at the same time in a ring
+
+/* === Types === */
+
+typedef enum {
+    R3D_READBACK_STATUS_INVALID,    //< Unknown or already fetched request
+    R3D_READBACK_STATUS_PENDING,    //< The GPU has not finished the copy yet
+    R3D_READBACK_STATUS_READY
+} r3d_readback_status_t;
+
+typedef struct {
+    unsigned int request;           //< Request identifier, 0 when the slot is free
+    unsigned int pbo;
+    void* fence;                    //< GLsync signaled once the copy into the PBO is done
+    int width;
+    int height;
+    int pixelSize;                  //< 3 for RGB8 color, 4 for 32-bit float depth
+    int capacity;                   //< Size in bytes of the PBO storage
+} r3d_readback_slot_t;
+
+/*
+ * Ring of pixel buffer objects receiving asynchronous framebuffer copies.
+ * A read is queued on the GPU with a fence and mapped only once the fence is signaled,
+ * usually a few frames later, so the CPU never waits for the pipeline to drain.
+ */
+typedef struct {
+    r3d_readback_slot_t slots[R3D_READBACK_RING_SIZE];
+    unsigned int lastRequest;
+} r3d_readback_ring_t;
+
+/* === Functions === */
+
+// Deletes the PBOs and the fences of the pending requests
+void r3d_readback_destroy(r3d_readback_ring_t* ring);
+
+// Returns the slot of a pending request, NULL if the request is unknown or already fetched
+r3d_readback_slot_t* r3d_readback_find(r3d_readback_ring_t* ring, unsigned int request);
+
+// Queues the copy of the color attachment 0 (or the depth if 'depth') of 'fbo', returns 0 if the ring is full
+unsigned int r3d_readback_push(r3d_readback_ring_t* ring, unsigned int fbo, int width, int height, bool depth);
+
+// Returns the oldest pending request, 0 if there is none
+unsigned int r3d_readback_oldest(const r3d_readback_ring_t* ring);
+
+// Checks the fence of a request without blocking, or waits for it if 'wait' is true
+r3d_readback_status_t r3d_readback_poll(r3d_readback_ring_t* ring, unsigned int request, bool wait);
+
+// Copies the result of a ready request into 'dst' with its rows from top to bottom, then releases the slot
+r3d_readback_status_t r3d_readback_fetch(r3d_readback_ring_t* ring, unsigned int request, void* dst, bool wait);
+
+#endif // R3D_DETAILS_READBACK_H
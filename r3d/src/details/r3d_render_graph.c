@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_render_graph.h"
+
+/* === Internal functions === */
+
+static bool r3d_render_graph_compatible(const r3d_render_resource_t* a, const r3d_render_resource_t* b)
+{
+    return a->format == b->format && a->width == b->width && a->height == b->height;
+}
+
+/* === Public functions === */
+
+void r3d_render_graph_begin(r3d_render_graph_t* graph)
+{
+    graph->resourceCount = 0;
+    graph->passCount = 0;
+}
+
+void r3d_render_graph_set_resource(r3d_render_graph_t* graph, int id, r3d_render_resource_t resource)
+{
+    graph->resources[id] = resource;
+
+    if (graph->resourceCount <= id) {
+        graph->resourceCount = id + 1;
+    }
+}
+
+int r3d_render_graph_add_pass(r3d_render_graph_t* graph, const char* name, r3d_render_pass_func_t execute, bool enabled, bool sideEffect)
+{
+    int index = graph->passCount++;
+
+    graph->passes[index] = (r3d_render_pass_t) {
+        .name = name,
+        .execute = execute,
+        .enabled = enabled,
+        .sideEffect = sideEffect
+    };
+
+    return index;
+}
+
+void r3d_render_graph_read(r3d_render_graph_t* graph, int pass, int id)
+{
+    graph->passes[pass].reads |= (1u << id);
+}
+
+void r3d_render_graph_write(r3d_render_graph_t* graph, int pass, int id)
+{
+    graph->passes[pass].writes |= (1u << id);
+}
+
+void r3d_render_graph_compile(r3d_render_graph_t* graph)
+{
+    // Walk backwards, a pass is needed if a later kept pass reads one of its outputs
+    uint32_t needed = 0;
+
+    for (int i = graph->passCount - 1; i >= 0; i--) {
+        r3d_render_pass_t* pass = &graph->passes[i];
+        pass->culled = !pass->enabled || (!pass->sideEffect && (pass->writes & needed) == 0);
+        if (!pass->culled) {
+            needed |= pass->reads;
+        }
+    }
+
+    for (int r = 0; r < graph->resourceCount; r++) {
+        graph->firstUse[r] = -1;
+        graph->lastUse[r] = -1;
+    }
+
+    for (int i = 0; i < graph->passCount; i++) {
+        const r3d_render_pass_t* pass = &graph->passes[i];
+        if (pass->culled) continue;
+
+        uint32_t used = pass->reads | pass->writes;
+        for (int r = 0; r < graph->resourceCount; r++) {
+            if ((used & (1u << r)) == 0) continue;
+            if (graph->firstUse[r] < 0) graph->firstUse[r] = i;
+            graph->lastUse[r] = i;
+        }
+    }
+}
+
+void r3d_render_graph_alias(r3d_render_graph_t* graph)
+{
+    int slotLastUse[R3D_RENDER_GRAPH_MAX_RESOURCES];
+    int slotOwner[R3D_RENDER_GRAPH_MAX_RESOURCES];
+
+    graph->slotCount = 0;
+
+    for (int r = 0; r < graph->resourceCount; r++) {
+        graph->slots[r] = -1;
+    }
+
+    // Transient resources in order of first use, each one takes the first compatible slot free by then
+    for (int pass = 0; pass < graph->passCount; pass++) {
+        for (int r = 0; r < graph->resourceCount; r++) {
+            const r3d_render_resource_t* resource = &graph->resources[r];
+            if (!resource->transient || graph->firstUse[r] != pass) continue;
+
+            int slot = -1;
+            for (int s = 0; s < graph->slotCount && slot < 0; s++) {
+                if (slotOwner[s] >= 0 && slotLastUse[s] < pass &&
+                    r3d_render_graph_compatible(&graph->resources[slotOwner[s]], resource)) {
+                    slot = s;
+                }
+            }
+
+            if (slot < 0) {
+                slot = graph->slotCount++;
+                slotOwner[slot] = r;
+            }
+
+            slotLastUse[slot] = graph->lastUse[r];
+            graph->slots[r] = slot;
+        }
+    }
+
+    // Persistent and unused resources keep a slot of their own
+    for (int r = 0; r < graph->resourceCount; r++) {
+        if (graph->slots[r] < 0) {
+            int slot = graph->slotCount++;
+            slotOwner[slot] = -1;
+            graph->slots[r] = slot;
+        }
+    }
+}
+
+void r3d_render_graph_execute(const r3d_render_graph_t* graph, r3d_render_pass_hook_t hook)
+{
+    for (int i = 0; i < graph->passCount; i++) {
+        if (graph->passes[i].culled) continue;
+        if (hook) hook(i, false);
+        graph->passes[i].execute();
+        if (hook) hook(i, true);
+    }
+}
+
+int r3d_render_graph_get_culled_count(const r3d_render_graph_t* graph)
+{
+    int count = 0;
+
+    for (int i = 0; i < graph->passCount; i++) {
+        count += graph->passes[i].culled;
+    }
+
+    return count;
+}
+
+unsigned int r3d_render_graph_get_memory(const r3d_render_graph_t* graph, bool usedOnly)
+{
+    unsigned int slotBytes[R3D_RENDER_GRAPH_MAX_RESOURCES] = { 0 };
+
+    for (int r = 0; r < graph->resourceCount; r++) {
+        const r3d_render_resource_t* resource = &graph->resources[r];
+        if (!resource->allocated) continue;
+        if (usedOnly && graph->firstUse[r] < 0) continue;
+
+        int slot = graph->slots[r];
+        if (slotBytes[slot] < resource->bytes) {
+            slotBytes[slot] = resource->bytes;
+        }
+    }
+
+    unsigned int total = 0;
+    for (int s = 0; s < graph->slotCount; s++) {
+        total += slotBytes[s];
+    }
+
+    return total;
+}
+
+unsigned int r3d_render_graph_get_unaliased_memory(const r3d_render_graph_t* graph)
+{
+    unsigned int total = 0;
+
+    for (int r = 0; r < graph->resourceCount; r++) {
+        if (graph->resources[r].allocated) {
+            total += graph->resources[r].bytes;
+        }
+    }
+
+    return total;
+}
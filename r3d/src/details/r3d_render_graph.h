@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#ifndef R3D_DETAILS_RENDER_GRAPH_H
+#define R3D_DETAILS_RENDER_GRAPH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/* === Defines === */
+
+#define R3D_RENDER_GRAPH_MAX_PASSES 32
+#define R3D_RENDER_GRAPH_MAX_RESOURCES 32
+
+/* === Types === */
+
+typedef void (*r3d_render_pass_func_t)(void);
+
+// Called around each executed pass with its index, 'after' is false before the pass and true after it
+typedef void (*r3d_render_pass_hook_t)(int pass, bool after);
+
+typedef struct {
+    const char* name;
+    unsigned int format;            //< Internal format, resources only share memory with resources of the same format and size
+    int width;
+    int height;
+    unsigned int bytes;             //< Size of the storage, all levels and ping-pong copies included
+    bool transient;                 //< Only read by the passes of a frame, its storage can be shared
+    bool allocated;                 //< False if the resource currently has no storage
+} r3d_render_resource_t;
+
+typedef struct {
+    const char* name;
+    r3d_render_pass_func_t execute;
+    uint32_t reads;                 //< Bit mask of the resources read by the pass
+    uint32_t writes;                //< Bit mask of the resources written by the pass
+    bool enabled;
+    bool sideEffect;                //< Kept even if no pass reads its outputs, for passes writing outside of the graph
+    bool culled;                    //< Set by 'r3d_render_graph_compile'
+} r3d_render_pass_t;
+
+/*
+ * Describes a frame as passes reading and writing resources.
+ * Compiling the graph culls the disabled passes and the passes whose outputs are never read,
+ * then computes the lifetime of each resource. Aliasing assigns transient resources with
+ * disjoint lifetimes to the same physical slot, so they can be backed by the same storage.
+ *
+ * The slots are kept across 'r3d_render_graph_begin', they are only recomputed by 'r3d_render_graph_alias'.
+ */
+typedef struct {
+
+    r3d_render_resource_t resources[R3D_RENDER_GRAPH_MAX_RESOURCES];
+    int resourceCount;
+
+    r3d_render_pass_t passes[R3D_RENDER_GRAPH_MAX_PASSES];
+    int passCount;
+
+    int firstUse[R3D_RENDER_GRAPH_MAX_RESOURCES];   //< First kept pass using each resource, -1 if unused
+    int lastUse[R3D_RENDER_GRAPH_MAX_RESOURCES];    //< Last kept pass using each resource, -1 if unused
+
+    int slots[R3D_RENDER_GRAPH_MAX_RESOURCES];      //< Physical slot of each resource
+    int slotCount;
+
+} r3d_render_graph_t;
+
+/* === Functions === */
+
+// Removes the passes and resources declared for the previous frame, the slots are kept
+void r3d_render_graph_begin(r3d_render_graph_t* graph);
+
+// Declares the resource 'id', ids are expected to be contiguous from 0
+void r3d_render_graph_set_resource(r3d_render_graph_t* graph, int id, r3d_render_resource_t resource);
+
+// Appends a pass executed in declaration order, returns its index
+int r3d_render_graph_add_pass(r3d_render_graph_t* graph, const char* name, r3d_render_pass_func_t execute, bool enabled, bool sideEffect);
+
+// Declares that 'pass' reads / writes the resource 'id'
+void r3d_render_graph_read(r3d_render_graph_t* graph, int pass, int id);
+void r3d_render_graph_write(r3d_render_graph_t* graph, int pass, int id);
+
+// Culls the passes that are disabled or whose outputs are never read, then computes the resource lifetimes
+void r3d_render_graph_compile(r3d_render_graph_t* graph);
+
+// Assigns the physical slots from the lifetimes of the last compilation
+void r3d_render_graph_alias(r3d_render_graph_t* graph);
+
+// Runs the passes kept by the last compilation, 'hook' can be NULL
+void r3d_render_graph_execute(const r3d_render_graph_t* graph, r3d_render_pass_hook_t hook);
+
+// Returns the number of passes culled by the last compilation
+int r3d_render_graph_get_culled_count(const r3d_render_graph_t* graph);
+
+// Returns the bytes of the allocated slots, or of the slots used by the kept passes if 'usedOnly' is true
+unsigned int r3d_render_graph_get_memory(const r3d_render_graph_t* graph, bool usedOnly);
+
+// Returns the bytes the allocated resources would take without aliasing
+unsigned int r3d_render_graph_get_unaliased_memory(const r3d_render_graph_t* graph);
+
+#endif // R3D_DETAILS_RENDER_GRAPH_H
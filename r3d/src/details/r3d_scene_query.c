@@ -0,0 +1,465 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "./r3d_scene_query.h"
+
+#include "./misc/r3d_hash.h"
+#include <raymath.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>
+#include <math.h>
+
+/* === Internal constants === */
+
+#define R3D_SCENE_QUERY_MAX_MESHES 4096     //< The mesh cache is flushed by the next frame past this count
+#define R3D_SCENE_QUERY_REBUILD_RATIO 1.5f  //< A refit growing the summed node area past this factor triggers a rebuild
+
+/* === Internal types === */
+
+typedef struct {
+    r3d_scene_query_t* query;
+    bool precise;
+    int object;         //< Closest object so far, -1 if none
+    Vector3 normal;     //< World space normal of the closest hit, not normalized
+} r3d_scene_query_ray_t;
+
+typedef struct {
+    const r3d_scene_query_mesh_t* mesh;
+    Vector3 normal;     //< Local space normal of the closest triangle, not normalized
+} r3d_scene_query_triangle_ray_t;
+
+typedef struct {
+    const r3d_scene_query_t* query;
+    BoundingBox box;
+    R3D_QueryHit* hits;
+    int maxHits;
+    int count;
+} r3d_scene_query_box_t;
+
+/* === Internal functions === */
+
+static uint64_t r3d_scene_query_mesh_key(const Mesh* mesh)
+{
+    // The buffers identify the mesh, the counts tell apart a mesh reloaded at the same addresses
+    uint64_t hash = R3D_HASH_FNV1A_SEED;
+    hash = r3d_hash_fnv1a(hash, &mesh->vaoId, sizeof(mesh->vaoId));
+    hash = r3d_hash_fnv1a(hash, &mesh->vertices, sizeof(mesh->vertices));
+    hash = r3d_hash_fnv1a(hash, &mesh->indices, sizeof(mesh->indices));
+    hash = r3d_hash_fnv1a(hash, &mesh->vertexCount, sizeof(mesh->vertexCount));
+    hash = r3d_hash_fnv1a(hash, &mesh->triangleCount, sizeof(mesh->triangleCount));
+    return hash;
+}
+
+static bool r3d_scene_query_grow_table(r3d_scene_query_t* query)
+{
+    int size = (query->tableSize > 0) ? 2 * query->tableSize : 64;
+
+    int* table = RL_MALLOC(size * sizeof(int));
+    if (table == NULL) return false;
+
+    memset(table, -1, size * sizeof(int));
+
+    for (int i = 0; i < query->meshCount; i++) {
+        int slot = (int)(query->meshes[i].key & (uint64_t)(size - 1));
+        while (table[slot] >= 0) slot = (slot + 1) & (size - 1);
+        table[slot] = i;
+    }
+
+    RL_FREE(query->table);
+    query->table = table;
+    query->tableSize = size;
+
+    return true;
+}
+
+static int r3d_scene_query_find_mesh(r3d_scene_query_t* query, const Mesh* mesh)
+{
+    if (2 * (query->meshCount + 1) > query->tableSize) {
+        if (!r3d_scene_query_grow_table(query)) return -1;
+    }
+
+    uint64_t key = r3d_scene_query_mesh_key(mesh);
+    int mask = query->tableSize - 1;
+    int slot = (int)(key & (uint64_t)mask);
+
+    while (query->table[slot] >= 0) {
+        int index = query->table[slot];
+        if (query->meshes[index].key == key) return index;
+        slot = (slot + 1) & mask;
+    }
+
+    if (query->meshCount == query->meshCapacity) {
+        int capacity = (query->meshCapacity > 0) ? 2 * query->meshCapacity : 64;
+        r3d_scene_query_mesh_t* meshes = RL_REALLOC(query->meshes, capacity * sizeof(r3d_scene_query_mesh_t));
+        if (meshes == NULL) return -1;
+        query->meshes = meshes;
+        query->meshCapacity = capacity;
+    }
+
+    int index = query->meshCount++;
+
+    query->meshes[index] = (r3d_scene_query_mesh_t) {
+        .key = key,
+        .bounds = GetMeshBoundingBox(*mesh),
+        .vertices = mesh->vertices,
+        .indices = mesh->indices,
+        .triangleCount = (mesh->indices != NULL) ? mesh->triangleCount : mesh->vertexCount / 3
+    };
+
+    query->table[slot] = index;
+
+    return index;
+}
+
+static void r3d_scene_query_flush_meshes(r3d_scene_query_t* query)
+{
+    for (int i = 0; i < query->meshCount; i++) {
+        r3d_bvh_destroy(&query->meshes[i].triangles);
+    }
+
+    query->meshCount = 0;
+
+    if (query->table != NULL) {
+        memset(query->table, -1, query->tableSize * sizeof(int));
+    }
+}
+
+static BoundingBox r3d_scene_query_transform_box(BoundingBox box, Matrix m)
+{
+    Vector3 c = Vector3Scale(Vector3Add(box.min, box.max), 0.5f);
+    Vector3 e = Vector3Scale(Vector3Subtract(box.max, box.min), 0.5f);
+
+    Vector3 wc = Vector3Transform(c, m);
+
+    Vector3 we = {
+        fabsf(m.m0) * e.x + fabsf(m.m4) * e.y + fabsf(m.m8) * e.z,
+        fabsf(m.m1) * e.x + fabsf(m.m5) * e.y + fabsf(m.m9) * e.z,
+        fabsf(m.m2) * e.x + fabsf(m.m6) * e.y + fabsf(m.m10) * e.z
+    };
+
+    return (BoundingBox) { Vector3Subtract(wc, we), Vector3Add(wc, we) };
+}
+
+static void r3d_scene_query_get_triangle(const r3d_scene_query_mesh_t* mesh, int triangle, Vector3 v[3])
+{
+    for (int i = 0; i < 3; i++) {
+        int index = (mesh->indices != NULL) ? mesh->indices[3 * triangle + i] : 3 * triangle + i;
+        const float* p = &mesh->vertices[3 * index];
+        v[i] = (Vector3) { p[0], p[1], p[2] };
+    }
+}
+
+static bool r3d_scene_query_build_triangles(r3d_scene_query_mesh_t* mesh)
+{
+    if (mesh->trianglesBuilt) {
+        return mesh->triangles.nodeCount > 0;
+    }
+
+    mesh->trianglesBuilt = true;
+
+    BoundingBox* boxes = RL_MALLOC(mesh->triangleCount * sizeof(BoundingBox));
+    if (boxes == NULL) return false;
+
+    for (int i = 0; i < mesh->triangleCount; i++) {
+        Vector3 v[3];
+        r3d_scene_query_get_triangle(mesh, i, v);
+        boxes[i].min = Vector3Min(Vector3Min(v[0], v[1]), v[2]);
+        boxes[i].max = Vector3Max(Vector3Max(v[0], v[1]), v[2]);
+    }
+
+    bool built = r3d_bvh_build(&mesh->triangles, boxes, mesh->triangleCount);
+
+    RL_FREE(boxes);
+
+    return built && mesh->triangles.nodeCount > 0;
+}
+
+static void r3d_scene_query_update(r3d_scene_query_t* query)
+{
+    if (!query->dirty) {
+        return;
+    }
+
+    query->dirty = false;
+
+    // The tree refers to objects by index, it stays valid as long as their count matches
+    if (query->builtCount > 0 && query->builtCount == query->objectCount) {
+        if (r3d_bvh_refit(&query->bvh, query->bounds) <= R3D_SCENE_QUERY_REBUILD_RATIO) {
+            return;
+        }
+    }
+
+    bool built = r3d_bvh_build(&query->bvh, query->bounds, query->objectCount);
+    query->builtCount = built ? query->objectCount : 0;
+
+    if (!built) {
+        TraceLog(LOG_WARNING, "R3D: Failed to build the scene query hierarchy");
+    }
+}
+
+// Double sided Moller-Trumbore test, returns 'maxDist' on a miss
+static float r3d_scene_query_ray_triangle(Ray ray, const Vector3 v[3], float maxDist)
+{
+    Vector3 e1 = Vector3Subtract(v[1], v[0]);
+    Vector3 e2 = Vector3Subtract(v[2], v[0]);
+
+    Vector3 p = Vector3CrossProduct(ray.direction, e2);
+    float det = Vector3DotProduct(e1, p);
+    if (fabsf(det) < 1e-12f) return maxDist;
+
+    float invDet = 1.0f / det;
+    Vector3 s = Vector3Subtract(ray.position, v[0]);
+
+    float u = Vector3DotProduct(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f) return maxDist;
+
+    Vector3 q = Vector3CrossProduct(s, e1);
+    float w = Vector3DotProduct(ray.direction, q) * invDet;
+    if (w < 0.0f || u + w > 1.0f) return maxDist;
+
+    float t = Vector3DotProduct(e2, q) * invDet;
+
+    return (t >= 0.0f && t < maxDist) ? t : maxDist;
+}
+
+static Vector3 r3d_scene_query_box_normal(BoundingBox box, Vector3 point)
+{
+    float d[6] = {
+        fabsf(point.x - box.min.x), fabsf(point.x - box.max.x),
+        fabsf(point.y - box.min.y), fabsf(point.y - box.max.y),
+        fabsf(point.z - box.min.z), fabsf(point.z - box.max.z)
+    };
+
+    int face = 0;
+    for (int i = 1; i < 6; i++) {
+        if (d[i] < d[face]) face = i;
+    }
+
+    float sign = (face & 1) ? 1.0f : -1.0f;
+
+    switch (face / 2) {
+    case 0: return (Vector3) { sign, 0.0f, 0.0f };
+    case 1: return (Vector3) { 0.0f, sign, 0.0f };
+    default: return (Vector3) { 0.0f, 0.0f, sign };
+    }
+}
+
+static float r3d_scene_query_ray_triangle_fn(void* user, int item, Ray ray, float maxDist)
+{
+    r3d_scene_query_triangle_ray_t* ctx = user;
+
+    Vector3 v[3];
+    r3d_scene_query_get_triangle(ctx->mesh, item, v);
+
+    float dist = r3d_scene_query_ray_triangle(ray, v, maxDist);
+    if (dist < maxDist) {
+        ctx->normal = Vector3CrossProduct(Vector3Subtract(v[1], v[0]), Vector3Subtract(v[2], v[0]));
+    }
+
+    return dist;
+}
+
+static float r3d_scene_query_ray_object_fn(void* user, int item, Ray ray, float maxDist)
+{
+    r3d_scene_query_ray_t* ctx = user;
+
+    const r3d_scene_query_object_t* object = &ctx->query->objects[item];
+    r3d_scene_query_mesh_t* mesh = &ctx->query->meshes[object->mesh];
+
+    if (!ctx->precise || mesh->triangleCount == 0 || !r3d_scene_query_build_triangles(mesh)) {
+        BoundingBox box = ctx->query->bounds[item];
+        Vector3 invDir = { 1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z };
+        float dist = r3d_bvh_ray_box(ray.position, invDir, box.min, box.max, maxDist);
+        if (dist < 0.0f || dist >= maxDist) return maxDist;
+        ctx->object = item;
+        ctx->normal = r3d_scene_query_box_normal(box, Vector3Add(ray.position, Vector3Scale(ray.direction, dist)));
+        return dist;
+    }
+
+    // The direction is not normalized in local space so that the distances keep the world scale
+    Matrix inv = MatrixInvert(object->transform);
+    Ray local = {
+        .position = Vector3Transform(ray.position, inv),
+        .direction = {
+            inv.m0 * ray.direction.x + inv.m4 * ray.direction.y + inv.m8 * ray.direction.z,
+            inv.m1 * ray.direction.x + inv.m5 * ray.direction.y + inv.m9 * ray.direction.z,
+            inv.m2 * ray.direction.x + inv.m6 * ray.direction.y + inv.m10 * ray.direction.z
+        }
+    };
+
+    r3d_scene_query_triangle_ray_t triangleCtx = { .mesh = mesh };
+    float dist = r3d_bvh_raycast(&mesh->triangles, local, maxDist, r3d_scene_query_ray_triangle_fn, &triangleCtx);
+    if (dist >= maxDist) return maxDist;
+
+    // Normals go through the inverse transpose of the transform
+    Vector3 n = triangleCtx.normal;
+    ctx->object = item;
+    ctx->normal = (Vector3) {
+        inv.m0 * n.x + inv.m1 * n.y + inv.m2 * n.z,
+        inv.m4 * n.x + inv.m5 * n.y + inv.m6 * n.z,
+        inv.m8 * n.x + inv.m9 * n.y + inv.m10 * n.z
+    };
+
+    return dist;
+}
+
+static bool r3d_scene_query_box_fn(void* user, int item)
+{
+    r3d_scene_query_box_t* ctx = user;
+
+    // The leaves are reported whole, their objects still have to be tested one by one
+    BoundingBox bounds = ctx->query->bounds[item];
+    if (!CheckCollisionBoxes(bounds, ctx->box)) {
+        return true;
+    }
+
+    const r3d_scene_query_object_t* object = &ctx->query->objects[item];
+
+    ctx->hits[ctx->count++] = (R3D_QueryHit) {
+        .id = object->id,
+        .instance = object->instance,
+        .bounds = bounds
+    };
+
+    return ctx->count < ctx->maxHits;
+}
+
+/* === Public functions === */
+
+void r3d_scene_query_destroy(r3d_scene_query_t* query)
+{
+    r3d_scene_query_flush_meshes(query);
+    r3d_bvh_destroy(&query->bvh);
+
+    RL_FREE(query->objects);
+    RL_FREE(query->bounds);
+    RL_FREE(query->meshes);
+    RL_FREE(query->table);
+
+    *query = (r3d_scene_query_t) { 0 };
+}
+
+void r3d_scene_query_begin(r3d_scene_query_t* query)
+{
+    query->objectCount = 0;
+
+    // Unloaded meshes are never removed individually, the whole cache goes once it grows too big
+    if (query->meshCount > R3D_SCENE_QUERY_MAX_MESHES) {
+        r3d_scene_query_flush_meshes(query);
+    }
+}
+
+int r3d_scene_query_get_mesh(r3d_scene_query_t* query, const Mesh* mesh)
+{
+    if (mesh->vertices == NULL || mesh->vertexCount == 0) {
+        return -1;
+    }
+
+    return r3d_scene_query_find_mesh(query, mesh);
+}
+
+void r3d_scene_query_push(r3d_scene_query_t* query, int mesh, Matrix transform, int id, int instance)
+{
+    if (query->objectCount == query->objectCapacity) {
+        int capacity = (query->objectCapacity > 0) ? 2 * query->objectCapacity : 256;
+
+        r3d_scene_query_object_t* objects = RL_REALLOC(query->objects, capacity * sizeof(r3d_scene_query_object_t));
+        if (objects == NULL) return;
+        query->objects = objects;
+
+        BoundingBox* bounds = RL_REALLOC(query->bounds, capacity * sizeof(BoundingBox));
+        if (bounds == NULL) return;
+        query->bounds = bounds;
+
+        query->objectCapacity = capacity;
+    }
+
+    int index = query->objectCount++;
+
+    query->objects[index] = (r3d_scene_query_object_t) {
+        .transform = transform,
+        .mesh = mesh,
+        .id = id,
+        .instance = instance
+    };
+
+    query->bounds[index] = r3d_scene_query_transform_box(query->meshes[mesh].bounds, transform);
+}
+
+void r3d_scene_query_end(r3d_scene_query_t* query)
+{
+    query->dirty = true;
+}
+
+R3D_RayHit r3d_scene_query_raycast(r3d_scene_query_t* query, Ray ray, float maxDist, bool precise)
+{
+    R3D_RayHit hit = { 0 };
+
+    r3d_scene_query_update(query);
+
+    float length = Vector3Length(ray.direction);
+    if (length <= 0.0f || query->objectCount == 0) {
+        return hit;
+    }
+
+    ray.direction = Vector3Scale(ray.direction, 1.0f / length);
+
+    r3d_scene_query_ray_t ctx = {
+        .query = query,
+        .precise = precise,
+        .object = -1
+    };
+
+    float dist = r3d_bvh_raycast(&query->bvh, ray, maxDist, r3d_scene_query_ray_object_fn, &ctx);
+    if (ctx.object < 0) {
+        return hit;
+    }
+
+    const r3d_scene_query_object_t* object = &query->objects[ctx.object];
+
+    hit.hit = true;
+    hit.distance = dist;
+    hit.point = Vector3Add(ray.position, Vector3Scale(ray.direction, dist));
+    hit.normal = Vector3Normalize(ctx.normal);
+    hit.id = object->id;
+    hit.instance = object->instance;
+
+    return hit;
+}
+
+int r3d_scene_query_aabb(r3d_scene_query_t* query, BoundingBox box, R3D_QueryHit* hits, int maxHits)
+{
+    r3d_scene_query_update(query);
+
+    if (hits == NULL || maxHits <= 0 || query->objectCount == 0) {
+        return 0;
+    }
+
+    r3d_scene_query_box_t ctx = {
+        .query = query,
+        .box = box,
+        .hits = hits,
+        .maxHits = maxHits
+    };
+
+    r3d_bvh_query(&query->bvh, box, r3d_scene_query_box_fn, &ctx);
+
+    return ctx.count;
+}
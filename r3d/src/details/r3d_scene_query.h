@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#ifndef R3D_SCENE_QUERY_H
+#define R3D_SCENE_QUERY_H
+
+#include "r3d.h"
+
+#include "./r3d_bvh.h"
+#include <raylib.h>
+#include <stdint.h>
+
+/*
+ * Ray and box queries over the meshes drawn during a frame.
+ *
+ * Every object pushed during the frame is kept with its world transform and bounds. The
+ * hierarchy over these bounds is only updated by the first query following the frame,
+ * refitted if the object count did not change and rebuilt otherwise, or when the refit
+ * made it too loose. The meshes are cached by identity with their local bounds, and with
+ * a hierarchy over their triangles built by the first precise ray reaching them.
+ */
+
+/* === Types === */
+
+typedef struct {
+    uint64_t key;
+    BoundingBox bounds;             //< Local space bounds
+    const float* vertices;
+    const unsigned short* indices;  //< NULL for non-indexed meshes
+    int triangleCount;
+    r3d_bvh_t triangles;            //< Built on the first precise query
+    bool trianglesBuilt;
+} r3d_scene_query_mesh_t;
+
+typedef struct {
+    Matrix transform;
+    int mesh;                       //< Index in the mesh cache
+    int id;
+    int instance;
+} r3d_scene_query_object_t;
+
+typedef struct {
+
+    r3d_scene_query_object_t* objects;
+    BoundingBox* bounds;            //< World space bounds, indexed like the objects
+    int objectCount;
+    int objectCapacity;
+
+    r3d_scene_query_mesh_t* meshes;
+    int meshCount;
+    int meshCapacity;
+
+    int* table;                     //< Open addressing table of mesh indices, -1 for empty slots
+    int tableSize;
+
+    r3d_bvh_t bvh;
+    int builtCount;                 //< Object count of the last build, zero when there is no tree
+    bool dirty;
+
+} r3d_scene_query_t;
+
+/* === Functions === */
+
+// Releases everything, the structure can be reused afterwards
+void r3d_scene_query_destroy(r3d_scene_query_t* query);
+
+// Clears the objects of the previous frame
+void r3d_scene_query_begin(r3d_scene_query_t* query);
+
+// Returns the cache index to push the objects of a mesh with, -1 for meshes without CPU vertices
+int r3d_scene_query_get_mesh(r3d_scene_query_t* query, const Mesh* mesh);
+
+// Adds an object drawn with the given world transform, 'mesh' being an index from 'r3d_scene_query_get_mesh'
+void r3d_scene_query_push(r3d_scene_query_t* query, int mesh, Matrix transform, int id, int instance);
+
+// Marks the hierarchy for update by the next query
+void r3d_scene_query_end(r3d_scene_query_t* query);
+
+// Returns the closest hit, tests the triangles when 'precise' is true
+R3D_RayHit r3d_scene_query_raycast(r3d_scene_query_t* query, Ray ray, float maxDist, bool precise);
+
+// Writes up to 'maxHits' objects overlapping 'box', returns the number written
+int r3d_scene_query_aabb(r3d_scene_query_t* query, BoundingBox box, R3D_QueryHit* hits, int maxHits);
+
+#endif // R3D_SCENE_QUERY_H
@@ -54,14 +54,17 @@ extern const char VS_RASTER_DEPTH_CUBE_INST[];
 extern const char FS_RASTER_DEPTH_CUBE[];
 
 extern const char FS_SCREEN_SSAO[];
+extern const char FS_SCREEN_SSAO_TEMPORAL[];
 extern const char FS_SCREEN_AMBIENT[];
 extern const char FS_SCREEN_LIGHTING[];
 extern const char FS_SCREEN_SCENE[];
 extern const char FS_SCREEN_BLOOM[];
-extern const char FS_SCREEN_FOG[];
-extern const char FS_SCREEN_TONEMAP[];
-extern const char FS_SCREEN_ADJUSTMENT[];
+extern const char FS_SCREEN_POST[];
 extern const char FS_SCREEN_FXAA[];
+extern const char FS_SCREEN_TAA[];
+extern const char FS_SCREEN_OIT[];
+
+extern const char VS_SIMULATE_PARTICLES[];
 
 /* === Uniform types === */
 
@@ -265,6 +268,7 @@ typedef struct {
     r3d_shader_uniform_int_t uHasSkybox;
     r3d_shader_uniform_float_t uAlphaScissorThreshold;
     r3d_shader_uniform_vec3_t uViewPosition;
+    r3d_shader_uniform_int_t uOIT;
 } r3d_shader_raster_forward_t;
 
 typedef struct {
@@ -318,6 +322,7 @@ typedef struct {
     r3d_shader_uniform_int_t uHasSkybox;
     r3d_shader_uniform_float_t uAlphaScissorThreshold;
     r3d_shader_uniform_vec3_t uViewPosition;
+    r3d_shader_uniform_int_t uOIT;
 } r3d_shader_raster_forward_inst_t;
 
 typedef struct {
@@ -335,8 +340,23 @@ typedef struct {
     r3d_shader_uniform_float_t uFar;
     r3d_shader_uniform_float_t uRadius;
     r3d_shader_uniform_float_t uBias;
+    r3d_shader_uniform_int_t uSampleCount;
+    r3d_shader_uniform_int_t uSampleOffset;
+    r3d_shader_uniform_vec2_t uNoiseOffset;
 } r3d_shader_screen_ssao_t;
 
+typedef struct {
+    unsigned int id;
+    r3d_shader_uniform_sampler2D_t uTexSSAO;
+    r3d_shader_uniform_sampler2D_t uTexHistory;
+    r3d_shader_uniform_sampler2D_t uTexDepth;
+    r3d_shader_uniform_mat4_t uMatInvViewProj;
+    r3d_shader_uniform_mat4_t uMatPrevViewProj;
+    r3d_shader_uniform_vec3_t uViewPosition;
+    r3d_shader_uniform_vec3_t uPrevViewPosition;
+    r3d_shader_uniform_float_t uBlend;
+} r3d_shader_screen_ssao_temporal_t;
+
 typedef struct {
     unsigned int id;
     r3d_shader_uniform_sampler2D_t uTexAlbedo;
@@ -380,8 +400,6 @@ typedef struct {
         r3d_shader_uniform_float_t outerCutOff;
         r3d_shader_uniform_float_t shadowMapTxlSz;
         r3d_shader_uniform_float_t shadowBias;
-        r3d_shader_uniform_int_t type;
-        r3d_shader_uniform_int_t shadow;
     } uLight;
     r3d_shader_uniform_sampler2D_t uTexAlbedo;
     r3d_shader_uniform_sampler2D_t uTexNormal;
@@ -415,28 +433,16 @@ typedef struct {
     r3d_shader_uniform_sampler2D_t uTexDepth;
     r3d_shader_uniform_float_t uNear;
     r3d_shader_uniform_float_t uFar;
-    r3d_shader_uniform_int_t uFogMode;
     r3d_shader_uniform_vec3_t uFogColor;
     r3d_shader_uniform_float_t uFogStart;
     r3d_shader_uniform_float_t uFogEnd;
     r3d_shader_uniform_float_t uFogDensity;
-} r3d_shader_screen_fog_t;
-
-typedef struct {
-    unsigned int id;
-    r3d_shader_uniform_sampler2D_t uTexColor;
-    r3d_shader_uniform_int_t uTonemapMode;
     r3d_shader_uniform_float_t uTonemapExposure;
     r3d_shader_uniform_float_t uTonemapWhite;
-} r3d_shader_screen_tonemap_t;
-
-typedef struct {
-    unsigned int id;
-    r3d_shader_uniform_sampler2D_t uTexColor;
     r3d_shader_uniform_float_t uBrightness;
     r3d_shader_uniform_float_t uContrast;
     r3d_shader_uniform_float_t uSaturation;
-} r3d_shader_screen_adjustment_t;
+} r3d_shader_screen_post_t;
 
 typedef struct {
     unsigned int id;
@@ -444,4 +450,51 @@ typedef struct {
     r3d_shader_uniform_vec2_t uTexelSize;
 } r3d_shader_screen_fxaa_t;
 
+typedef struct {
+    unsigned int id;
+    r3d_shader_uniform_sampler2D_t uTexColor;
+    r3d_shader_uniform_sampler2D_t uTexDepth;
+    r3d_shader_uniform_sampler2D_t uTexHistory;
+    r3d_shader_uniform_mat4_t uMatInvViewProj;
+    r3d_shader_uniform_mat4_t uMatPrevViewProj;
+    r3d_shader_uniform_vec2_t uJitter;
+    r3d_shader_uniform_vec2_t uResolution;
+    r3d_shader_uniform_float_t uBlend;
+} r3d_shader_screen_taa_t;
+
+typedef struct {
+    unsigned int id;
+    r3d_shader_uniform_sampler2D_t uTexAccum;
+    r3d_shader_uniform_sampler2D_t uTexWeight;
+} r3d_shader_screen_oit_t;
+
+typedef struct {
+    unsigned int id;
+    r3d_shader_uniform_sampler1D_t uTexCurves;
+    r3d_shader_uniform_int_t uSpeedCurve;
+    r3d_shader_uniform_float_t uDeltaTime;
+    r3d_shader_uniform_float_t uLifetime;
+    r3d_shader_uniform_vec3_t uGravity;
+    r3d_shader_uniform_int_t uSeed;
+    r3d_shader_uniform_int_t uCapacity;
+    r3d_shader_uniform_int_t uEmitStart;
+    r3d_shader_uniform_int_t uEmitCount;
+    r3d_shader_uniform_vec3_t uPosition;
+    r3d_shader_uniform_vec3_t uEmitDirection;
+    r3d_shader_uniform_vec3_t uEmitBinormal;
+    r3d_shader_uniform_vec3_t uEmitNormal;
+    r3d_shader_uniform_float_t uEmitSpeed;
+    r3d_shader_uniform_float_t uSpreadAngle;
+    r3d_shader_uniform_float_t uLifetimeVariance;
+    r3d_shader_uniform_vec3_t uInitialRotation;
+    r3d_shader_uniform_vec3_t uRotationVariance;
+    r3d_shader_uniform_vec3_t uInitialScale;
+    r3d_shader_uniform_float_t uScaleVariance;
+    r3d_shader_uniform_vec3_t uVelocityVariance;
+    r3d_shader_uniform_vec3_t uInitialAngularVelocity;
+    r3d_shader_uniform_vec3_t uAngularVelocityVariance;
+    r3d_shader_uniform_vec4_t uInitialColor;
+    r3d_shader_uniform_vec4_t uColorVariance;
+} r3d_shader_simulate_particles_t;
+
 #endif // R3D_EMBEDDED_SHADERS_H
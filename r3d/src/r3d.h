@@ -66,6 +66,15 @@ typedef unsigned int R3D_Flags;
 #define R3D_FLAG_STENCIL_TEST   (1 << 3)    /*< Performs a stencil test on each rendering pass affecting geometry */
 #define R3D_FLAG_DEPTH_PREPASS  (1 << 4)    /*< Performs a depth pre-pass before forward rendering, improving desktop GPU performance but unnecessary on mobile */
 #define R3D_FLAG_8_BIT_NORMALS  (1 << 5)    /*< Use 8-bit precision for the normals buffer (deferred); default is 16-bit float */
+#define R3D_FLAG_SHADER_CACHE   (1 << 6)    /*< Caches linked shader program binaries on disk to speed up the following launches */
+#define R3D_FLAG_SKYBOX_CACHE   (1 << 7)    /*< Caches the cubemaps generated by 'R3D_LoadSkyboxHDR' on disk to skip their convolution on the following loads */
+#define R3D_FLAG_TAA            (1 << 8)    /*< Enables Temporal Anti-Aliasing (TAA), which also upsamples to the base resolution under dynamic resolution */
+#define R3D_FLAG_PASS_TIMINGS   (1 << 9)    /*< Measures the GPU time of each render pass, reported by 'R3D_GetFrameStats' */
+#define R3D_FLAG_OIT            (1 << 10)   /*< Blends the forward 'R3D_BLEND_ALPHA' draws with weighted blended order-independent transparency instead of sorting them */
+#define R3D_FLAG_SCENE_QUERIES  (1 << 11)   /*< Keeps a BVH of the drawn meshes for 'R3D_Raycast' and 'R3D_QueryAABB' */
+
+#define R3D_FRAME_STATS_MAX_PASSES 32       /*< Maximum number of passes reported by 'R3D_GetFrameStats' */
+#define R3D_MAX_VIEWS 4                     /*< Maximum number of views rendered by 'R3D_BeginViews' */
 
 /**
  * @brief Defines the rendering mode used in the pipeline.
@@ -180,6 +189,45 @@ typedef enum {
     R3D_TONEMAP_AGX       ///< AGX tone mapping, a modern technique designed to preserve both highlight and shadow details for HDR rendering.
 } R3D_Tonemap;
 
+/**
+ * @brief Memory layouts available for the particles of a particle system.
+ */
+typedef enum {
+    R3D_PARTICLE_STORAGE_AOS,   ///< One `R3D_Particle` struct per particle, stored in `R3D_ParticleSystem::particles` (default).
+    R3D_PARTICLE_STORAGE_SOA,   ///< One aligned array per attribute, stored in `R3D_ParticleSystem::arrays` and updated with SIMD kernels.
+    R3D_PARTICLE_STORAGE_GPU    ///< Particle state kept in GPU buffers (see `R3D_ParticleBuffers`) and updated with transform feedback.
+} R3D_ParticleStorage;
+
+/**
+ * @brief Interpolation modes between the keyframes of an interpolation curve.
+ */
+typedef enum {
+    R3D_CURVE_LINEAR,           ///< Straight lines between keyframes (default).
+    R3D_CURVE_HERMITE           ///< Cubic Hermite spline with Catmull-Rom tangents, passing through every keyframe.
+} R3D_CurveInterpolation;
+
+/**
+ * @brief Buffers that can be read back asynchronously with `R3D_RequestReadback`.
+ */
+typedef enum {
+    R3D_READBACK_COLOR,     ///< Final scene color, as returned by `R3D_GetBufferColor`, read as RGB8.
+    R3D_READBACK_DEPTH      ///< Scene depth, as returned by `R3D_GetBufferDepth`, read as 32-bit float.
+} R3D_ReadbackBuffer;
+
+/**
+ * @brief Flags selecting the steps performed by `R3D_OptimizeMesh`.
+ *
+ * Steps can be combined; they are always applied in the order listed below.
+ */
+typedef unsigned int R3D_MeshOptimizeFlags;
+
+#define R3D_MESH_OPTIMIZE_VERTEX_CACHE  (1 << 0)    /*< Reorders triangles to improve post-transform vertex cache hits */
+#define R3D_MESH_OPTIMIZE_OVERDRAW      (1 << 1)    /*< Sorts triangle clusters so outward facing ones are drawn first, reducing overdraw */
+#define R3D_MESH_OPTIMIZE_VERTEX_FETCH  (1 << 2)    /*< Renumbers vertices in order of first use to improve fetch locality */
+#define R3D_MESH_OPTIMIZE_QUANTIZE      (1 << 3)    /*< Stores normals and tangents as normalized bytes and texcoords as half floats on the GPU */
+#define R3D_MESH_OPTIMIZE_QUANTIZE_POSITIONS (1 << 4) /*< With `R3D_MESH_OPTIMIZE_QUANTIZE`, also stores positions as half floats on the GPU */
+#define R3D_MESH_OPTIMIZE_DEFAULT       (R3D_MESH_OPTIMIZE_VERTEX_CACHE | R3D_MESH_OPTIMIZE_OVERDRAW | R3D_MESH_OPTIMIZE_VERTEX_FETCH)
+
 
 
 // --------------------------------------------
@@ -190,6 +238,7 @@ typedef enum {
  * @brief Represents a unique identifier for a light in R3D.
  *
  * This ID is used to reference a specific light when calling R3D lighting functions.
+ * IDs of destroyed lights stay invalid, even when a new light reuses their storage.
  */
 typedef unsigned int R3D_Light;
 
@@ -220,8 +269,25 @@ typedef struct {
     Vector2 frameSize;      ///< The size of a single animation frame, in texture coordinates (width and height).
     int xFrameCount;        ///< The number of frames along the horizontal (X) axis of the texture.
     int yFrameCount;        ///< The number of frames along the vertical (Y) axis of the texture.
+    Rectangle region;       ///< The area of the texture holding the frames, in normalized texture coordinates.
 } R3D_Sprite;
 
+/**
+ * @brief Represents a set of images packed into shared texture pages.
+ *
+ * Packing many small textures into a few pages lets sprites and materials that only differed by
+ * their texture share the same texture bindings, so their draws can be batched together.
+ * Each packed image is surrounded by a border of its own edge texels to avoid bleeding
+ * between neighbours when filtering or sampling the mipmaps.
+ */
+typedef struct {
+    Texture2D* pages;       ///< The atlas page textures.
+    int pageCount;          ///< The number of atlas pages.
+    Rectangle* regions;     ///< The area of each packed image in its page, in pixels, border excluded.
+    int* regionPages;       ///< The page index of each packed image, or -1 if the image could not be packed.
+    int regionCount;        ///< The number of images given when loading the atlas.
+} R3D_TextureAtlas;
+
 /**
  * @brief Represents a keyframe in an interpolation curve.
  *
@@ -244,8 +310,42 @@ typedef struct {
     R3D_Keyframe* keyframes;    ///< Dynamic array of keyframes defining the interpolation curve.
     unsigned int capacity;      ///< Allocated size of the keyframes array.
     unsigned int count;         ///< Current number of keyframes in the array.
+    R3D_CurveInterpolation interpolation;   ///< Interpolation between keyframes, set by `R3D_BakeCurve`. Default: `R3D_CURVE_LINEAR`.
+    float* lut;                 ///< Baked samples of the curve, NULL until `R3D_BakeCurve` is called.
+    int lutSize;                ///< Number of baked samples.
+    float lutStart;             ///< Time of the first baked sample.
+    float lutScale;             ///< Number of baked sample intervals per unit of time.
 } R3D_InterpolationCurve;
 
+/**
+ * @brief Statistics reported by the mesh optimization functions.
+ *
+ * The ACMR (average cache miss ratio) is the number of vertices transformed per triangle,
+ * simulated with a 16 entries FIFO cache. It ranges from about 0.5 (ideal) to 3.0 (no reuse).
+ */
+typedef struct {
+    float acmrBefore;           ///< ACMR of the mesh before optimization.
+    float acmrAfter;            ///< ACMR of the mesh after optimization.
+    int vertexCountBefore;      ///< Number of vertices before optimization.
+    int vertexCountAfter;       ///< Number of vertices after optimization, lower if duplicates were welded.
+    int clusterCount;           ///< Number of triangle clusters used for overdraw sorting.
+} R3D_MeshOptimizeStats;
+
+/**
+ * @brief Statistics about the shader programs compiled by the renderer.
+ *
+ * Some shaders are compiled as variants, one program per combination of features
+ * (fog mode, tonemap mode, light type, shadows...), and only when first needed.
+ */
+typedef struct {
+    int programCount;           ///< Total number of shader programs compiled since initialization.
+    int variantCount;           ///< Number of those programs that are feature variants.
+    float compileTime;          ///< Accumulated compile and link time, in milliseconds.
+    float maxCompileTime;       ///< Slowest single program compile and link time, in milliseconds.
+    int cachedCount;            ///< Number of programs loaded from the binary cache (see R3D_FLAG_SHADER_CACHE).
+    float cacheSavedTime;       ///< Estimated source compile time avoided thanks to the binary cache, in milliseconds.
+} R3D_ShaderStats;
+
 /**
  * @struct R3D_Particle
  * @brief Represents a particle in a 3D particle system, with properties
@@ -272,6 +372,77 @@ typedef struct {
 
 } R3D_Particle;
 
+/**
+ * @brief Particle attributes stored as separate arrays (structure of arrays).
+ *
+ * Used by particle systems loaded with `R3D_PARTICLE_STORAGE_SOA`. Every array holds
+ * `R3D_ParticleSystem::count` valid entries, float arrays are aligned for SIMD loads.
+ * Rotations are in radians, angular velocities in degrees per second.
+ */
+typedef struct {
+
+    float* lifetime;                ///< Remaining lifetime of each particle, in seconds.
+
+    float* positionX;               ///< Position of each particle, X component.
+    float* positionY;               ///< Position of each particle, Y component.
+    float* positionZ;               ///< Position of each particle, Z component.
+
+    float* rotationX;               ///< Rotation of each particle, X component (radians).
+    float* rotationY;               ///< Rotation of each particle, Y component (radians).
+    float* rotationZ;               ///< Rotation of each particle, Z component (radians).
+
+    float* scaleX;                  ///< Scale of each particle, X component.
+    float* scaleY;                  ///< Scale of each particle, Y component.
+    float* scaleZ;                  ///< Scale of each particle, Z component.
+
+    float* velocityX;               ///< Velocity of each particle, X component.
+    float* velocityY;               ///< Velocity of each particle, Y component.
+    float* velocityZ;               ///< Velocity of each particle, Z component.
+
+    float* angularVelocityX;        ///< Angular velocity of each particle, X component.
+    float* angularVelocityY;        ///< Angular velocity of each particle, Y component.
+    float* angularVelocityZ;        ///< Angular velocity of each particle, Z component.
+
+    float* baseScaleX;              ///< Initial scale of each particle, X component.
+    float* baseScaleY;              ///< Initial scale of each particle, Y component.
+    float* baseScaleZ;              ///< Initial scale of each particle, Z component.
+
+    float* baseVelocityX;           ///< Initial velocity of each particle, X component.
+    float* baseVelocityY;           ///< Initial velocity of each particle, Y component.
+    float* baseVelocityZ;           ///< Initial velocity of each particle, Z component.
+
+    float* baseAngularVelocityX;    ///< Initial angular velocity of each particle, X component.
+    float* baseAngularVelocityY;    ///< Initial angular velocity of each particle, Y component.
+    float* baseAngularVelocityZ;    ///< Initial angular velocity of each particle, Z component.
+
+    unsigned char* baseOpacity;     ///< Initial opacity of each particle.
+
+    Color* colors;                  ///< Current color of each particle, used directly as instance colors.
+    Matrix* transforms;             ///< Current transform of each particle, used directly as instance transforms.
+
+    void* memory;                   ///< Single allocation backing all the arrays above.
+
+} R3D_ParticleArrays;
+
+/**
+ * @brief GPU resources of a particle system loaded with `R3D_PARTICLE_STORAGE_GPU`.
+ *
+ * The particle state lives in two vertex buffers used alternately as the input and the output
+ * of the simulation pass. Lifetime curves are baked into a 1D texture, uploaded again only
+ * when one of them changes.
+ */
+typedef struct {
+
+    unsigned int vbo[2];            ///< Particle state buffers, each update reads one and writes the other.
+    unsigned int vao[2];            ///< Vertex arrays reading each state buffer as simulation input.
+    unsigned int curves;            ///< 1D texture with the baked scale, opacity, speed and angular velocity curves.
+    unsigned long long curveHash;   ///< Hash of the curves baked in `curves`.
+    int current;                    ///< Index of the buffer holding the latest state.
+    int emitCursor;                 ///< First slot checked by the next emission.
+    int emitPending;                ///< Particles requested since the last update, spawned by the next one.
+
+} R3D_ParticleBuffers;
+
 /**
  * @brief Represents a CPU-based particle system with various properties and settings.
  *
@@ -280,9 +451,12 @@ typedef struct {
  */
 typedef struct {
 
-    R3D_Particle* particles;            ///< Pointer to the array of particles in the system.
+    R3D_Particle* particles;            ///< Pointer to the array of particles in the system, NULL with `R3D_PARTICLE_STORAGE_SOA`.
+    R3D_ParticleArrays arrays;          ///< Particle attributes with `R3D_PARTICLE_STORAGE_SOA`, zeroed otherwise.
+    R3D_ParticleBuffers buffers;        ///< GPU resources with `R3D_PARTICLE_STORAGE_GPU`, zeroed otherwise.
+    R3D_ParticleStorage storage;        ///< The memory layout of the particles, fixed at load time.
     int capacity;                       ///< The maximum number of particles the system can manage.
-    int count;                          ///< The current number of active particles in the system.
+    int count;                          ///< The current number of active particles in the system, always 0 with `R3D_PARTICLE_STORAGE_GPU`.
 
     Vector3 position;                   ///< The initial position of the particle system. Default: (0, 0, 0).
     Vector3 gravity;                    ///< The gravity applied to the particles. Default: (0, -9.81, 0).
@@ -318,8 +492,120 @@ typedef struct {
                                       *   If false, emission is manual using `R3D_EmitParticle`. Default: true.
                                       */
 
+    bool trackBounds;                   ///< Compute `bounds` from the live particles during each update. Default: false.
+    BoundingBox bounds;                 ///< Exact bounds of the particle positions after the last update, only maintained with `trackBounds`.
+
+    unsigned long long rngState;        ///< State of the system's random generator, set with `R3D_SetParticleSystemSeed`. Should not be modified manually.
+
 } R3D_ParticleSystem;
 
+/**
+ * @brief Memory usage of the frame arena, returned by `R3D_GetFrameMemoryStats`.
+ *
+ * The frame arena backs the draw call lists, the light batch and the blocks returned by
+ * `R3D_FrameAlloc`. It is reset at each `R3D_Begin` and grows to fit the largest frame,
+ * after which frames of a similar size no longer allocate from the heap.
+ */
+typedef struct {
+
+    unsigned int used;              ///< Bytes allocated since the last `R3D_Begin`.
+    unsigned int lastFrameUsed;     ///< Bytes allocated between the two last calls to `R3D_Begin`.
+    unsigned int highWater;         ///< Largest number of bytes allocated during a single frame.
+    unsigned int capacity;          ///< Bytes currently reserved by the arena.
+    unsigned int heapAllocations;   ///< Number of heap allocations made by the arena since `R3D_Init`.
+
+} R3D_FrameMemoryStats;
+
+/**
+ * @brief Pass and render target statistics of the render graph, returned by `R3D_GetRenderGraphStats`.
+ *
+ * `R3D_End` runs its passes through a render graph: passes that are disabled, or whose outputs are
+ * not read by any later pass, are skipped. Transient targets whose lifetimes do not overlap, such as
+ * the deferred lighting targets and the post-processing ping-pong, share the same storage.
+ */
+typedef struct {
+
+    int passCount;                  ///< Number of passes declared for the last frame.
+    int culledPassCount;            ///< Number of passes skipped during the last frame.
+    unsigned int targetMemory;      ///< Bytes of render targets currently allocated.
+    unsigned int usedTargetMemory;  ///< Bytes of render targets used by the passes of the last frame.
+    unsigned int aliasedMemory;     ///< Bytes saved by transient targets sharing their storage.
+
+} R3D_RenderGraphStats;
+
+/**
+ * @brief A camera and the area of the destination it renders to, used by `R3D_BeginViews`.
+ *
+ * The viewport is given in pixels of the screen or of the custom render target, with the
+ * origin at the top-left corner. A viewport with a zero width or height covers the whole destination.
+ *
+ * The resolution scale lowers the internal resolution of the view, e.g. 0.25 for a minimap
+ * covering a quarter of the screen width. Zero or values above 1 render at the full resolution.
+ */
+typedef struct {
+
+    Camera3D camera;                ///< Camera of the view.
+    Rectangle viewport;             ///< Destination area of the view, in pixels.
+    float resolutionScale;          ///< Scale of the internal resolution for this view, in (0, 1]; zero for the full resolution.
+
+} R3D_View;
+
+/**
+ * @brief Timings of a single render pass, part of `R3D_FrameStats`.
+ */
+typedef struct {
+
+    const char* name;               ///< Name of the pass, e.g. "geometry" or "bloom".
+    bool executed;                  ///< False if the pass was skipped by the render graph.
+    float cpuTime;                  ///< Milliseconds spent submitting the pass on the CPU.
+    float gpuTime;                  ///< Milliseconds spent by the GPU on the pass, only measured with `R3D_FLAG_PASS_TIMINGS`.
+
+} R3D_PassStats;
+
+/**
+ * @brief Rendering statistics of the last frame, returned by `R3D_GetFrameStats`.
+ *
+ * The counters describe the last frame rendered. GPU times are read back without stalling
+ * the pipeline, so they describe a frame rendered a few frames earlier.
+ */
+typedef struct {
+
+    int drawCalls;                  ///< Mesh and sprite draws issued, shadow maps included.
+    int instances;                  ///< Instances drawn, one per non-instanced draw.
+    int triangles;                  ///< Triangles submitted, shadow maps included.
+    int lights;                     ///< Lights found visible by the culling, summed over the views.
+    float cpuTime;                  ///< Milliseconds between `R3D_Begin` and the end of `R3D_End`.
+    float gpuTime;                  ///< Milliseconds spent by the GPU on `R3D_End`.
+    int passCount;                  ///< Number of valid entries in `passes`.
+    R3D_PassStats passes[R3D_FRAME_STATS_MAX_PASSES]; ///< Passes in execution order.
+
+} R3D_FrameStats;
+
+/**
+ * @brief Closest object hit by `R3D_Raycast`.
+ */
+typedef struct {
+
+    bool hit;                       ///< False if nothing was hit, the other fields are then undefined.
+    float distance;                 ///< Distance from the ray origin to the hit point.
+    Vector3 point;                  ///< World space hit point.
+    Vector3 normal;                 ///< World space normal of the hit triangle, or of the bounding box face.
+    int id;                         ///< Query id applied with `R3D_ApplyQueryId` when the object was drawn.
+    int instance;                   ///< Index of the hit instance for instanced draws, 0 otherwise.
+
+} R3D_RayHit;
+
+/**
+ * @brief Object overlapping the box given to `R3D_QueryAABB`.
+ */
+typedef struct {
+
+    int id;                         ///< Query id applied with `R3D_ApplyQueryId` when the object was drawn.
+    int instance;                   ///< Index of the instance for instanced draws, 0 otherwise.
+    BoundingBox bounds;             ///< World space bounds of the object.
+
+} R3D_QueryHit;
+
 
 /* === Extern C guard === */
 
@@ -404,6 +690,41 @@ R3DAPI void R3D_GetResolution(int* width, int* height);
  */
 R3DAPI void R3D_UpdateResolution(int width, int height);
 
+/**
+ * @brief Enables dynamic resolution scaling.
+ * 
+ * Once enabled, R3D measures the GPU time of each `R3D_End` and the CPU time spent
+ * between `R3D_Begin` and `R3D_End`, and scales the internal resolution so that the
+ * slowest of the two stays close to the target. The scale moves in steps of 5% of
+ * the resolution given to `R3D_UpdateResolution`, and waits a few frames after each
+ * change so that the framebuffers are not reallocated continuously.
+ * 
+ * @param targetFrameTime The frame time to aim for, in milliseconds.
+ * @param minScale The minimum scale factor applied to the resolution (e.g. 0.5).
+ * @param maxScale The maximum scale factor applied to the resolution (usually 1.0).
+ * 
+ * @note With `R3D_FLAG_TAA`, the scene is upsampled by the temporal resolve and
+ *       post-processing runs at the base resolution, which keeps most of the detail
+ *       at low scales. Otherwise, `R3D_FLAG_BLIT_LINEAR` is recommended to smooth the upscaling.
+ * @note Giving the same value as minimum and maximum scale renders at a fixed scale.
+ * @note GPU timings are read back a few frames late to avoid stalling the pipeline.
+ */
+R3DAPI void R3D_EnableDynamicResolution(float targetFrameTime, float minScale, float maxScale);
+
+/**
+ * @brief Disables dynamic resolution scaling.
+ * 
+ * Restores the internal resolution last given to `R3D_UpdateResolution`.
+ */
+R3DAPI void R3D_DisableDynamicResolution(void);
+
+/**
+ * @brief Gets the current dynamic resolution scale.
+ * 
+ * @return The scale factor currently applied to the internal resolution, 1.0 when disabled.
+ */
+R3DAPI float R3D_GetResolutionScale(void);
+
 /**
  * @brief Sets a custom render target.
  * 
@@ -425,6 +746,17 @@ R3DAPI void R3D_SetRenderTarget(RenderTexture* target);
  */
 R3DAPI void R3D_SetSceneBounds(BoundingBox sceneBounds);
 
+/**
+ * @brief Retrieves statistics about shader compilation.
+ *
+ * Shader variants are compiled lazily, the first time a feature combination is used,
+ * so these values can grow during execution. A growing count after the first frames
+ * points to compilation hitches.
+ *
+ * @return The current shader compilation statistics.
+ */
+R3DAPI R3D_ShaderStats R3D_GetShaderStats(void);
+
 
 
 // --------------------------------------------
@@ -490,6 +822,17 @@ R3DAPI void R3D_ApplyBillboardMode(R3D_BillboardMode mode);
  */
 R3DAPI void R3D_ApplyAlphaScissorThreshold(float threshold);
 
+/**
+ * @brief Sets the id reported by the scene queries for the following draws.
+ *
+ * The id is returned by `R3D_Raycast` and `R3D_QueryAABB` to tell which object was found.
+ * Draws made with a negative id are ignored by the queries, which is useful for effects
+ * or particles. The default id is 0.
+ *
+ * @param id The query id to apply.
+ */
+R3DAPI void R3D_ApplyQueryId(int id);
+
 
 // --------------------------------------------
 // CORE: Drawing Functions
@@ -505,6 +848,35 @@ R3DAPI void R3D_ApplyAlphaScissorThreshold(float threshold);
  */
 R3DAPI void R3D_Begin(Camera3D camera);
 
+/**
+ * @brief Begins a rendering session drawn from several cameras.
+ *
+ * The draw calls made until `R3D_End` are rendered once per view, each view being blitted
+ * to its own viewport; this suits split screens, minimaps or picture-in-picture. The work
+ * that does not depend on the camera is shared: shadow maps are rendered once for the lights
+ * visible from any view, and instance data is uploaded once. Light culling and draw call
+ * sorting are done per view.
+ *
+ * Every view runs the whole pipeline, from the G-buffer to post-processing, and the views are
+ * blitted in order, so later ones are drawn over earlier ones. At the full internal resolution,
+ * each view costs about as much GPU time as a frame with a single view. A view covering a small
+ * part of the destination should set `resolutionScale`: its passes then run on targets of its own,
+ * whose pixel count and cost follow the square of the scale. `R3D_Begin(camera)` is the same as a
+ * single view covering the whole destination.
+ *
+ * @note The frustum tests, such as `R3D_IsBoundingBoxInFrustum`, pass if any view sees the
+ * object. The first view is the reference for the rest: the front-facing billboards of
+ * non-instanced draws, the frame capture and the temporal effects (TAA and temporal SSAO)
+ * use it, the other views being resolved without history. The first view always renders at
+ * the full internal resolution, its `resolutionScale` is ignored.
+ * @note Each view with a resolution scale keeps its own render targets, reallocated when
+ * its scale or the internal resolution changes.
+ *
+ * @param views Array of views, the first one being the main view.
+ * @param count Number of views, at most `R3D_MAX_VIEWS`.
+ */
+R3DAPI void R3D_BeginViews(const R3D_View* views, int count);
+
 /**
  * @brief Ends the current rendering session.
  * 
@@ -514,6 +886,48 @@ R3DAPI void R3D_Begin(Camera3D camera);
  */
 R3DAPI void R3D_End(void);
 
+/**
+ * @brief Allocates memory that lives until the next call to `R3D_Begin`.
+ *
+ * The memory comes from the frame arena and must not be freed. It is meant for data
+ * that has to stay alive until `R3D_End`, such as the instance transforms and colors
+ * given to `R3D_DrawMeshInstanced` and its variants. Allocate it after `R3D_Begin`,
+ * the blocks allocated before are released by it.
+ *
+ * @param size The number of bytes to allocate.
+ * @return A pointer aligned on 16 bytes, or NULL on failure.
+ */
+R3DAPI void* R3D_FrameAlloc(unsigned int size);
+
+/**
+ * @brief Returns the memory usage of the frame arena.
+ *
+ * @return The current usage and the high water mark of the frame arena.
+ */
+R3DAPI R3D_FrameMemoryStats R3D_GetFrameMemoryStats(void);
+
+/**
+ * @brief Returns the pass and render target memory statistics of the last frame.
+ *
+ * The memory depends on the configuration: the SSAO and bloom targets only exist while these
+ * effects are enabled. Before the first frame, the statistics describe every pass enabled.
+ *
+ * @return The statistics of the render graph.
+ */
+R3DAPI R3D_RenderGraphStats R3D_GetRenderGraphStats(void);
+
+/**
+ * @brief Returns the draw counters and timings of the last frame.
+ *
+ * The CPU time of each pass is always measured. Its GPU time needs `R3D_FLAG_PASS_TIMINGS`,
+ * which adds two timestamp queries per pass; the GPU time of the whole frame is always measured.
+ * With several views, the CPU time of a pass is summed over the views and its GPU time covers
+ * the first view it ran for.
+ *
+ * @return The statistics of the last frame.
+ */
+R3DAPI R3D_FrameStats R3D_GetFrameStats(void);
+
 /**
  * @brief Draws a mesh with a specified material and transformation.
  * 
@@ -606,6 +1020,11 @@ R3DAPI void R3D_DrawModelEx(Model model, Vector3 position, Vector3 rotationAxis,
  * This function renders a sprite in 3D space at the given position.
  * It supports negative scaling to flip the sprite.
  *
+ * Sprites are not drawn one by one: all the sprites of a frame sharing the same material
+ * and render states (billboard, shadow cast, render and blend modes) are rendered with a
+ * single instanced draw call in `R3D_End`, billboarding being applied on the GPU.
+ * Alpha blended sprites are sorted back to front within their batch only.
+ *
  * @param sprite The sprite to render.
  * @param position The position to place the sprite at.
  */
@@ -1185,6 +1604,29 @@ R3DAPI void R3D_DrawLightShape(R3D_Light id);
  */
 R3DAPI R3D_ParticleSystem R3D_LoadParticleSystem(int maxParticles);
 
+/**
+ * @brief Loads a particle emitter system with a specific memory layout.
+ *
+ * `R3D_PARTICLE_STORAGE_AOS` behaves like `R3D_LoadParticleSystem`.
+ *
+ * `R3D_PARTICLE_STORAGE_SOA` keeps each particle attribute in its own aligned array
+ * (see `R3D_ParticleArrays`). Updates then run on SIMD kernels (SSE2 or AVX2, depending
+ * on the compiler target) and write instance transforms and colors directly into the
+ * arrays used by `R3D_DrawParticleSystemEx`. This layout is intended for very large systems.
+ *
+ * `R3D_PARTICLE_STORAGE_GPU` keeps the particles in GPU buffers and simulates them with
+ * transform feedback, the CPU only sets a few uniforms per update and nothing is read back.
+ * Emitted particles are spawned by the next update, in free slots of a ring over the buffer,
+ * so a burst larger than the free slots at the cursor is partly dropped. `count` is not known
+ * on the CPU, `R3D_DrawParticleSystemEx` draws the whole capacity with dead particles collapsed,
+ * and `trackBounds` falls back to `R3D_GetParticleSystemBoundingBox`. Must be called after `R3D_Init`.
+ *
+ * @param maxParticles The maximum number of particles the system can handle at once.
+ * @param storage The memory layout used to store the particles.
+ * @return A newly initialized `R3D_ParticleSystem` structure.
+ */
+R3DAPI R3D_ParticleSystem R3D_LoadParticleSystemEx(int maxParticles, R3D_ParticleStorage storage);
+
 /**
  * @brief Unloads the particle emitter system and frees allocated memory.
  *
@@ -1206,6 +1648,30 @@ R3DAPI void R3D_UnloadParticleSystem(R3D_ParticleSystem* system);
  */
 R3DAPI bool R3D_EmitParticle(R3D_ParticleSystem* system);
 
+/**
+ * @brief Emits several particles in the particle system at once.
+ *
+ * Equivalent to calling `R3D_EmitParticle` `count` times, but the emission cone is set up once and the
+ * random values are generated in batches, which makes large bursts much cheaper.
+ *
+ * @param system A pointer to the `R3D_ParticleSystem` where the particles will be emitted.
+ * @param count The number of particles to emit.
+ * @return The number of particles actually emitted, lower than `count` when the system reaches its capacity.
+ */
+R3DAPI int R3D_EmitParticles(R3D_ParticleSystem* system, int count);
+
+/**
+ * @brief Sets the seed of the random generator owned by the particle system.
+ *
+ * Each particle system has its own generator used for emission, independent from raylib's global one.
+ * Two systems with the same settings and seed emit the exact same particles, which makes replays deterministic.
+ * By default, the seed is taken from raylib's generator when the system is loaded.
+ *
+ * @param system A pointer to the `R3D_ParticleSystem` to be seeded.
+ * @param seed The new seed.
+ */
+R3DAPI void R3D_SetParticleSystemSeed(R3D_ParticleSystem* system, unsigned int seed);
+
 /**
  * @brief Updates the particle emitter system by advancing particle positions.
  *
@@ -1217,13 +1683,48 @@ R3DAPI bool R3D_EmitParticle(R3D_ParticleSystem* system);
  */
 R3DAPI void R3D_UpdateParticleSystem(R3D_ParticleSystem* system, float deltaTime);
 
+/**
+ * @brief Updates several particle emitter systems at once.
+ *
+ * Equivalent to calling `R3D_UpdateParticleSystem` on each system, but all systems are split
+ * into chunks that are updated together on the particle worker threads (see `R3D_SetParticleThreadCount`).
+ * Emission still happens on the calling thread. The systems must be distinct.
+ *
+ * @param systems An array of pointers to the systems to be updated.
+ * @param count The number of systems in the array.
+ * @param deltaTime The time elapsed since the last update (in seconds).
+ */
+R3DAPI void R3D_UpdateParticleSystems(R3D_ParticleSystem** systems, int count, float deltaTime);
+
+/**
+ * @brief Sets the number of threads used to update particle systems.
+ *
+ * The calling thread takes part in the updates, so a count of 1 (the default) disables worker threads
+ * and 0 uses every hardware thread. Particles are processed in fixed size chunks, the simulation
+ * result does not depend on the thread count. The same threads split the screen space culling of
+ * the lights in `R3D_End` once a scene has more than a thousand of them.
+ * The worker threads are stopped by `R3D_Close`.
+ *
+ * @param count The number of threads, including the calling one.
+ */
+R3DAPI void R3D_SetParticleThreadCount(int count);
+
+/**
+ * @brief Gets the number of threads used to update particle systems.
+ *
+ * @return The number of threads, including the calling one.
+ */
+R3DAPI int R3D_GetParticleThreadCount(void);
+
 /**
  * @brief Computes and returns the AABB (Axis-Aligned Bounding Box) of the particle emitter system.
  *
- * This function performs a simulation of the particle system to estimate the AABB of the particles. It calculates the
- * possible positions of each particle at both half of their lifetime and at the end of their lifetime. The resulting
- * AABB approximates the region of space the particle system occupies, which helps in determining if the system should
- * be rendered or not based on camera frustum culling.
+ * The bounds are computed in closed form from the emitter parameters (spread cone, velocity and lifetime
+ * variances, gravity and speed curve), without emitting or touching any particle, so calling it every frame
+ * is cheap. They conservatively contain every position a particle emitted from the current system position
+ * can reach, for update steps up to 0.1 second. Particle meshes extend beyond these positions.
+ *
+ * When the system moves, or to get tight bounds of the live particles, enable `trackBounds` and use `bounds`.
  *
  * @param system A pointer to the `R3D_ParticleSystem` whose AABB is to be computed.
  * @return The computed `BoundingBox` of the particle system.
@@ -1294,6 +1795,82 @@ R3DAPI void R3D_UpdateSprite(R3D_Sprite* sprite, float speed);
 R3DAPI void R3D_UpdateSpriteEx(R3D_Sprite* sprite, int firstFrame, int lastFrame, float speed);
 
 
+/**
+ * @brief Pack images into a texture atlas.
+ *
+ * The images are packed with a skyline allocator, tallest first, into square pages of `pageSize` pixels.
+ * New pages are created as long as the images do not fit in the existing ones. Each image is surrounded
+ * by `padding` pixels replicating its edge texels, so that bilinear filtering and the first mip levels
+ * do not pick texels of the neighbouring images. The pages are uploaded as RGBA8 with mipmaps.
+ *
+ * @note A padding of 2^n pixels keeps the regions free of bleeding down to the mip level n.
+ * @note The images are not modified and can be unloaded after the call.
+ *
+ * @param images Array of images to pack.
+ * @param count Number of images in the array.
+ * @param pageSize Width and height of the atlas pages, in pixels.
+ * @param padding Number of border pixels around each image.
+ *
+ * @return The texture atlas. Images larger than a page are reported and left out.
+ */
+R3DAPI R3D_TextureAtlas R3D_LoadTextureAtlas(const Image* images, int count, int pageSize, int padding);
+
+/**
+ * @brief Unload a texture atlas and its pages.
+ *
+ * @warning Sprites and materials still referencing the atlas pages must not be used afterwards.
+ *
+ * @param atlas The texture atlas to unload.
+ */
+R3DAPI void R3D_UnloadTextureAtlas(R3D_TextureAtlas atlas);
+
+/**
+ * @brief Get the page and texture coordinates transform of an image packed in an atlas.
+ *
+ * Texture coordinates in [0, 1] of the original image map to `uvOffset + uv * uvScale` in the page.
+ *
+ * @param atlas The texture atlas.
+ * @param index The index of the image, in the array given to `R3D_LoadTextureAtlas`.
+ * @param page Output for the page texture holding the image (can be NULL).
+ * @param uvOffset Output for the texture coordinates offset (can be NULL).
+ * @param uvScale Output for the texture coordinates scale (can be NULL).
+ *
+ * @return False if the image is not part of the atlas.
+ */
+R3DAPI bool R3D_GetTextureAtlasRegion(const R3D_TextureAtlas* atlas, int index, Texture2D* page, Vector2* uvOffset, Vector2* uvScale);
+
+/**
+ * @brief Load a sprite from an image packed in a texture atlas.
+ *
+ * The sprite uses the atlas page as albedo and restricts its frames to the region of the image.
+ * Sprites loaded from the same page with otherwise identical materials are drawn in a single batch.
+ *
+ * @warning The sprite does not own the atlas page, unload the atlas only once its sprites are no longer drawn.
+ *
+ * @param atlas The texture atlas.
+ * @param index The index of the spritesheet image, in the array given to `R3D_LoadTextureAtlas`.
+ * @param xFrameCount The number of frames in the horizontal direction.
+ * @param yFrameCount The number of frames in the vertical direction.
+ *
+ * @return The sprite, or a zeroed sprite if the image is not part of the atlas.
+ */
+R3DAPI R3D_Sprite R3D_LoadSpriteFromAtlas(const R3D_TextureAtlas* atlas, int index, int xFrameCount, int yFrameCount);
+
+/**
+ * @brief Rewrite the texture coordinates of a mesh to sample an image packed in an atlas.
+ *
+ * The texture coordinates are transformed on the CPU and re-uploaded if the mesh is already on the GPU.
+ * The material of the mesh must then use the atlas page in place of the original texture.
+ *
+ * @warning Texture coordinates outside [0, 1], relying on texture wrapping, cannot be remapped to an atlas region.
+ *
+ * @param mesh The mesh to remap.
+ * @param atlas The texture atlas.
+ * @param index The index of the image, in the array given to `R3D_LoadTextureAtlas`.
+ */
+R3DAPI void R3D_RemapMeshToAtlas(Mesh* mesh, const R3D_TextureAtlas* atlas, int index);
+
+
 
 // --------------------------------------------
 // CURVES: Interpolation Curves Functions
@@ -1348,6 +1925,85 @@ R3DAPI bool R3D_AddKeyframe(R3D_InterpolationCurve* curve, float time, float val
  */
 R3DAPI float R3D_EvaluateCurve(R3D_InterpolationCurve curve, float time);
 
+/**
+ * @brief Bakes the interpolation curve into a lookup table for constant time evaluation.
+ *
+ * The curve is sampled `resolution` times between its first and last keyframes with the given interpolation mode.
+ * Afterwards, `R3D_EvaluateCurve` reads the table instead of searching the keyframes, so its cost no longer depends
+ * on the keyframe count. Adding a keyframe bakes the table again with the same settings.
+ * The table is released by `R3D_UnloadInterpolationCurve`.
+ *
+ * @param curve A pointer to the interpolation curve to be baked.
+ * @param resolution The number of samples in the table, at least 2. 256 is plenty for particle curves.
+ * @param interpolation The interpolation used between keyframes.
+ */
+R3DAPI void R3D_BakeCurve(R3D_InterpolationCurve* curve, int resolution, R3D_CurveInterpolation interpolation);
+
+/**
+ * @brief Evaluates the interpolation curve at several times at once.
+ *
+ * Gives the same results as calling `R3D_EvaluateCurve` for each time. With a baked curve, the loop has
+ * no branches and is written to be vectorized by the compiler.
+ *
+ * @param curve The interpolation curve to be evaluated.
+ * @param times The times at which to evaluate the curve.
+ * @param results The output values, one per time. Must not overlap `times`.
+ * @param count The number of times to evaluate.
+ */
+R3DAPI void R3D_EvaluateCurveBatch(R3D_InterpolationCurve curve, const float* times, float* results, int count);
+
+
+
+// --------------------------------------------
+// MESH: Mesh Optimization Functions
+// --------------------------------------------
+
+/**
+ * @brief Optimizes the index and vertex order of a mesh.
+ *
+ * This function reorders triangles for the post-transform vertex cache (Tipsify), sorts the resulting
+ * triangle clusters to reduce overdraw, and renumbers vertices in order of first use. Non-indexed meshes,
+ * such as those loaded from OBJ files, are indexed first by welding identical vertices.
+ *
+ * The CPU-side data of the mesh is rewritten, so the result can be baked with `ExportMesh`.
+ * If the mesh was already uploaded, its GPU buffers are recreated.
+ *
+ * @note Meshes whose unique vertex count exceeds the 16-bit index range are left untouched.
+ * @note Quantization only affects GPU buffers and is skipped for animated meshes.
+ * @note Positions are only quantized with `R3D_MESH_OPTIMIZE_QUANTIZE_POSITIONS`, since the error of
+ *       a half float grows with the distance to the mesh origin. They are left as floats, with a
+ *       warning, for meshes lying more than twice their size away from their origin.
+ *
+ * @param mesh A pointer to the mesh to optimize. Its CPU data must still be available.
+ * @param flags A combination of `R3D_MESH_OPTIMIZE_*` flags.
+ * @param stats Optional pointer receiving the optimization statistics, can be NULL.
+ * @return `true` if the mesh was optimized, `false` otherwise.
+ */
+R3DAPI bool R3D_OptimizeMesh(Mesh* mesh, R3D_MeshOptimizeFlags flags, R3D_MeshOptimizeStats* stats);
+
+/**
+ * @brief Optimizes all the meshes of a model.
+ *
+ * Calls `R3D_OptimizeMesh` on each mesh and logs the overall ACMR before and after.
+ * The reported ACMR values are weighted by the triangle count of each mesh.
+ *
+ * @param model A pointer to the model to optimize.
+ * @param flags A combination of `R3D_MESH_OPTIMIZE_*` flags.
+ * @param stats Optional pointer receiving the accumulated statistics, can be NULL.
+ */
+R3DAPI void R3D_OptimizeModel(Model* model, R3D_MeshOptimizeFlags flags, R3D_MeshOptimizeStats* stats);
+
+/**
+ * @brief Computes the average cache miss ratio of a mesh.
+ *
+ * Simulates a FIFO post-transform cache of the given size over the index buffer of the mesh.
+ *
+ * @param mesh The mesh to evaluate.
+ * @param cacheSize The number of entries of the simulated cache.
+ * @return The number of vertices transformed per triangle.
+ */
+R3DAPI float R3D_GetMeshACMR(Mesh mesh, int cacheSize);
+
 
 
 // --------------------------------------------
@@ -1428,6 +2084,8 @@ R3DAPI Vector3 R3D_GetSkyboxRotation(void);
  * of the scene by simulating ambient occlusion, darkening areas where objects
  * are close together or in corners.
  *
+ * @note Disabling SSAO releases its render targets, they are recreated when it is enabled again.
+ *
  * @param enabled Whether to enable or disable SSAO.
  */
 R3DAPI void R3D_SetSSAO(bool enabled);
@@ -1502,6 +2160,29 @@ R3DAPI void R3D_SetSSAOIterations(int value);
  */
 R3DAPI int R3D_GetSSAOIterations(void);
 
+/**
+ * @brief Enables or disables temporal accumulation of SSAO.
+ *
+ * In temporal mode, each frame evaluates a quarter of the SSAO kernel with a rotated
+ * noise pattern, then blends the result with the previous frames, reprojected with
+ * the camera motion. Occlusion from surfaces that were hidden in the previous frames
+ * is detected with their view distance and starts over. Half of the blur iterations
+ * set with `R3D_SetSSAOIterations` are used, as the accumulation already removes
+ * most of the noise.
+ *
+ * @note Moving objects may leave a short trail of occlusion behind them.
+ *
+ * @param enabled Whether to enable or disable temporal SSAO.
+ */
+R3DAPI void R3D_SetSSAOTemporal(bool enabled);
+
+/**
+ * @brief Gets the current state of temporal SSAO.
+ *
+ * @return True if temporal SSAO is enabled, false otherwise.
+ */
+R3DAPI bool R3D_GetSSAOTemporal(void);
+
 
 
 // --------------------------------------------
@@ -1514,6 +2195,8 @@ R3DAPI int R3D_GetSSAOIterations(void);
  * This function configures the bloom effect mode, which determines how the bloom
  * effect is applied to the rendered scene.
  *
+ * @note Disabling bloom releases its mip chain, it is recreated when bloom is enabled again.
+ *
  * @param mode The bloom mode to set.
  */
 R3DAPI void R3D_SetBloomMode(R3D_Bloom mode);
@@ -1819,6 +2502,9 @@ R3DAPI R3D_Skybox R3D_LoadSkybox(const char* fileName, CubemapLayout layout);
  * This function loads a skybox from an HDR image and converts it into a cubemap.
  * The size parameter determines the resolution of the generated cubemap.
  *
+ * With `R3D_FLAG_SKYBOX_CACHE`, the generated cubemap, irradiance and prefilter maps
+ * are written to disk and reused by later loads of the same file at the same size.
+ *
  * @param fileName The path to the HDR image file.
  * @param size The resolution of the cubemap (e.g., 512, 1024).
  * @return The loaded skybox object.
@@ -1892,6 +2578,45 @@ R3DAPI bool R3D_IsBoundingBoxInFrustum(BoundingBox aabb);
 
 
 
+// --------------------------------------------
+// CULLING: Scene Query Functions
+// --------------------------------------------
+
+/**
+ * @brief Casts a ray against the meshes drawn during the last frame.
+ *
+ * With `R3D_FLAG_SCENE_QUERIES`, `R3D_End` gathers the world bounds of every mesh drawn
+ * during the frame into a bounding volume hierarchy, refitted while the objects keep the same
+ * draw order and rebuilt when it changes or degrades. Sprites and particle systems stored
+ * on the GPU are not included.
+ *
+ * When `precise` is true, the candidates are tested against their triangles through a BVH
+ * cached per mesh, built the first time the mesh is queried. Meshes without CPU side indices
+ * or vertices fall back to their bounds. Otherwise only the bounding boxes are tested.
+ *
+ * @param ray The ray to cast, its direction does not need to be normalized.
+ * @param maxDistance Maximum distance of the hit from the ray origin.
+ * @param precise Tests the triangles of the meshes instead of their bounding boxes.
+ * @return The closest hit, with `hit` set to false if nothing was hit.
+ *
+ * @note Meshes must stay loaded, and their vertex data unchanged, until they are queried.
+ */
+R3DAPI R3D_RayHit R3D_Raycast(Ray ray, float maxDistance, bool precise);
+
+/**
+ * @brief Finds the meshes drawn during the last frame whose bounds overlap a box.
+ *
+ * Uses the hierarchy described in `R3D_Raycast`, which needs `R3D_FLAG_SCENE_QUERIES`.
+ *
+ * @param aabb The world space box to test.
+ * @param hits Array receiving the overlapping objects, in no particular order.
+ * @param maxHits Capacity of the `hits` array.
+ * @return The number of objects written to `hits`.
+ */
+R3DAPI int R3D_QueryAABB(BoundingBox aabb, R3D_QueryHit* hits, int maxHits);
+
+
+
 // --------------------------------------------
 // UTILS: Material Configuration Functions
 // --------------------------------------------
@@ -2035,6 +2760,76 @@ R3DAPI Texture2D R3D_GetBufferDepth(void);
 
 
 
+// --------------------------------------------
+// UTILS: Asynchronous Readback Functions
+// --------------------------------------------
+
+/**
+ * @brief Queues an asynchronous copy of an R3D buffer to the CPU.
+ *
+ * The copy is made into a pixel buffer object and guarded by a fence, so this call does not stall
+ * the pipeline like a direct read would. The result is usually available two or three frames later
+ * and is retrieved with `R3D_GetReadbackImage`. Call it after `R3D_End` to read the last frame.
+ *
+ * @note At most four requests can be pending at the same time.
+ *
+ * @param buffer The buffer to read back.
+ *
+ * @return A request identifier, or 0 if too many requests are pending.
+ */
+R3DAPI unsigned int R3D_RequestReadback(R3D_ReadbackBuffer buffer);
+
+/**
+ * @brief Checks whether the GPU has finished a readback, without blocking.
+ *
+ * @param request The identifier returned by `R3D_RequestReadback`.
+ *
+ * @return True if `R3D_GetReadbackImage` can retrieve the result without waiting.
+ */
+R3DAPI bool R3D_IsReadbackReady(unsigned int request);
+
+/**
+ * @brief Retrieves the result of a readback.
+ *
+ * On success the request is released and `image` receives a new image, with its rows from top to bottom,
+ * in `PIXELFORMAT_UNCOMPRESSED_R8G8B8` for color or `PIXELFORMAT_UNCOMPRESSED_R32` for depth.
+ * The image must be unloaded with `UnloadImage`.
+ *
+ * @param request The identifier returned by `R3D_RequestReadback`.
+ * @param image Output image.
+ * @param wait If true, blocks until the result is available instead of returning false.
+ *
+ * @return True if the image was retrieved, false if the readback is still pending or the request is unknown.
+ */
+R3DAPI bool R3D_GetReadbackImage(unsigned int request, Image* image, bool wait);
+
+/**
+ * @brief Starts streaming the rendered frames to a Y4M video file.
+ *
+ * At each `R3D_End`, the final scene color is read back asynchronously then converted and written to
+ * `fileName` by a background thread, as uncompressed YUV 4:4:4 at the output resolution.
+ * The render thread only waits if the GPU or the disk fall several frames behind.
+ *
+ * @note The output resolution is the one given to `R3D_UpdateResolution`; the scaling
+ *       applied by dynamic resolution does not affect the capture.
+ * @note The capture stops by itself if the output resolution changes.
+ *
+ * @param fileName The path of the Y4M file to create.
+ * @param fps The frame rate written in the file header.
+ *
+ * @return True if the capture started.
+ */
+R3DAPI bool R3D_StartFrameCapture(const char* fileName, int fps);
+
+/**
+ * @brief Stops the frame capture, writes the frames still in flight and closes the file.
+ *
+ * It is called by `R3D_Close` if a capture is still running.
+ */
+R3DAPI void R3D_StopFrameCapture(void);
+
+
+
 // --------------------------------------------
 // UTILS: Camera Matrices Retrieval Functions
 // --------------------------------------------
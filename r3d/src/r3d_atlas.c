@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+
+#include "r3d.h"
+
+#include <raylib.h>
+#include <rlgl.h>
+#include <glad.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "./details/misc/r3d_half.h"
+
+/* === Internal Types === */
+
+typedef struct {
+    int x, y, w;
+} r3d_skyline_node_t;
+
+typedef struct {
+    r3d_skyline_node_t* nodes;
+    int count;
+} r3d_skyline_t;
+
+typedef struct {
+    int index, w, h;
+} r3d_atlas_entry_t;
+
+/* === Internal Functions === */
+
+// Returns the height at which a rectangle of width `w` rests when its left edge is on node `index`, -1 if it does not fit
+static int r3d_skyline_fit(const r3d_skyline_t* skyline, int index, int w, int h, int size)
+{
+    int x = skyline->nodes[index].x;
+    if (x + w > size) return -1;
+
+    int y = 0;
+    int remaining = w;
+
+    for (int i = index; remaining > 0; i++) {
+        y = (skyline->nodes[i].y > y) ? skyline->nodes[i].y : y;
+        if (y + h > size) return -1;
+        remaining -= skyline->nodes[i].w;
+    }
+
+    return y;
+}
+
+static void r3d_skyline_insert(r3d_skyline_t* skyline, int index, int x, int y, int w)
+{
+    r3d_skyline_node_t* nodes = skyline->nodes;
+
+    memmove(&nodes[index + 1], &nodes[index], (skyline->count - index) * sizeof(r3d_skyline_node_t));
+    nodes[index] = (r3d_skyline_node_t) { x, y, w };
+    skyline->count++;
+
+    // Shrink or remove the nodes now covered by the new one
+    for (int i = index + 1; i < skyline->count; i++) {
+        int shrink = (nodes[i - 1].x + nodes[i - 1].w) - nodes[i].x;
+        if (shrink <= 0) break;
+        nodes[i].x += shrink;
+        nodes[i].w -= shrink;
+        if (nodes[i].w > 0) break;
+        memmove(&nodes[i], &nodes[i + 1], (skyline->count - i - 1) * sizeof(r3d_skyline_node_t));
+        skyline->count--, i--;
+    }
+
+    // Merge neighbours at the same height
+    for (int i = 0; i < skyline->count - 1; i++) {
+        if (nodes[i].y == nodes[i + 1].y) {
+            nodes[i].w += nodes[i + 1].w;
+            memmove(&nodes[i + 1], &nodes[i + 2], (skyline->count - i - 2) * sizeof(r3d_skyline_node_t));
+            skyline->count--, i--;
+        }
+    }
+}
+
+// Bottom-left skyline placement, returns false if the rectangle does not fit in the page
+static bool r3d_skyline_pack(r3d_skyline_t* skyline, int w, int h, int size, int* outX, int* outY)
+{
+    int bestIndex = -1;
+    int bestY = size;
+    int bestW = size + 1;
+
+    for (int i = 0; i < skyline->count; i++) {
+        int y = r3d_skyline_fit(skyline, i, w, h, size);
+        if (y < 0) continue;
+        if (y < bestY || (y == bestY && skyline->nodes[i].w < bestW)) {
+            bestIndex = i;
+            bestY = y;
+            bestW = skyline->nodes[i].w;
+        }
+    }
+
+    if (bestIndex < 0) {
+        return false;
+    }
+
+    *outX = skyline->nodes[bestIndex].x;
+    *outY = bestY;
+
+    r3d_skyline_insert(skyline, bestIndex, *outX, bestY + h, w);
+
+    return true;
+}
+
+static int r3d_atlas_compare_height(const void* a, const void* b)
+{
+    const r3d_atlas_entry_t* entryA = a;
+    const r3d_atlas_entry_t* entryB = b;
+
+    if (entryA->h != entryB->h) return entryB->h - entryA->h;
+    return entryB->w - entryA->w;
+}
+
+// Copies `src` into the page at (x, y) and extrudes its edge texels over `padding` pixels on each side
+static void r3d_atlas_blit(unsigned char* page, int pageSize, const Image* src, int x, int y, int padding)
+{
+    const unsigned char* pixels = src->data;
+
+    for (int row = -padding; row < src->height + padding; row++) {
+        int srcRow = (row < 0) ? 0 : (row >= src->height) ? src->height - 1 : row;
+        const unsigned char* srcLine = pixels + srcRow * src->width * 4;
+        unsigned char* dstLine = page + ((y + row) * pageSize + x) * 4;
+
+        memcpy(dstLine, srcLine, src->width * 4);
+
+        for (int i = 1; i <= padding; i++) {
+            memcpy(dstLine - i * 4, srcLine, 4);
+            memcpy(dstLine + (src->width - 1 + i) * 4, srcLine + (src->width - 1) * 4, 4);
+        }
+    }
+}
+
+/* === Public Functions === */
+
+R3D_TextureAtlas R3D_LoadTextureAtlas(const Image* images, int count, int pageSize, int padding)
+{
+    R3D_TextureAtlas atlas = { 0 };
+
+    if (images == NULL || count <= 0 || pageSize <= 0 || padding < 0) {
+        TraceLog(LOG_WARNING, "R3D: Invalid parameters given to R3D_LoadTextureAtlas");
+        return atlas;
+    }
+
+    atlas.regions = RL_CALLOC(count, sizeof(Rectangle));
+    atlas.regionPages = RL_MALLOC(count * sizeof(int));
+    atlas.regionCount = count;
+
+    // Pack the tallest images first, this keeps the skyline flat and the pages dense
+
+    r3d_atlas_entry_t* order = RL_MALLOC(count * sizeof(r3d_atlas_entry_t));
+    for (int i = 0; i < count; i++) {
+        order[i] = (r3d_atlas_entry_t) { i, images[i].width + 2 * padding, images[i].height + 2 * padding };
+    }
+
+    qsort(order, count, sizeof(r3d_atlas_entry_t), r3d_atlas_compare_height);
+
+    r3d_skyline_t* skylines = NULL;
+    int skylineCount = 0;
+
+    for (int i = 0; i < count; i++) {
+        int index = order[i].index;
+        int w = order[i].w;
+        int h = order[i].h;
+
+        atlas.regionPages[index] = -1;
+
+        if (images[index].data == NULL || w > pageSize || h > pageSize) {
+            TraceLog(LOG_WARNING, "R3D: Image %i cannot be packed in a %ix%i atlas page", index, pageSize, pageSize);
+            continue;
+        }
+
+        int x = 0, y = 0, page = 0;
+        while (page < skylineCount && !r3d_skyline_pack(&skylines[page], w, h, pageSize, &x, &y)) {
+            page++;
+        }
+
+        if (page == skylineCount) {
+            skylines = RL_REALLOC(skylines, (skylineCount + 1) * sizeof(r3d_skyline_t));
+            skylines[page].nodes = RL_MALLOC((pageSize + 1) * sizeof(r3d_skyline_node_t));
+            skylines[page].nodes[0] = (r3d_skyline_node_t) { 0, 0, pageSize };
+            skylines[page].count = 1;
+            skylineCount++;
+            r3d_skyline_pack(&skylines[page], w, h, pageSize, &x, &y);
+        }
+
+        atlas.regionPages[index] = page;
+        atlas.regions[index] = (Rectangle) {
+            (float)(x + padding), (float)(y + padding),
+            (float)images[index].width, (float)images[index].height
+        };
+    }
+
+    // Build and upload the pages
+
+    atlas.pages = RL_CALLOC(skylineCount, sizeof(Texture2D));
+    atlas.pageCount = skylineCount;
+
+    unsigned char* pixels = RL_MALLOC(pageSize * pageSize * 4);
+
+    for (int page = 0; page < skylineCount; page++) {
+        memset(pixels, 0, pageSize * pageSize * 4);
+
+        for (int i = 0; i < count; i++) {
+            if (atlas.regionPages[i] != page) continue;
+
+            Image rgba = ImageCopy(images[i]);
+            ImageFormat(&rgba, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+
+            r3d_atlas_blit(pixels, pageSize, &rgba, (int)atlas.regions[i].x, (int)atlas.regions[i].y, padding);
+
+            UnloadImage(rgba);
+        }
+
+        Image image = {
+            .data = pixels,
+            .width = pageSize,
+            .height = pageSize,
+            .mipmaps = 1,
+            .format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8
+        };
+
+        atlas.pages[page] = LoadTextureFromImage(image);
+        GenTextureMipmaps(&atlas.pages[page]);
+
+        RL_FREE(skylines[page].nodes);
+    }
+
+    RL_FREE(pixels);
+    RL_FREE(skylines);
+    RL_FREE(order);
+
+    return atlas;
+}
+
+void R3D_UnloadTextureAtlas(R3D_TextureAtlas atlas)
+{
+    for (int i = 0; i < atlas.pageCount; i++) {
+        UnloadTexture(atlas.pages[i]);
+    }
+
+    RL_FREE(atlas.pages);
+    RL_FREE(atlas.regions);
+    RL_FREE(atlas.regionPages);
+}
+
+bool R3D_GetTextureAtlasRegion(const R3D_TextureAtlas* atlas, int index, Texture2D* page, Vector2* uvOffset, Vector2* uvScale)
+{
+    if (index < 0 || index >= atlas->regionCount || atlas->regionPages[index] < 0) {
+        return false;
+    }
+
+    Texture2D texture = atlas->pages[atlas->regionPages[index]];
+    Rectangle region = atlas->regions[index];
+
+    if (page) *page = texture;
+    if (uvOffset) *uvOffset = (Vector2) { region.x / texture.width, region.y / texture.height };
+    if (uvScale) *uvScale = (Vector2) { region.width / texture.width, region.height / texture.height };
+
+    return true;
+}
+
+R3D_Sprite R3D_LoadSpriteFromAtlas(const R3D_TextureAtlas* atlas, int index, int xFrameCount, int yFrameCount)
+{
+    Texture2D page = { 0 };
+    Vector2 uvOffset = { 0 };
+    Vector2 uvScale = { 0 };
+
+    if (!R3D_GetTextureAtlasRegion(atlas, index, &page, &uvOffset, &uvScale)) {
+        TraceLog(LOG_WARNING, "R3D: Region %i is not part of the texture atlas", index);
+        return (R3D_Sprite) { 0 };
+    }
+
+    R3D_Sprite sprite = R3D_LoadSprite(page, xFrameCount, yFrameCount);
+
+    sprite.region = (Rectangle) { uvOffset.x, uvOffset.y, uvScale.x, uvScale.y };
+    sprite.frameSize.x = atlas->regions[index].width / xFrameCount;
+    sprite.frameSize.y = atlas->regions[index].height / yFrameCount;
+
+    return sprite;
+}
+
+void R3D_RemapMeshToAtlas(Mesh* mesh, const R3D_TextureAtlas* atlas, int index)
+{
+    Vector2 uvOffset = { 0 };
+    Vector2 uvScale = { 0 };
+
+    if (mesh->texcoords == NULL || !R3D_GetTextureAtlasRegion(atlas, index, NULL, &uvOffset, &uvScale)) {
+        TraceLog(LOG_WARNING, "R3D: Unable to remap mesh texture coordinates to atlas region %i", index);
+        return;
+    }
+
+    for (int i = 0; i < mesh->vertexCount; i++) {
+        mesh->texcoords[2 * i + 0] = uvOffset.x + mesh->texcoords[2 * i + 0] * uvScale.x;
+        mesh->texcoords[2 * i + 1] = uvOffset.y + mesh->texcoords[2 * i + 1] * uvScale.y;
+    }
+
+    if (mesh->vboId == NULL || mesh->vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD] == 0) {
+        return;
+    }
+
+    GLint size = 0;
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD]);
+    glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &size);
+
+    // Meshes quantized by 'R3D_OptimizeMesh' keep their texcoords as half floats on the GPU
+    if (size == 2 * mesh->vertexCount * (GLint)sizeof(r3d_half_t)) {
+        r3d_half_t* packed = RL_MALLOC(size);
+        for (int i = 0; i < 2 * mesh->vertexCount; i++) {
+            packed[i] = r3d_cvt_fh(mesh->texcoords[i]);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, size, packed);
+        RL_FREE(packed);
+    }
+    else {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, 2 * mesh->vertexCount * sizeof(float), mesh->texcoords);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -25,6 +25,9 @@
 #include <rlgl.h>
 #include <glad.h>
 
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
 #include <float.h>
 
 #include "./r3d_state.h"
@@ -33,7 +36,8 @@
 #include "./details/r3d_billboard.h"
 #include "./details/r3d_collision.h"
 #include "./details/r3d_primitives.h"
-#include "./details/r3d_projection.h"
+#include "./details/r3d_jobs.h"
+#include "./details/misc/r3d_hash.h"
 #include "./details/containers/r3d_array.h"
 #include "./details/containers/r3d_registry.h"
 
@@ -41,17 +45,28 @@
 
 static bool r3d_has_deferred_calls(void);
 static bool r3d_has_forward_calls(void);
+static bool r3d_has_oit_calls(void);
 
 static void r3d_sprite_get_uv_scale_offset(const R3D_Sprite* sprite, Vector2* uvScale, Vector2* uvOffset, float sgnX, float sgnY);
+static r3d_sprite_batch_t* r3d_sprite_get_batch(const Material* material);
+static int r3d_sprite_compare_back_to_front(const void* a, const void* b);
 static void r3d_shadow_apply_cast_mode(R3D_ShadowCastMode mode);
 
 static R3D_RenderMode r3d_render_auto_detect_mode(const Material* material);
+static void r3d_render_push_instanced(r3d_drawcall_t* drawCall);
 static void r3d_render_apply_blend_mode(R3D_BlendMode mode);
+static bool r3d_render_is_oit(const r3d_drawcall_t* call);
 
 static void r3d_gbuffer_enable_stencil_write(void);
 static void r3d_gbuffer_enable_stencil_test(bool passOnGeometry);
 static void r3d_gbuffer_disable_stencil(void);
 
+static void r3d_prepare_flush_sprite_batches(void);
+static void r3d_prepare_update_scene_query(void);
+static void r3d_prepare_upload_instances(void);
+static void r3d_prepare_release_instances(void);
+static void r3d_prepare_update_shadows(void);
+static void r3d_prepare_cull_views(void);
 static void r3d_prepare_sort_drawcalls(void);
 static void r3d_prepare_process_lights_and_batch(void);
 
@@ -66,16 +81,41 @@ static void r3d_pass_scene_background(void);
 static void r3d_pass_scene_deferred(void);
 static void r3d_pass_scene_forward_depth_prepass(void);
 static void r3d_pass_scene_forward(void);
+static void r3d_pass_scene_transparent(void);
+static void r3d_pass_scene_transparent_composite(void);
 
-static void r3d_pass_post_init(unsigned int fb, unsigned srcAttach);
+static void r3d_pass_taa(void);
+
+static void r3d_pass_post_init(void);
 static void r3d_pass_post_bloom(void);
-static void r3d_pass_post_fog(void);
-static void r3d_pass_post_tonemap(void);
-static void r3d_pass_post_adjustment(void);
+static void r3d_pass_post_uber(void);
 static void r3d_pass_post_fxaa(void);
 
 static void r3d_pass_final_blit(void);
+static void r3d_pass_capture_frame(void);
+
+static void r3d_capture_flush(bool wait);
+static void r3d_capture_write(unsigned int request, bool wait);
+
+static void r3d_render_graph_declare(bool allPasses);
+
+static void r3d_resolution_apply(int width, int height);
+static void r3d_framebuffers_reload(void);
+static void r3d_dynamic_resolution_update(void);
 
+static void r3d_view_setup(r3d_view_t* view, const R3D_View* desc, bool jitter);
+static void r3d_view_apply(int index);
+static bool r3d_view_targets_update(int index);
+static void r3d_view_targets_swap(int index);
+static void r3d_view_targets_unload(int index);
+
+static void r3d_stats_begin_frame(void);
+static void r3d_stats_pass_hook(int pass, bool after);
+
+static float r3d_taa_halton(unsigned int index, unsigned int base);
+
+static void r3d_reset_frame_arena(void);
+static r3d_array_t r3d_frame_array_recreate(r3d_arena_t* arena, const r3d_array_t* array, size_t minCapacity, size_t elemSize);
 static void r3d_reset_raylib_state(void);
 
 /* === Public functions === */
@@ -102,17 +142,22 @@ void R3D_Init(int resWidth, int resHeight, unsigned int flags)
         R3D.support.TEX_R11G11B10F = r3d_check_texture_format_support(GL_R11F_G11F_B10F);
         if (R3D.support.TEX_R11G11B10F) TraceLog(LOG_INFO, "R3D: R11F_G11F_B10F is supported");
         else TraceLog(LOG_WARNING, "R3D: R11F_G11F_B10F is NOT supported");
+
+        GLint binaryFormats = 0;
+        if (glGetProgramBinary != NULL && glProgramBinary != NULL) {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &binaryFormats);
+        }
+        R3D.support.PROGRAM_BINARY = (binaryFormats > 0);
+        if (R3D.support.PROGRAM_BINARY) TraceLog(LOG_INFO, "R3D: Program binaries are supported");
+        else TraceLog(LOG_WARNING, "R3D: Program binaries are NOT supported");
     }
 
-    // Load draw call arrays
-    R3D.container.aDrawForward = r3d_array_create(128, sizeof(r3d_drawcall_t));
-    R3D.container.aDrawDeferred = r3d_array_create(128, sizeof(r3d_drawcall_t));
-    R3D.container.aDrawForwardInst = r3d_array_create(8, sizeof(r3d_drawcall_t));
-    R3D.container.aDrawDeferredInst = r3d_array_create(8, sizeof(r3d_drawcall_t));
+    // Load the frame arena and the per-frame arrays it backs
+    R3D.container.frameArena = r3d_arena_create(R3D_FRAME_ARENA_SIZE);
+    r3d_reset_frame_arena();
 
     // Load lights registry
     R3D.container.rLights = r3d_registry_create(8, sizeof(r3d_light_t));
-    R3D.container.aLightBatch = r3d_array_create(8, sizeof(r3d_light_batched_t));
 
     // Environment data
     R3D.env.backgroundColor = (Vector3) { 0.2f, 0.2f, 0.2f };
@@ -123,6 +168,7 @@ void R3D_Init(int resWidth, int resHeight, unsigned int flags)
     R3D.env.ssaoRadius = 0.5f;
     R3D.env.ssaoBias = 0.025f;
     R3D.env.ssaoIterations = 10;
+    R3D.env.ssaoTemporal = false;
     R3D.env.bloomMode = R3D_BLOOM_DISABLED;
     R3D.env.bloomIntensity = 0.05f;
     R3D.env.bloomFilterRadius = 0;
@@ -143,6 +189,14 @@ void R3D_Init(int resWidth, int resHeight, unsigned int flags)
     R3D.state.resolution.height = resHeight;
     R3D.state.resolution.texelX = 1.0f / resWidth;
     R3D.state.resolution.texelY = 1.0f / resHeight;
+    R3D.state.resolution.outputWidth = resWidth;
+    R3D.state.resolution.outputHeight = resHeight;
+
+    // Init dynamic resolution, disabled by default
+    R3D.state.dynamicResolution.enabled = false;
+    R3D.state.dynamicResolution.scale = 1.0f;
+    R3D.state.dynamicResolution.baseWidth = resWidth;
+    R3D.state.dynamicResolution.baseHeight = resHeight;
 
     // Init rendering mode configs
     R3D.state.render.mode = R3D_RENDER_AUTO_DETECT;
@@ -173,6 +227,11 @@ void R3D_Init(int resWidth, int resHeight, unsigned int flags)
     // Load GL Objects - framebuffers, textures, shaders...
     // NOTE: The initialization of these resources is based
     //       on the global state and should be performed last.
+    //       The render graph is planned with every pass enabled first,
+    //       its aliasing decides which framebuffers share their storage.
+    r3d_render_graph_declare(true);
+    r3d_render_graph_compile(&R3D.container.renderGraph);
+    r3d_render_graph_alias(&R3D.container.renderGraph);
     r3d_framebuffers_load(resWidth, resHeight);
     r3d_textures_load();
     r3d_shaders_load();
@@ -183,17 +242,35 @@ void R3D_Init(int resWidth, int resHeight, unsigned int flags)
 
 void R3D_Close(void)
 {
+    R3D_StopFrameCapture();
+    r3d_readback_destroy(&R3D.readback.requests);
+    r3d_readback_destroy(&R3D.readback.capture);
+    r3d_gpu_timer_destroy(&R3D.state.stats.gpuTimer);
+    for (int i = 0; i < R3D_RENDER_GRAPH_MAX_PASSES; i++) {
+        r3d_gpu_timer_destroy(&R3D.state.stats.passGpuTimers[i]);
+    }
+
+    for (int i = 0; i < R3D_MAX_VIEWS; i++) {
+        r3d_view_targets_unload(i);
+    }
+
     r3d_framebuffers_unload();
     r3d_textures_unload();
     r3d_shaders_unload();
+    r3d_jobs_shutdown();
 
     r3d_array_destroy(&R3D.container.aDrawForward);
     r3d_array_destroy(&R3D.container.aDrawDeferred);
     r3d_array_destroy(&R3D.container.aDrawForwardInst);
     r3d_array_destroy(&R3D.container.aDrawDeferredInst);
 
-    r3d_registry_destroy(&R3D.container.rLights);
+    r3d_array_destroy(&R3D.container.aSpriteBatches);
     r3d_array_destroy(&R3D.container.aLightBatch);
+    r3d_arena_destroy(&R3D.container.frameArena);
+
+    r3d_registry_destroy(&R3D.container.rLights);
+    r3d_light_cull_destroy(&R3D.container.lightCull);
+    r3d_scene_query_destroy(&R3D.container.sceneQuery);
 
     glDeleteVertexArrays(1, &R3D.primitive.dummyVAO);
     r3d_primitive_unload(&R3D.primitive.quad);
@@ -212,6 +289,7 @@ void R3D_SetState(unsigned int flags)
         flags &= ~R3D_FLAG_8_BIT_NORMALS;
     }
 
+    unsigned int prevFlags = R3D.state.flags;
     R3D.state.flags |= flags;
 
     if (flags & R3D_FLAG_FXAA) {
@@ -219,6 +297,21 @@ void R3D_SetState(unsigned int flags)
             r3d_shader_load_screen_fxaa();
         }
     }
+
+    if ((flags & R3D_FLAG_OIT) && !(prevFlags & R3D_FLAG_OIT)) {
+        if (R3D.shader.screen.oit.id == 0) {
+            r3d_shader_load_screen_oit();
+        }
+        r3d_framebuffer_load_oit(R3D.state.resolution.width, R3D.state.resolution.height);
+    }
+
+    // The history and the post-processing targets depend on TAA
+    if ((flags & R3D_FLAG_TAA) && !(prevFlags & R3D_FLAG_TAA)) {
+        if (R3D.shader.screen.taa.id == 0) {
+            r3d_shader_load_screen_taa();
+        }
+        r3d_framebuffers_reload();
+    }
 }
 
 void R3D_ClearState(unsigned int flags)
@@ -228,7 +321,20 @@ void R3D_ClearState(unsigned int flags)
         flags &= ~R3D_FLAG_8_BIT_NORMALS;
     }    
 
+    unsigned int prevFlags = R3D.state.flags;
     R3D.state.flags &= ~flags;
+
+    if ((flags & R3D_FLAG_OIT) && (prevFlags & R3D_FLAG_OIT)) {
+        r3d_framebuffer_unload_oit();
+    }
+
+    if ((flags & R3D_FLAG_TAA) && (prevFlags & R3D_FLAG_TAA)) {
+        r3d_framebuffers_reload();
+    }
+
+    if ((flags & R3D_FLAG_SCENE_QUERIES) && (prevFlags & R3D_FLAG_SCENE_QUERIES)) {
+        r3d_scene_query_destroy(&R3D.container.sceneQuery);
+    }
 }
 
 void R3D_GetResolution(int* width, int* height)
@@ -244,17 +350,56 @@ void R3D_UpdateResolution(int width, int height)
         return;
     }
 
-    if (width == R3D.state.resolution.width && height == R3D.state.resolution.height) {
+    struct r3d_dynamic_resolution_t* dynRes = &R3D.state.dynamicResolution;
+
+    dynRes->baseWidth = width;
+    dynRes->baseHeight = height;
+
+    if (dynRes->enabled) {
+        width = (int)fmaxf(1.0f, width * dynRes->scale + 0.5f);
+        height = (int)fmaxf(1.0f, height * dynRes->scale + 0.5f);
+    }
+
+    r3d_resolution_apply(width, height);
+}
+
+void R3D_EnableDynamicResolution(float targetFrameTime, float minScale, float maxScale)
+{
+    if (targetFrameTime <= 0.0f || minScale <= 0.0f || minScale > maxScale) {
+        TraceLog(LOG_WARNING, "R3D: Invalid parameters given to 'R3D_EnableDynamicResolution'");
+        return;
+    }
+
+    struct r3d_dynamic_resolution_t* dynRes = &R3D.state.dynamicResolution;
+
+    dynRes->enabled = true;
+    dynRes->targetTime = targetFrameTime;
+    dynRes->minScale = minScale;
+    dynRes->maxScale = maxScale;
+    dynRes->scale = Clamp(dynRes->scale, minScale, maxScale);
+    dynRes->frameTime = 0.0f;
+    dynRes->cooldown = R3D_DYNAMIC_RESOLUTION_COOLDOWN;
+
+    R3D_UpdateResolution(dynRes->baseWidth, dynRes->baseHeight);
+}
+
+void R3D_DisableDynamicResolution(void)
+{
+    struct r3d_dynamic_resolution_t* dynRes = &R3D.state.dynamicResolution;
+
+    if (!dynRes->enabled) {
         return;
     }
 
-    r3d_framebuffers_unload();
-    r3d_framebuffers_load(width, height);
+    dynRes->enabled = false;
+    dynRes->scale = 1.0f;
 
-    R3D.state.resolution.width = width;
-    R3D.state.resolution.height = height;
-    R3D.state.resolution.texelX = 1.0f / width;
-    R3D.state.resolution.texelY = 1.0f / height;
+    r3d_resolution_apply(dynRes->baseWidth, dynRes->baseHeight);
+}
+
+float R3D_GetResolutionScale(void)
+{
+    return R3D.state.dynamicResolution.scale;
 }
 
 void R3D_SetRenderTarget(RenderTexture* target)
@@ -272,6 +417,18 @@ void R3D_SetSceneBounds(BoundingBox sceneBounds)
     R3D.state.scene.bounds = sceneBounds;
 }
 
+R3D_ShaderStats R3D_GetShaderStats(void)
+{
+    return (R3D_ShaderStats) {
+        .programCount = R3D.shader.stats.programCount,
+        .variantCount = R3D.shader.stats.variantCount,
+        .compileTime = (float)(R3D.shader.stats.compileTime * 1000.0),
+        .maxCompileTime = (float)(R3D.shader.stats.maxCompileTime * 1000.0),
+        .cachedCount = R3D.shader.stats.cacheHits,
+        .cacheSavedTime = (float)(R3D.shader.stats.cacheSavedTime * 1000.0)
+    };
+}
+
 void R3D_ApplyRenderMode(R3D_RenderMode mode)
 {
     R3D.state.render.mode = mode;
@@ -297,125 +454,202 @@ void R3D_ApplyAlphaScissorThreshold(float threshold)
     R3D.state.render.alphaScissorThreshold = threshold;
 }
 
+void R3D_ApplyQueryId(int id)
+{
+    R3D.state.render.queryId = id;
+}
+
 void R3D_Begin(Camera3D camera)
+{
+    R3D_View view = { .camera = camera };
+    R3D_BeginViews(&view, 1);
+}
+
+void R3D_BeginViews(const R3D_View* views, int count)
 {
     // Render the batch before proceeding
     rlDrawRenderBatchActive();
 
-    // Clear the previous draw call array state
-    r3d_array_clear(&R3D.container.aDrawForward);
-    r3d_array_clear(&R3D.container.aDrawDeferred);
-    r3d_array_clear(&R3D.container.aDrawForwardInst);
-    r3d_array_clear(&R3D.container.aDrawDeferredInst);
-
-    // Store camera position
-    R3D.state.transform.position = camera.position;
+    // Collect the timings of the previous frames
+    r3d_stats_begin_frame();
 
-    // Compute aspect ratio
-    float aspect = 1.0f;
-    if (R3D.state.flags & R3D_FLAG_ASPECT_KEEP) {
-        aspect = (float)R3D.state.resolution.width / R3D.state.resolution.height;
+    // Adjust the internal resolution before anything depends on it
+    if (R3D.state.dynamicResolution.enabled) {
+        r3d_dynamic_resolution_update();
     }
-    else {
-        aspect = (float)GetScreenWidth() / GetScreenHeight();
+
+    // Release the previous frame data
+    r3d_reset_frame_arena();
+
+    if (count > R3D_MAX_VIEWS) {
+        TraceLog(LOG_WARNING, "R3D: Only the first %i of %i views are rendered", R3D_MAX_VIEWS, count);
+        count = R3D_MAX_VIEWS;
     }
 
-    // Compute projection matrix
-    if (camera.projection == CAMERA_PERSPECTIVE) {
-        double top = rlGetCullDistanceNear() * tan(camera.fovy * 0.5 * DEG2RAD);
-        double right = top * aspect;
-        R3D.state.transform.proj = MatrixFrustum(
-            -right, right, -top, top,
-            rlGetCullDistanceNear(),
-            rlGetCullDistanceFar()
-        );
+    if (count < 1) {
+        TraceLog(LOG_WARNING, "R3D: No view given to render the frame");
+        count = 0;
     }
-    else if (camera.projection == CAMERA_ORTHOGRAPHIC) {
-        double top = camera.fovy / 2.0;
-        double right = top * aspect;
-        R3D.state.transform.proj = MatrixOrtho(
-            -right, right, -top, top,
-            rlGetCullDistanceNear(),
-            rlGetCullDistanceFar()
-        );
+
+    // Only the first view is jittered, the other ones have no history to accumulate the samples
+    for (int i = 0; i < count; i++) {
+        r3d_view_setup(&R3D.state.views.list[i], &views[i], i == 0 && (R3D.state.flags & R3D_FLAG_TAA));
     }
 
-    // Compute view matrix
-    R3D.state.transform.view = MatrixLookAt(
-        camera.position,
-        camera.target,
-        camera.up
-    );
+    // The first view keeps the full resolution, the history, the captures and the readbacks use its targets
+    if (count > 0) {
+        R3D.state.views.list[0].scale = 1.0f;
+    }
 
-    // Store inverse matrices
-    R3D.state.transform.invProj = MatrixInvert(R3D.state.transform.proj);
-    R3D.state.transform.invView = MatrixInvert(R3D.state.transform.view);
+    R3D.state.views.count = count;
 
-    // Compute frustum
-    Matrix matMV = MatrixMultiply(R3D.state.transform.view, R3D.state.transform.proj);
-    R3D.state.frustum.aabb = r3d_frustum_get_bounding_box(matMV);
-    R3D.state.frustum.shape = r3d_frustum_create(matMV);
+    if (count > 0) {
+        r3d_view_apply(0);
+    }
 }
 
 void R3D_End(void)
 {
-    r3d_prepare_sort_drawcalls();
-    r3d_prepare_process_lights_and_batch();
-
-    r3d_pass_shadow_maps();
+    r3d_prepare_flush_sprite_batches();
 
-    if (r3d_has_deferred_calls()) {
-        r3d_pass_gbuffer();
+    if (R3D.state.flags & R3D_FLAG_SCENE_QUERIES) {
+        r3d_prepare_update_scene_query();
     }
 
-    if (R3D.env.ssaoEnabled) {
-        r3d_pass_ssao();
-    }
+    r3d_prepare_upload_instances();
+    r3d_prepare_update_shadows();
+    r3d_prepare_cull_views();
 
-    if (r3d_has_deferred_calls()) {
-        r3d_pass_deferred_ambient();
-        r3d_pass_deferred_lights();
-    }
+    r3d_gpu_timer_begin(&R3D.state.stats.gpuTimer);
 
-    r3d_pass_scene_background();
+    // The shadow maps are only rendered with the first view, the lights of all the views were gathered
+    for (int i = 0; i < R3D.state.views.count; i++) {
+        r3d_view_apply(i);
+        r3d_prepare_sort_drawcalls();
 
-    if (r3d_has_deferred_calls()) {
-        r3d_pass_scene_deferred();
-    }
+        // A scaled view renders to its own targets, the passes only see the reduced resolution
+        bool scaled = r3d_view_targets_update(i);
+        if (scaled) r3d_view_targets_swap(i);
 
-    if (r3d_has_forward_calls()) {
-        if (R3D.state.flags & R3D_FLAG_DEPTH_PREPASS) {
-            r3d_pass_scene_forward_depth_prepass();
+        r3d_render_graph_declare(false);
+        r3d_render_graph_compile(&R3D.container.renderGraph);
+        r3d_render_graph_execute(&R3D.container.renderGraph, r3d_stats_pass_hook);
+
+        if (scaled) r3d_view_targets_swap(i);
+
+        if (i == 0 && R3D.readback.writer != NULL) {
+            r3d_pass_capture_frame();
         }
-        r3d_pass_scene_forward();
     }
 
-    r3d_pass_post_init(
-        R3D.framebuffer.scene.id,
-        GL_COLOR_ATTACHMENT0
-    );
+    r3d_gpu_timer_end(&R3D.state.stats.gpuTimer);
+
+    R3D.state.stats.cpuTime = 1000.0 * (GetTime() - R3D.state.stats.cpuStart);
+
+    // Leave the first view current, the culling helpers and the matrix getters refer to it
+    if (R3D.state.views.count > 0) {
+        r3d_view_apply(0);
+    }
+
+    r3d_prepare_release_instances();
+    r3d_reset_raylib_state();
+}
+
+void* R3D_FrameAlloc(unsigned int size)
+{
+    return r3d_arena_alloc(&R3D.container.frameArena, size);
+}
+
+R3D_FrameMemoryStats R3D_GetFrameMemoryStats(void)
+{
+    const r3d_arena_t* arena = &R3D.container.frameArena;
+
+    return (R3D_FrameMemoryStats) {
+        .used = (unsigned int)arena->used,
+        .lastFrameUsed = (unsigned int)arena->last_frame,
+        .highWater = (unsigned int)arena->high_water,
+        .capacity = (unsigned int)arena->capacity,
+        .heapAllocations = arena->heap_allocs
+    };
+}
 
-    if (R3D.env.bloomMode != R3D_BLOOM_DISABLED) {
-        r3d_pass_post_bloom();
+bool R3D_StartFrameCapture(const char* fileName, int fps)
+{
+    if (R3D.readback.writer != NULL) {
+        TraceLog(LOG_WARNING, "R3D: A frame capture is already running");
+        return false;
     }
 
-    if (R3D.env.fogMode != R3D_FOG_DISABLED) {
-        r3d_pass_post_fog();
+    int width = R3D.state.resolution.outputWidth;
+    int height = R3D.state.resolution.outputHeight;
+
+    R3D.readback.writer = r3d_capture_open(fileName, width, height, fps);
+    if (R3D.readback.writer == NULL) {
+        TraceLog(LOG_WARNING, "R3D: Failed to start the frame capture to '%s'", fileName);
+        return false;
     }
 
-    if (R3D.env.tonemapMode != R3D_TONEMAP_LINEAR || R3D.env.tonemapExposure != 1.0f) {
-        r3d_pass_post_tonemap();
+    R3D.readback.captureWidth = width;
+    R3D.readback.captureHeight = height;
+
+    TraceLog(LOG_INFO, "R3D: Frame capture started to '%s' (%ix%i)", fileName, width, height);
+
+    return true;
+}
+
+R3D_RenderGraphStats R3D_GetRenderGraphStats(void)
+{
+    const r3d_render_graph_t* graph = &R3D.container.renderGraph;
+
+    unsigned int allocated = r3d_render_graph_get_memory(graph, false);
+
+    return (R3D_RenderGraphStats) {
+        .passCount = graph->passCount,
+        .culledPassCount = r3d_render_graph_get_culled_count(graph),
+        .targetMemory = allocated,
+        .usedTargetMemory = r3d_render_graph_get_memory(graph, true),
+        .aliasedMemory = r3d_render_graph_get_unaliased_memory(graph) - allocated
+    };
+}
+
+R3D_FrameStats R3D_GetFrameStats(void)
+{
+    const r3d_render_graph_t* graph = &R3D.container.renderGraph;
+
+    R3D_FrameStats stats = {
+        .drawCalls = R3D.state.stats.drawCalls,
+        .instances = R3D.state.stats.instances,
+        .triangles = R3D.state.stats.triangles,
+        .lights = R3D.state.stats.lights,
+        .cpuTime = (float)R3D.state.stats.cpuTime,
+        .gpuTime = (float)R3D.state.stats.gpuTime,
+        .passCount = (graph->passCount < R3D_FRAME_STATS_MAX_PASSES) ? graph->passCount : R3D_FRAME_STATS_MAX_PASSES
+    };
+
+    bool gpuTimings = (R3D.state.flags & R3D_FLAG_PASS_TIMINGS);
+
+    for (int i = 0; i < stats.passCount; i++) {
+        stats.passes[i].name = graph->passes[i].name;
+        stats.passes[i].executed = R3D.state.stats.passExecuted[i];
+        stats.passes[i].cpuTime = stats.passes[i].executed ? (float)R3D.state.stats.passCpuTime[i] : 0.0f;
+        stats.passes[i].gpuTime = (stats.passes[i].executed && gpuTimings) ? (float)R3D.state.stats.passGpuTime[i] : 0.0f;
     }
 
-    r3d_pass_post_adjustment();
+    return stats;
+}
 
-    if (R3D.state.flags & R3D_FLAG_FXAA) {
-        r3d_pass_post_fxaa();
+void R3D_StopFrameCapture(void)
+{
+    if (R3D.readback.writer == NULL) {
+        return;
     }
 
-    r3d_pass_final_blit();
+    r3d_capture_flush(true);
 
-    r3d_reset_raylib_state();
+    int frameCount = r3d_capture_close(R3D.readback.writer);
+    R3D.readback.writer = NULL;
+
+    TraceLog(LOG_INFO, "R3D: Frame capture stopped, %i frames written", frameCount);
 }
 
 void R3D_DrawMesh(Mesh mesh, Material material, Matrix transform)
@@ -434,6 +668,7 @@ void R3D_DrawMesh(Mesh mesh, Material material, Matrix transform)
     drawCall.geometry.mesh = mesh;
     drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MESH;
     drawCall.shadowCastMode = R3D.state.render.shadowCastMode;
+    drawCall.queryId = R3D.state.render.queryId;
 
     R3D_RenderMode mode = R3D.state.render.mode;
 
@@ -486,21 +721,7 @@ void R3D_DrawMeshInstancedPro(Mesh mesh, Material material, Matrix transform,
     drawCall.instanced.colors = instanceColors;
     drawCall.instanced.count = instanceCount;
 
-    R3D_RenderMode mode = R3D.state.render.mode;
-
-    if (mode == R3D_RENDER_AUTO_DETECT) {
-        mode = r3d_render_auto_detect_mode(&material);
-    }
-
-    r3d_array_t* arr = &R3D.container.aDrawDeferredInst;
-
-    if (mode == R3D_RENDER_FORWARD) {
-        drawCall.forward.alphaScissorThreshold = R3D.state.render.alphaScissorThreshold;
-        drawCall.forward.blendMode = R3D.state.render.blendMode;
-        arr = &R3D.container.aDrawForwardInst;
-    }
-
-    r3d_array_push_back(arr, &drawCall);
+    r3d_render_push_instanced(&drawCall);
 }
 
 void R3D_DrawModel(Model model, Vector3 position, float scale)
@@ -539,42 +760,26 @@ void R3D_DrawSpritePro(R3D_Sprite sprite, Vector3 position, Vector2 size, Vector
     Matrix matScale = MatrixScale(fabsf(size.x) * 0.5f, -fabsf(size.y) * 0.5f, 1.0f);
     Matrix matRotation = MatrixRotate(rotationAxis, rotationAngle * DEG2RAD);
     Matrix matTranslation = MatrixTranslate(position.x, position.y, position.z);
-    Matrix matTransform = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
 
-    r3d_drawcall_t drawCall = { 0 };
+    // Sprites sharing the same material and states are drawn together,
+    // the billboard mode is applied by the instanced vertex shaders
+    r3d_sprite_batch_t* batch = r3d_sprite_get_batch(&sprite.material);
+    if (batch == NULL) return;
 
-    if (R3D.state.render.billboardMode == R3D_BILLBOARD_FRONT) {
-        r3d_billboard_mode_front(&matTransform, &R3D.state.transform.invView);
-    }
-    else if (R3D.state.render.billboardMode == R3D_BILLBOARD_Y_AXIS) {
-        r3d_billboard_mode_y(&matTransform, &R3D.state.transform.invView);
-    }
+    r3d_sprite_instance_t instance = { 0 };
+    instance.transform = MatrixMultiply(MatrixMultiply(matScale, matRotation), matTranslation);
 
-    drawCall.transform = matTransform;
-    drawCall.material = sprite.material;
-    drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_SPRITE;
-    drawCall.shadowCastMode = R3D.state.render.shadowCastMode;
+    Vector2 uvScale = { 0 };
+    Vector2 uvOffset = { 0 };
 
     r3d_sprite_get_uv_scale_offset(
-        &sprite, &drawCall.geometry.sprite.uvScale, &drawCall.geometry.sprite.uvOffset,
+        &sprite, &uvScale, &uvOffset,
         (size.x > 0) ? 1.0f : -1.0f, (size.y > 0) ? 1.0f : -1.0f
     );
 
-    R3D_RenderMode mode = R3D.state.render.mode;
-
-    if (mode == R3D_RENDER_AUTO_DETECT) {
-        mode = r3d_render_auto_detect_mode(&sprite.material);
-    }
-
-    r3d_array_t* arr = &R3D.container.aDrawDeferred;
-
-    if (mode == R3D_RENDER_FORWARD) {
-        drawCall.forward.alphaScissorThreshold = R3D.state.render.alphaScissorThreshold;
-        drawCall.forward.blendMode = R3D.state.render.blendMode;
-        arr = &R3D.container.aDrawForward;
-    }
+    instance.texCoord = (Vector4) { uvOffset.x, uvOffset.y, uvScale.x, uvScale.y };
 
-    r3d_array_push_back(arr, &drawCall);
+    r3d_array_push_back(&batch->instances, &instance);
 }
 
 void R3D_DrawParticleSystem(const R3D_ParticleSystem* system, Mesh mesh, Material material)
@@ -584,6 +789,41 @@ void R3D_DrawParticleSystem(const R3D_ParticleSystem* system, Mesh mesh, Materia
 
 void R3D_DrawParticleSystemEx(const R3D_ParticleSystem* system, Mesh mesh, Material material, Matrix transform)
 {
+    if (system->storage == R3D_PARTICLE_STORAGE_GPU) {
+        if (system->buffers.vbo[0] == 0) {
+            return;
+        }
+
+        // The state buffer starts with the transform and color of each particle, drawn without any copy
+        r3d_drawcall_t drawCall = { 0 };
+
+        drawCall.transform = transform;
+        drawCall.material = material;
+        drawCall.geometry.mesh = mesh;
+        drawCall.geometryType = R3D_DRAWCALL_GEOMETRY_MESH;
+        drawCall.shadowCastMode = R3D.state.render.shadowCastMode;
+
+        drawCall.instanced.billboardMode = R3D.state.render.billboardMode;
+        drawCall.instanced.buffer = system->buffers.vbo[system->buffers.current];
+        drawCall.instanced.transStride = sizeof(r3d_particle_gpu_t);
+        drawCall.instanced.colStride = sizeof(r3d_particle_gpu_t);
+        drawCall.instanced.colOffset = offsetof(r3d_particle_gpu_t, color);
+        drawCall.instanced.count = system->capacity;
+
+        r3d_render_push_instanced(&drawCall);
+        return;
+    }
+
+    if (system->storage == R3D_PARTICLE_STORAGE_SOA) {
+        R3D_DrawMeshInstancedPro(
+            mesh, material, transform,
+            system->arrays.transforms, sizeof(Matrix),
+            system->arrays.colors, sizeof(Color),
+            system->count
+        );
+        return;
+    }
+
     R3D_DrawMeshInstancedPro(
         mesh, material, transform,
         &system->particles->transform, sizeof(R3D_Particle),
@@ -600,6 +840,22 @@ static bool r3d_has_deferred_calls(void)
     return (R3D.container.aDrawDeferred.count > 0 || R3D.container.aDrawDeferredInst.count > 0);
 }
 
+static bool r3d_has_oit_calls(void)
+{
+    if (!(R3D.state.flags & R3D_FLAG_OIT)) {
+        return false;
+    }
+
+    for (int i = 0; i < R3D.container.aDrawForward.count; i++) {
+        if (r3d_render_is_oit(r3d_array_at(&R3D.container.aDrawForward, i))) return true;
+    }
+    for (int i = 0; i < R3D.container.aDrawForwardInst.count; i++) {
+        if (r3d_render_is_oit(r3d_array_at(&R3D.container.aDrawForwardInst, i))) return true;
+    }
+
+    return false;
+}
+
 static bool r3d_has_forward_calls(void)
 {
     return (R3D.container.aDrawForward.count > 0 || R3D.container.aDrawForwardInst.count > 0);
@@ -607,15 +863,110 @@ static bool r3d_has_forward_calls(void)
 
 void r3d_sprite_get_uv_scale_offset(const R3D_Sprite* sprite, Vector2* uvScale, Vector2* uvOffset, float sgnX, float sgnY)
 {
-    uvScale->x = sgnX / sprite->xFrameCount;
-    uvScale->y = sgnY / sprite->yFrameCount;
+    Vector2 cell = {
+        sprite->region.width / sprite->xFrameCount,
+        sprite->region.height / sprite->yFrameCount
+    };
 
     int frameIndex = (int)sprite->currentFrame % (sprite->xFrameCount * sprite->yFrameCount);
     int frameX = frameIndex % sprite->xFrameCount;
     int frameY = frameIndex / sprite->xFrameCount;
 
-    uvOffset->x = frameX * uvScale->x;
-    uvOffset->y = frameY * uvScale->y;
+    uvOffset->x = sprite->region.x + frameX * cell.x;
+    uvOffset->y = sprite->region.y + frameY * cell.y;
+
+    // Flip within the frame itself, the region may be part of an atlas where wrapping is not possible
+    uvOffset->x += (sgnX < 0.0f) ? cell.x : 0.0f;
+    uvOffset->y += (sgnY < 0.0f) ? cell.y : 0.0f;
+
+    uvScale->x = sgnX * cell.x;
+    uvScale->y = sgnY * cell.y;
+}
+
+r3d_sprite_batch_t* r3d_sprite_get_batch(const Material* material)
+{
+    static const int maps[6] = {
+        MATERIAL_MAP_ALBEDO, MATERIAL_MAP_NORMAL, MATERIAL_MAP_EMISSION,
+        MATERIAL_MAP_OCCLUSION, MATERIAL_MAP_ROUGHNESS, MATERIAL_MAP_METALNESS
+    };
+
+    R3D_RenderMode mode = R3D.state.render.mode;
+
+    if (mode == R3D_RENDER_AUTO_DETECT) {
+        mode = r3d_render_auto_detect_mode(material);
+    }
+
+    // The key is cleared first so that it can be hashed and compared as raw bytes
+    r3d_sprite_batch_key_t key;
+    memset(&key, 0, sizeof(key));
+
+    key.shader = material->shader.id;
+    for (int i = 0; i < 6; i++) {
+        key.textures[i] = material->maps[maps[i]].texture.id;
+    }
+
+    key.albedo = material->maps[MATERIAL_MAP_ALBEDO].color;
+    key.emission = material->maps[MATERIAL_MAP_EMISSION].color;
+    key.values[0] = material->maps[MATERIAL_MAP_EMISSION].value;
+    key.values[1] = material->maps[MATERIAL_MAP_OCCLUSION].value;
+    key.values[2] = material->maps[MATERIAL_MAP_ROUGHNESS].value;
+    key.values[3] = material->maps[MATERIAL_MAP_METALNESS].value;
+
+    key.billboardMode = R3D.state.render.billboardMode;
+    key.shadowCastMode = R3D.state.render.shadowCastMode;
+    key.forward = (mode == R3D_RENDER_FORWARD);
+
+    if (key.forward) {
+        key.blendMode = R3D.state.render.blendMode;
+        key.alphaScissorThreshold = R3D.state.render.alphaScissorThreshold;
+    }
+
+    uint64_t hash = r3d_hash_fnv1a(R3D_HASH_FNV1A_SEED, &key, sizeof(key));
+
+    // Few batches are expected per frame, the most recent ones are checked first
+    r3d_sprite_batch_t* batches = R3D.container.aSpriteBatches.data;
+    for (int i = (int)R3D.container.aSpriteBatches.count - 1; i >= 0; i--) {
+        if (batches[i].hash == hash && memcmp(&batches[i].key, &key, sizeof(key)) == 0) {
+            return &batches[i];
+        }
+    }
+
+    r3d_sprite_batch_t batch = { 0 };
+
+    batch.key = key;
+    batch.hash = hash;
+    batch.instances = r3d_array_create_in_arena(&R3D.container.frameArena, 64, sizeof(r3d_sprite_instance_t));
+
+    batch.call.transform = MatrixIdentity();
+    batch.call.material = *material;
+    batch.call.geometry.sprite.uvOffset = (Vector2) { 0.0f, 0.0f };
+    batch.call.geometry.sprite.uvScale = (Vector2) { 1.0f, 1.0f };
+    batch.call.geometryType = R3D_DRAWCALL_GEOMETRY_SPRITE;
+    batch.call.shadowCastMode = key.shadowCastMode;
+    batch.call.instanced.billboardMode = key.billboardMode;
+    batch.call.forward.blendMode = key.blendMode;
+    batch.call.forward.alphaScissorThreshold = key.alphaScissorThreshold;
+
+    if (batch.instances.data == NULL || r3d_array_push_back(&R3D.container.aSpriteBatches, &batch) < 0) {
+        TraceLog(LOG_WARNING, "R3D: Failed to allocate a sprite batch");
+        return NULL;
+    }
+
+    return r3d_array_back(&R3D.container.aSpriteBatches);
+}
+
+int r3d_sprite_compare_back_to_front(const void* a, const void* b)
+{
+    const r3d_sprite_instance_t* instanceA = a;
+    const r3d_sprite_instance_t* instanceB = b;
+
+    Vector3 posA = { instanceA->transform.m12, instanceA->transform.m13, instanceA->transform.m14 };
+    Vector3 posB = { instanceB->transform.m12, instanceB->transform.m13, instanceB->transform.m14 };
+
+    float distA = Vector3DistanceSqr(R3D.state.transform.position, posA);
+    float distB = Vector3DistanceSqr(R3D.state.transform.position, posB);
+
+    return (distA < distB) - (distA > distB);
 }
 
 void r3d_shadow_apply_cast_mode(R3D_ShadowCastMode mode)
@@ -696,6 +1047,27 @@ R3D_RenderMode r3d_render_auto_detect_mode(const Material* material)
     return R3D_RENDER_DEFERRED;
 }
 
+void r3d_render_push_instanced(r3d_drawcall_t* drawCall)
+{
+    drawCall->queryId = R3D.state.render.queryId;
+
+    R3D_RenderMode mode = R3D.state.render.mode;
+
+    if (mode == R3D_RENDER_AUTO_DETECT) {
+        mode = r3d_render_auto_detect_mode(&drawCall->material);
+    }
+
+    r3d_array_t* arr = &R3D.container.aDrawDeferredInst;
+
+    if (mode == R3D_RENDER_FORWARD) {
+        drawCall->forward.alphaScissorThreshold = R3D.state.render.alphaScissorThreshold;
+        drawCall->forward.blendMode = R3D.state.render.blendMode;
+        arr = &R3D.container.aDrawForwardInst;
+    }
+
+    r3d_array_push_back(arr, drawCall);
+}
+
 void r3d_render_apply_blend_mode(R3D_BlendMode mode)
 {
     switch (mode)
@@ -720,6 +1092,11 @@ void r3d_render_apply_blend_mode(R3D_BlendMode mode)
     }
 }
 
+bool r3d_render_is_oit(const r3d_drawcall_t* call)
+{
+    return (R3D.state.flags & R3D_FLAG_OIT) && (call->forward.blendMode == R3D_BLEND_ALPHA);
+}
+
 void r3d_gbuffer_enable_stencil_write(void)
 {
     // Re-attach the depth/stencil buffer to the framebuffer
@@ -755,20 +1132,159 @@ void r3d_gbuffer_disable_stencil(void)
     glDisable(GL_STENCIL_TEST);
 }
 
-void r3d_prepare_sort_drawcalls(void)
+void r3d_prepare_flush_sprite_batches(void)
 {
-    // Sort front-to-back for deferred rendering
-    // This optimizes the depth test
-    r3d_drawcall_sort_front_to_back(
-        (r3d_drawcall_t*)R3D.container.aDrawDeferred.data,
-        R3D.container.aDrawDeferred.count
-    );
+    r3d_sprite_batch_t* batches = R3D.container.aSpriteBatches.data;
 
-    // Sort back-to-front for forward rendering
-    // Ensures better transparency handling
-    r3d_drawcall_sort_back_to_front(
-        (r3d_drawcall_t*)R3D.container.aDrawForward.data,
-        R3D.container.aDrawForward.count
+    for (size_t i = 0; i < R3D.container.aSpriteBatches.count; i++) {
+        r3d_sprite_batch_t* batch = &batches[i];
+        r3d_sprite_instance_t* instances = batch->instances.data;
+
+        // Alpha blended sprites are ordered within their batch, the batches themselves are not
+        if (batch->key.forward && batch->key.blendMode == R3D_BLEND_ALPHA && !(R3D.state.flags & R3D_FLAG_OIT)) {
+            qsort(instances, batch->instances.count, sizeof(r3d_sprite_instance_t), r3d_sprite_compare_back_to_front);
+        }
+
+        batch->call.instanced.transforms = &instances->transform;
+        batch->call.instanced.texCoords = &instances->texCoord;
+        batch->call.instanced.transStride = sizeof(r3d_sprite_instance_t);
+        batch->call.instanced.texStride = sizeof(r3d_sprite_instance_t);
+        batch->call.instanced.count = batch->instances.count;
+
+        r3d_array_push_back(
+            batch->key.forward ? &R3D.container.aDrawForwardInst : &R3D.container.aDrawDeferredInst,
+            &batch->call
+        );
+    }
+}
+
+void r3d_prepare_update_scene_query(void)
+{
+    r3d_scene_query_t* query = &R3D.container.sceneQuery;
+
+    r3d_scene_query_begin(query);
+
+    const r3d_array_t* single[2] = { &R3D.container.aDrawDeferred, &R3D.container.aDrawForward };
+
+    for (int i = 0; i < 2; i++) {
+        const r3d_drawcall_t* calls = single[i]->data;
+        for (size_t j = 0; j < single[i]->count; j++) {
+            if (calls[j].queryId < 0 || calls[j].geometryType != R3D_DRAWCALL_GEOMETRY_MESH) continue;
+            int mesh = r3d_scene_query_get_mesh(query, &calls[j].geometry.mesh);
+            if (mesh < 0) continue;
+            r3d_scene_query_push(query, mesh, calls[j].transform, calls[j].queryId, 0);
+        }
+    }
+
+    // Sprites and GPU particles have no CPU transforms to gather, instances are placed like in the vertex shaders
+    const r3d_array_t* instanced[2] = { &R3D.container.aDrawDeferredInst, &R3D.container.aDrawForwardInst };
+
+    for (int i = 0; i < 2; i++) {
+        const r3d_drawcall_t* calls = instanced[i]->data;
+        for (size_t j = 0; j < instanced[i]->count; j++) {
+            const r3d_drawcall_t* call = &calls[j];
+            if (call->queryId < 0 || call->geometryType != R3D_DRAWCALL_GEOMETRY_MESH || call->instanced.transforms == NULL) {
+                continue;
+            }
+            // The mesh is looked up once, all the instances share it
+            int mesh = r3d_scene_query_get_mesh(query, &call->geometry.mesh);
+            if (mesh < 0) continue;
+            size_t stride = (call->instanced.transStride == 0) ? sizeof(Matrix) : call->instanced.transStride;
+            for (size_t k = 0; k < call->instanced.count; k++) {
+                const Matrix* transform = (const Matrix*)((const char*)call->instanced.transforms + k * stride);
+                r3d_scene_query_push(query, mesh, MatrixMultiply(*transform, call->transform), call->queryId, (int)k);
+            }
+        }
+    }
+
+    r3d_scene_query_end(query);
+}
+
+void r3d_prepare_upload_instances(void)
+{
+    // Instanced calls are drawn by several passes and views, their data is uploaded once for all of them
+    for (size_t i = 0; i < R3D.container.aDrawDeferredInst.count; i++) {
+        r3d_drawcall_upload_instances((r3d_drawcall_t*)R3D.container.aDrawDeferredInst.data + i);
+    }
+    for (size_t i = 0; i < R3D.container.aDrawForwardInst.count; i++) {
+        r3d_drawcall_upload_instances((r3d_drawcall_t*)R3D.container.aDrawForwardInst.data + i);
+    }
+}
+
+void r3d_prepare_release_instances(void)
+{
+    for (size_t i = 0; i < R3D.container.aDrawDeferredInst.count; i++) {
+        r3d_drawcall_release_instances((r3d_drawcall_t*)R3D.container.aDrawDeferredInst.data + i);
+    }
+    for (size_t i = 0; i < R3D.container.aDrawForwardInst.count; i++) {
+        r3d_drawcall_release_instances((r3d_drawcall_t*)R3D.container.aDrawForwardInst.data + i);
+    }
+}
+
+void r3d_prepare_update_shadows(void)
+{
+    unsigned int lightCount = r3d_registry_get_count(&R3D.container.rLights);
+
+    for (unsigned int i = 0; i < lightCount; i++) {
+        r3d_light_t* light = r3d_registry_at(&R3D.container.rLights, i);
+        if (light->enabled && light->shadow.enabled) {
+            r3d_light_process_shadow_update(light);
+        }
+    }
+}
+
+void r3d_prepare_cull_views(void)
+{
+    R3D.state.views.shadowLights = r3d_array_create_in_arena(
+        &R3D.container.frameArena, 8, sizeof(r3d_light_batched_t)
+    );
+
+    R3D.state.stats.lights = 0;
+
+    for (int i = 0; i < R3D.state.views.count; i++) {
+        r3d_view_apply(i);
+        r3d_prepare_process_lights_and_batch();
+
+        // The batch may have grown, the view keeps the array that was filled
+        R3D.state.views.list[i].lights = R3D.container.aLightBatch;
+        R3D.state.stats.lights += R3D.container.aLightBatch.count;
+
+        // A light seen by several views gets its shadow map rendered once
+        for (int j = 0; j < R3D.container.aLightBatch.count; j++) {
+            r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, j);
+            if (!light->data->shadow.enabled) continue;
+
+            bool gathered = false;
+            for (int k = 0; k < R3D.state.views.shadowLights.count && !gathered; k++) {
+                gathered = (((r3d_light_batched_t*)r3d_array_at(&R3D.state.views.shadowLights, k))->data == light->data);
+            }
+
+            if (!gathered) {
+                r3d_array_push_back(&R3D.state.views.shadowLights, light);
+            }
+        }
+    }
+}
+
+void r3d_prepare_sort_drawcalls(void)
+{
+    // Sort front-to-back for deferred rendering
+    // This optimizes the depth test
+    r3d_drawcall_sort_front_to_back(
+        (r3d_drawcall_t*)R3D.container.aDrawDeferred.data,
+        R3D.container.aDrawDeferred.count
+    );
+
+    // The weighted transparency does not depend on the order
+    if (R3D.state.flags & R3D_FLAG_OIT) {
+        return;
+    }
+
+    // Sort back-to-front for forward rendering
+    // Ensures better transparency handling
+    r3d_drawcall_sort_back_to_front(
+        (r3d_drawcall_t*)R3D.container.aDrawForward.data,
+        R3D.container.aDrawForward.count
     );
 }
 
@@ -780,44 +1296,35 @@ void r3d_prepare_process_lights_and_batch(void)
     // Compute view / projection matrix
     Matrix viewProj = MatrixMultiply(R3D.state.transform.view, R3D.state.transform.proj);
 
-    for (int id = 1; id <= (int)r3d_registry_get_allocated_count(&R3D.container.rLights); id++) {
-        // Check if the light in the registry is still valid
-        if (!r3d_registry_is_valid(&R3D.container.rLights, id)) continue;
+    int screenW = R3D.state.resolution.width;
+    int screenH = R3D.state.resolution.height;
+
+    // Only live lights are stored in the registry, packed
+    unsigned int lightCount = r3d_registry_get_count(&R3D.container.rLights);
+
+    if (!r3d_light_cull_begin(&R3D.container.lightCull, (int)lightCount)) {
+        TraceLog(LOG_WARNING, "R3D: Failed to allocate light culling arrays");
+        return;
+    }
 
-        // Get the valid light and check if it is active
-        r3d_light_t* light = r3d_registry_get(&R3D.container.rLights, id);
+    // Gather the active lights, shadow updates were processed once for all the views
+    for (unsigned int i = 0; i < lightCount; i++) {
+        r3d_light_t* light = r3d_registry_at(&R3D.container.rLights, i);
         if (!light->enabled) continue;
 
-        // Process shadow update mode
-        if (light->shadow.enabled) {
-            r3d_light_process_shadow_update(light);
-        }
+        r3d_light_cull_push(&R3D.container.lightCull, light, screenW, screenH);
+    }
 
-        // Compute the projected area of the light into the screen
-        Rectangle dstRect = { 0 };
-        switch (light->type) {
-        case R3D_LIGHT_DIR:
-            dstRect.x = 0, dstRect.y = 0;
-            dstRect.width = (float)R3D.state.resolution.width;
-            dstRect.height = (float)R3D.state.resolution.height;
-            break;
-        case R3D_LIGHT_SPOT: {
-            dstRect = r3d_project_cone_bounding_box(
-                light->position, light->direction, light->range, fabsf(light->range * light->outerCutOff), //< r = h * cos(phi)
-                R3D.state.transform.position, viewProj, R3D.state.resolution.width, R3D.state.resolution.height
-            );
-        } break;
-        case R3D_LIGHT_OMNI:
-            dstRect = r3d_project_sphere_bounding_box(
-                light->position, light->range, R3D.state.transform.position, viewProj,
-                R3D.state.resolution.width, R3D.state.resolution.height
-            );
-            break;
-        }
+    // Compute the projected area of all the lights into the screen
+    r3d_light_cull_compute(
+        &R3D.container.lightCull, R3D.state.transform.position,
+        viewProj, screenW, screenH
+    );
+
+    for (int i = 0; i < R3D.container.lightCull.count; i++) {
+        Rectangle dstRect = R3D.container.lightCull.rects[i];
 
         // Determine if the light illuminates a part visible to the screen
-        int screenW = R3D.state.resolution.width;
-        int screenH = R3D.state.resolution.height;
         if (!CheckCollisionRecs(dstRect, (Rectangle) { 0, 0, (float)screenW, (float)screenH })) {
             continue;
         }
@@ -829,7 +1336,7 @@ void r3d_prepare_process_lights_and_batch(void)
         dstRect.height = Clamp(dstRect.height, 0, screenH - dstRect.y);
 
         // Here the light is supposed to be visible
-        r3d_light_batched_t batched = { .data = light, .dstRect = dstRect };
+        r3d_light_batched_t batched = { .data = R3D.container.lightCull.lights[i], .dstRect = dstRect };
         r3d_array_push_back(&R3D.container.aLightBatch, &batched);
     }
 }
@@ -844,9 +1351,9 @@ void r3d_pass_shadow_maps(void)
     rlMatrixMode(RL_PROJECTION);
     rlPushMatrix();
 
-    // Iterate through all lights to render all geometries
-    for (int i = 0; i < R3D.container.aLightBatch.count; i++) {
-        r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, i);
+    // Iterate through the lights visible from any view to render all geometries
+    for (int i = 0; i < R3D.state.views.shadowLights.count; i++) {
+        r3d_light_batched_t* light = r3d_array_at(&R3D.state.views.shadowLights, i);
 
         // Skip light if it doesn't produce shadows
         if (!light->data->shadow.enabled) continue;
@@ -1067,6 +1574,9 @@ void r3d_pass_gbuffer(void)
 
 void r3d_pass_ssao(void)
 {
+    // The history follows the first view, the other ones take the whole kernel at once
+    bool temporal = R3D.env.ssaoTemporal && (R3D.state.views.current == 0);
+
     rlEnableFramebuffer(R3D.framebuffer.pingPongSSAO.id);
     {
         rlViewport(0, 0, R3D.state.resolution.width / 2, R3D.state.resolution.height / 2);
@@ -1108,6 +1618,22 @@ void r3d_pass_ssao(void)
             r3d_shader_set_float(screen.ssao, uRadius, R3D.env.ssaoRadius);
             r3d_shader_set_float(screen.ssao, uBias, R3D.env.ssaoBias);
 
+            // In temporal mode, each frame takes an interleaved part of the kernel and shifts the noise
+            if (temporal) {
+                unsigned int frame = R3D.state.ssaoHistory.frameIndex;
+                r3d_shader_set_int(screen.ssao, uSampleCount, R3D_SSAO_TEMPORAL_SAMPLES);
+                r3d_shader_set_int(screen.ssao, uSampleOffset, frame % (R3D_SSAO_KERNEL_SIZE / R3D_SSAO_TEMPORAL_SAMPLES));
+                r3d_shader_set_vec2(screen.ssao, uNoiseOffset, ((Vector2) {
+                    fmodf(frame * 0.7548777f, 1.0f),
+                    fmodf(frame * 0.5698403f, 1.0f)
+                }));
+            }
+            else {
+                r3d_shader_set_int(screen.ssao, uSampleCount, R3D_SSAO_KERNEL_SIZE);
+                r3d_shader_set_int(screen.ssao, uSampleOffset, 0);
+                r3d_shader_set_vec2(screen.ssao, uNoiseOffset, ((Vector2) { 0.0f, 0.0f }));
+            }
+
             r3d_shader_bind_sampler2D(screen.ssao, uTexDepth, R3D.framebuffer.gBuffer.depth);
             r3d_shader_bind_sampler2D(screen.ssao, uTexNormal, R3D.framebuffer.gBuffer.normal);
             r3d_shader_bind_sampler1D(screen.ssao, uTexKernel, R3D.texture.ssaoKernel);
@@ -1122,10 +1648,59 @@ void r3d_pass_ssao(void)
         }
         r3d_shader_disable();
 
-        // Blur SSAO
+        // Blend with the reprojected history, the result goes both to the blur and to the next history
+        if (temporal) {
+            struct r3d_fb_pingpong_ssao_t* ssao = &R3D.framebuffer.pingPongSSAO;
+
+            r3d_framebuffer_swap_pingpong(R3D.framebuffer.pingPongSSAO);
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, ssao->accumulated, 0);
+
+            GLenum attachments[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+            glDrawBuffers(2, attachments);
+
+            Matrix viewProj = MatrixMultiply(R3D.state.transform.view, R3D.state.transform.proj);
+            Matrix invViewProj = MatrixMultiply(R3D.state.transform.invProj, R3D.state.transform.invView);
+
+            r3d_shader_enable(screen.ssaoTemporal);
+            {
+                r3d_shader_bind_sampler2D(screen.ssaoTemporal, uTexSSAO, ssao->source);
+                r3d_shader_bind_sampler2D(screen.ssaoTemporal, uTexHistory, ssao->history);
+                r3d_shader_bind_sampler2D(screen.ssaoTemporal, uTexDepth, R3D.framebuffer.gBuffer.depth);
+
+                r3d_shader_set_mat4(screen.ssaoTemporal, uMatInvViewProj, invViewProj);
+                r3d_shader_set_mat4(screen.ssaoTemporal, uMatPrevViewProj, R3D.state.ssaoHistory.prevViewProj);
+                r3d_shader_set_vec3(screen.ssaoTemporal, uViewPosition, R3D.state.transform.position);
+                r3d_shader_set_vec3(screen.ssaoTemporal, uPrevViewPosition, R3D.state.ssaoHistory.prevPosition);
+
+                // Without history the current frame is taken as is
+                r3d_shader_set_float(screen.ssaoTemporal, uBlend,
+                    R3D.state.ssaoHistory.historyValid ? R3D_SSAO_TEMPORAL_BLEND : 1.0f
+                );
+
+                r3d_primitive_draw_screen();
+            }
+            r3d_shader_disable();
+
+            // Detach the accumulation so it can be sampled next frame
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, 0, 0);
+            glDrawBuffers(1, attachments);
+
+            unsigned int tmp = ssao->history;
+            ssao->history = ssao->accumulated;
+            ssao->accumulated = tmp;
+
+            R3D.state.ssaoHistory.prevViewProj = viewProj;
+            R3D.state.ssaoHistory.prevPosition = R3D.state.transform.position;
+            R3D.state.ssaoHistory.historyValid = true;
+            R3D.state.ssaoHistory.frameIndex++;
+        }
+
+        // Blur SSAO, the accumulation already removed most of the noise in temporal mode
+        int iterations = temporal ? R3D.env.ssaoIterations / 2 : R3D.env.ssaoIterations;
+
         r3d_shader_enable(generate.gaussianBlurDualPass)
         {
-            for (int i = 0, horizontal = true; i < R3D.env.ssaoIterations; i++, horizontal = !horizontal) {
+            for (int i = 0, horizontal = true; i < iterations; i++, horizontal = !horizontal) {
                 r3d_framebuffer_swap_pingpong(R3D.framebuffer.pingPongSSAO);
                 r3d_shader_set_vec2(generate.gaussianBlurDualPass, uTexelDir,
                     ((horizontal)
@@ -1266,94 +1841,105 @@ void r3d_pass_deferred_lights(void)
             r3d_gbuffer_disable_stencil();
         }
 
-        r3d_shader_enable(screen.lighting);
-        {
-            r3d_shader_set_mat4(screen.lighting, uMatInvProj, R3D.state.transform.invProj);
-            r3d_shader_set_mat4(screen.lighting, uMatInvView, R3D.state.transform.invView);
-            r3d_shader_set_vec3(screen.lighting, uViewPosition, R3D.state.transform.position);
-
-            r3d_shader_bind_sampler2D(screen.lighting, uTexAlbedo, R3D.framebuffer.gBuffer.albedo);
-            r3d_shader_bind_sampler2D(screen.lighting, uTexNormal, R3D.framebuffer.gBuffer.normal);
-            r3d_shader_bind_sampler2D(screen.lighting, uTexDepth, R3D.framebuffer.gBuffer.depth);
-            r3d_shader_bind_sampler2D(screen.lighting, uTexORM, R3D.framebuffer.gBuffer.orm);
-            r3d_shader_bind_sampler2D(screen.lighting, uTexNoise, R3D.texture.randNoise);
-
-            for (int i = 0; i < R3D.container.aLightBatch.count; i++) {
-                r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, i);
-
-                // Send common data
-                r3d_shader_set_vec3(screen.lighting, uLight.color, light->data->color);
-                r3d_shader_set_float(screen.lighting, uLight.specular, light->data->specular);
-                r3d_shader_set_float(screen.lighting, uLight.energy, light->data->energy);
-                r3d_shader_set_int(screen.lighting, uLight.type, light->data->type);
-
-                // Send specific data
-                if (light->data->type == R3D_LIGHT_DIR) {
-                    r3d_shader_set_vec3(screen.lighting, uLight.direction, light->data->direction);
-                }
-                else if (light->data->type == R3D_LIGHT_SPOT) {
-                    r3d_shader_set_vec3(screen.lighting, uLight.position, light->data->position);
-                    r3d_shader_set_vec3(screen.lighting, uLight.direction, light->data->direction);
-                    r3d_shader_set_float(screen.lighting, uLight.range, light->data->range);
-                    r3d_shader_set_float(screen.lighting, uLight.attenuation, light->data->attenuation);
-                    r3d_shader_set_float(screen.lighting, uLight.innerCutOff, light->data->innerCutOff);
-                    r3d_shader_set_float(screen.lighting, uLight.outerCutOff, light->data->outerCutOff);
-                }
-                else if (light->data->type == R3D_LIGHT_OMNI) {
-                    r3d_shader_set_vec3(screen.lighting, uLight.position, light->data->position);
-                    r3d_shader_set_float(screen.lighting, uLight.range, light->data->range);
-                    r3d_shader_set_float(screen.lighting, uLight.attenuation, light->data->attenuation);
-                }
+        int current = -1;
 
-                // Send shadow map data
-                if (light->data->shadow.enabled) {
-                    if (light->data->type == R3D_LIGHT_OMNI) {
-                        r3d_shader_bind_samplerCube(screen.lighting, uLight.shadowCubemap, light->data->shadow.map.depth);
-                    }
-                    else {
-                        r3d_shader_set_float(screen.lighting, uLight.shadowMapTxlSz, light->data->shadow.map.texelSize);
-                        r3d_shader_bind_sampler2D(screen.lighting, uLight.shadowMap, light->data->shadow.map.depth);
-                        r3d_shader_set_mat4(screen.lighting, uLight.matVP, light->data->shadow.matVP);
-                        if (light->data->type == R3D_LIGHT_DIR) {
-                            // NOTE: The position of the directional lights is automatically calculated
-                            //       in `r3d_light_get_matrix_vp_dir`, and is used for shadows
-                            r3d_shader_set_vec3(screen.lighting, uLight.position, light->data->position);
-                        }
-                    }
-                    r3d_shader_set_float(screen.lighting, uLight.shadowBias, light->data->shadow.bias);
-                    r3d_shader_set_float(screen.lighting, uLight.size, light->data->size);
-                    r3d_shader_set_float(screen.lighting, uLight.near, light->data->near);
-                    r3d_shader_set_float(screen.lighting, uLight.far, light->data->far);
-                    r3d_shader_set_int(screen.lighting, uLight.shadow, true);
+        for (int i = 0; i < R3D.container.aLightBatch.count; i++) {
+            r3d_light_batched_t* light = r3d_array_at(&R3D.container.aLightBatch, i);
+
+            // Select the shader variant for this light, compiled on first use
+            int variant = r3d_shader_get_lighting_variant(light->data->type, light->data->shadow.enabled);
+            if (R3D.shader.screen.lighting[variant].id == 0) {
+                r3d_shader_load_screen_lighting(variant);
+            }
+
+            // Switching program requires resending the per-frame data
+            if (variant != current) {
+                current = variant;
+
+                r3d_shader_enable(screen.lighting[variant]);
+
+                r3d_shader_set_mat4(screen.lighting[variant], uMatInvProj, R3D.state.transform.invProj);
+                r3d_shader_set_mat4(screen.lighting[variant], uMatInvView, R3D.state.transform.invView);
+                r3d_shader_set_vec3(screen.lighting[variant], uViewPosition, R3D.state.transform.position);
+
+                r3d_shader_bind_sampler2D(screen.lighting[variant], uTexAlbedo, R3D.framebuffer.gBuffer.albedo);
+                r3d_shader_bind_sampler2D(screen.lighting[variant], uTexNormal, R3D.framebuffer.gBuffer.normal);
+                r3d_shader_bind_sampler2D(screen.lighting[variant], uTexDepth, R3D.framebuffer.gBuffer.depth);
+                r3d_shader_bind_sampler2D(screen.lighting[variant], uTexORM, R3D.framebuffer.gBuffer.orm);
+                r3d_shader_bind_sampler2D(screen.lighting[variant], uTexNoise, R3D.texture.randNoise);
+            }
+
+            // Send common data
+            r3d_shader_set_vec3(screen.lighting[variant], uLight.color, light->data->color);
+            r3d_shader_set_float(screen.lighting[variant], uLight.specular, light->data->specular);
+            r3d_shader_set_float(screen.lighting[variant], uLight.energy, light->data->energy);
+
+            // Send specific data
+            if (light->data->type == R3D_LIGHT_DIR) {
+                r3d_shader_set_vec3(screen.lighting[variant], uLight.direction, light->data->direction);
+            }
+            else if (light->data->type == R3D_LIGHT_SPOT) {
+                r3d_shader_set_vec3(screen.lighting[variant], uLight.position, light->data->position);
+                r3d_shader_set_vec3(screen.lighting[variant], uLight.direction, light->data->direction);
+                r3d_shader_set_float(screen.lighting[variant], uLight.range, light->data->range);
+                r3d_shader_set_float(screen.lighting[variant], uLight.attenuation, light->data->attenuation);
+                r3d_shader_set_float(screen.lighting[variant], uLight.innerCutOff, light->data->innerCutOff);
+                r3d_shader_set_float(screen.lighting[variant], uLight.outerCutOff, light->data->outerCutOff);
+            }
+            else if (light->data->type == R3D_LIGHT_OMNI) {
+                r3d_shader_set_vec3(screen.lighting[variant], uLight.position, light->data->position);
+                r3d_shader_set_float(screen.lighting[variant], uLight.range, light->data->range);
+                r3d_shader_set_float(screen.lighting[variant], uLight.attenuation, light->data->attenuation);
+            }
+
+            // Send shadow map data
+            if (light->data->shadow.enabled) {
+                if (light->data->type == R3D_LIGHT_OMNI) {
+                    r3d_shader_bind_samplerCube(screen.lighting[variant], uLight.shadowCubemap, light->data->shadow.map.depth);
                 }
                 else {
-                    r3d_shader_set_int(screen.lighting, uLight.shadow, false);
+                    r3d_shader_set_float(screen.lighting[variant], uLight.shadowMapTxlSz, light->data->shadow.map.texelSize);
+                    r3d_shader_bind_sampler2D(screen.lighting[variant], uLight.shadowMap, light->data->shadow.map.depth);
+                    r3d_shader_set_mat4(screen.lighting[variant], uLight.matVP, light->data->shadow.matVP);
+                    if (light->data->type == R3D_LIGHT_DIR) {
+                        // NOTE: The position of the directional lights is automatically calculated
+                        //       in `r3d_light_get_matrix_vp_dir`, and is used for shadows
+                        r3d_shader_set_vec3(screen.lighting[variant], uLight.position, light->data->position);
+                    }
                 }
+                r3d_shader_set_float(screen.lighting[variant], uLight.shadowBias, light->data->shadow.bias);
+                r3d_shader_set_float(screen.lighting[variant], uLight.size, light->data->size);
+                r3d_shader_set_float(screen.lighting[variant], uLight.near, light->data->near);
+                r3d_shader_set_float(screen.lighting[variant], uLight.far, light->data->far);
+            }
 
-                //if (light->data->type != R3D_LIGHT_DIR) {
-                //    glEnable(GL_SCISSOR_TEST);
-                //    glScissor(
-                //        light->dstRect.x, light->dstRect.y,
-                //        light->dstRect.width, light->dstRect.height
-                //    );
-                //}
+            //if (light->data->type != R3D_LIGHT_DIR) {
+            //    glEnable(GL_SCISSOR_TEST);
+            //    glScissor(
+            //        light->dstRect.x, light->dstRect.y,
+            //        light->dstRect.width, light->dstRect.height
+            //    );
+            //}
 
-                r3d_primitive_draw_screen();
+            r3d_primitive_draw_screen();
 
-                //if (light->data->type != R3D_LIGHT_DIR) {
-                //    glDisable(GL_SCISSOR_TEST);
-                //}
-            }
+            //if (light->data->type != R3D_LIGHT_DIR) {
+            //    glDisable(GL_SCISSOR_TEST);
+            //}
+        }
 
-            r3d_shader_unbind_sampler2D(screen.lighting, uTexAlbedo);
-            r3d_shader_unbind_sampler2D(screen.lighting, uTexNormal);
-            r3d_shader_unbind_sampler2D(screen.lighting, uTexDepth);
-            r3d_shader_unbind_sampler2D(screen.lighting, uTexORM);
-            r3d_shader_unbind_sampler2D(screen.lighting, uTexNoise);
+        // All lighting variants share the same texture slots
+        if (current >= 0) {
+            r3d_shader_unbind_sampler2D(screen.lighting[current], uTexAlbedo);
+            r3d_shader_unbind_sampler2D(screen.lighting[current], uTexNormal);
+            r3d_shader_unbind_sampler2D(screen.lighting[current], uTexDepth);
+            r3d_shader_unbind_sampler2D(screen.lighting[current], uTexORM);
+            r3d_shader_unbind_sampler2D(screen.lighting[current], uTexNoise);
 
-            r3d_shader_unbind_samplerCube(screen.lighting, uLight.shadowCubemap);
-            r3d_shader_unbind_sampler2D(screen.lighting, uLight.shadowMap);
+            r3d_shader_unbind_samplerCube(screen.lighting[current], uLight.shadowCubemap);
+            r3d_shader_unbind_sampler2D(screen.lighting[current], uLight.shadowMap);
         }
+
         r3d_shader_disable();
     }
 }
@@ -1652,6 +2238,7 @@ void r3d_pass_scene_forward_depth_prepass(void)
             {
                 for (int i = 0; i < R3D.container.aDrawForwardInst.count; i++) {
                     r3d_drawcall_t* call = r3d_array_at(&R3D.container.aDrawForwardInst, i);
+                    if (r3d_render_is_oit(call)) continue;
                     r3d_drawcall_raster_depth_inst(call);
                 }
             }
@@ -1666,6 +2253,7 @@ void r3d_pass_scene_forward_depth_prepass(void)
                 // objects first, in order to optimize early depth testing.
                 for (int i = R3D.container.aDrawForward.count - 1; i >= 0; i--) {
                     r3d_drawcall_t* call = r3d_array_at(&R3D.container.aDrawForward, i);
+                    if (r3d_render_is_oit(call)) continue;
                     r3d_drawcall_raster_depth(call);
                 }
             }
@@ -1682,6 +2270,104 @@ void r3d_pass_scene_forward_depth_prepass(void)
     }
 }
 
+// Draws the forward calls, either the ones blended by the weighted transparency or all the others
+static void r3d_pass_scene_forward_draw(bool oit)
+{
+    // Render instanced meshes
+    if (R3D.container.aDrawForwardInst.count > 0) {
+        r3d_shader_enable(raster.forwardInst);
+        {
+            r3d_shader_bind_sampler2D(raster.forwardInst, uTexNoise, R3D.texture.randNoise);
+
+            if (R3D.env.useSky) {
+                r3d_shader_bind_samplerCube(raster.forwardInst, uCubeIrradiance, R3D.env.sky.irradiance.id);
+                r3d_shader_bind_samplerCube(raster.forwardInst, uCubePrefilter, R3D.env.sky.prefilter.id);
+                r3d_shader_bind_sampler2D(raster.forwardInst, uTexBrdfLut, R3D.texture.iblBrdfLut);
+
+                r3d_shader_set_vec4(raster.forwardInst, uQuatSkybox, R3D.env.quatSky);
+                r3d_shader_set_int(raster.forwardInst, uHasSkybox, true);
+            }
+            else {
+                r3d_shader_set_vec3(raster.forwardInst, uColAmbient, R3D.env.ambientColor);
+                r3d_shader_set_int(raster.forwardInst, uHasSkybox, false);
+            }
+
+            r3d_shader_set_vec3(raster.forwardInst, uViewPosition, R3D.state.transform.position);
+
+            r3d_shader_set_int(raster.forwardInst, uOIT, oit);
+
+            for (int i = 0; i < R3D.container.aDrawForwardInst.count; i++) {
+                r3d_drawcall_t* call = r3d_array_at(&R3D.container.aDrawForwardInst, i);
+                if (r3d_render_is_oit(call) != oit) continue;
+                r3d_pass_scene_forward_inst_filter_and_send_lights(call);
+                if (!oit) r3d_render_apply_blend_mode(call->forward.blendMode);
+                r3d_drawcall_raster_forward_inst(call);
+            }
+
+            r3d_shader_unbind_sampler2D(raster.forwardInst, uTexNoise);
+
+            if (R3D.env.useSky) {
+                r3d_shader_unbind_samplerCube(raster.forwardInst, uCubeIrradiance);
+                r3d_shader_unbind_samplerCube(raster.forwardInst, uCubePrefilter);
+                r3d_shader_unbind_sampler2D(raster.forwardInst, uTexBrdfLut);
+            }
+
+            for (int i = 0; i < R3D_SHADER_FORWARD_NUM_LIGHTS; i++) {
+                r3d_shader_unbind_samplerCube(raster.forwardInst, uLights[i].shadowCubemap);
+                r3d_shader_unbind_sampler2D(raster.forwardInst, uLights[i].shadowMap);
+            }
+        }
+        r3d_shader_disable();
+    }
+
+    // Render non-instanced meshes
+    if (R3D.container.aDrawForward.count > 0) {
+        r3d_shader_enable(raster.forward);
+        {
+            r3d_shader_bind_sampler2D(raster.forward, uTexNoise, R3D.texture.randNoise);
+
+            if (R3D.env.useSky) {
+                r3d_shader_bind_samplerCube(raster.forward, uCubeIrradiance, R3D.env.sky.irradiance.id);
+                r3d_shader_bind_samplerCube(raster.forward, uCubePrefilter, R3D.env.sky.prefilter.id);
+                r3d_shader_bind_sampler2D(raster.forward, uTexBrdfLut, R3D.texture.iblBrdfLut);
+
+                r3d_shader_set_vec4(raster.forward, uQuatSkybox, R3D.env.quatSky);
+                r3d_shader_set_int(raster.forward, uHasSkybox, true);
+            }
+            else {
+                r3d_shader_set_vec3(raster.forward, uColAmbient, R3D.env.ambientColor);
+                r3d_shader_set_int(raster.forward, uHasSkybox, false);
+            }
+
+            r3d_shader_set_vec3(raster.forward, uViewPosition, R3D.state.transform.position);
+
+            r3d_shader_set_int(raster.forward, uOIT, oit);
+
+            for (int i = 0; i < R3D.container.aDrawForward.count; i++) {
+                r3d_drawcall_t* call = r3d_array_at(&R3D.container.aDrawForward, i);
+                if (r3d_render_is_oit(call) != oit) continue;
+                r3d_pass_scene_forward_filter_and_send_lights(call);
+                if (!oit) r3d_render_apply_blend_mode(call->forward.blendMode);
+                r3d_drawcall_raster_forward(call);
+            }
+
+            r3d_shader_unbind_sampler2D(raster.forward, uTexNoise);
+
+            if (R3D.env.useSky) {
+                r3d_shader_unbind_samplerCube(raster.forward, uCubeIrradiance);
+                r3d_shader_unbind_samplerCube(raster.forward, uCubePrefilter);
+                r3d_shader_unbind_sampler2D(raster.forward, uTexBrdfLut);
+            }
+
+            for (int i = 0; i < R3D_SHADER_FORWARD_NUM_LIGHTS; i++) {
+                r3d_shader_unbind_samplerCube(raster.forward, uLights[i].shadowCubemap);
+                r3d_shader_unbind_sampler2D(raster.forward, uLights[i].shadowMap);
+            }
+        }
+        r3d_shader_disable();
+    }
+}
+
 void r3d_pass_scene_forward(void)
 {
     rlEnableFramebuffer(R3D.framebuffer.scene.id);
@@ -1710,105 +2396,142 @@ void r3d_pass_scene_forward(void)
         rlLoadIdentity();
         rlMultMatrixf(MatrixToFloat(R3D.state.transform.view));
 
-        // Render instanced meshes
-        if (R3D.container.aDrawForwardInst.count > 0) {
-            r3d_shader_enable(raster.forwardInst);
-            {
-                r3d_shader_bind_sampler2D(raster.forwardInst, uTexNoise, R3D.texture.randNoise);
+        r3d_pass_scene_forward_draw(false);
 
-                if (R3D.env.useSky) {
-                    r3d_shader_bind_samplerCube(raster.forwardInst, uCubeIrradiance, R3D.env.sky.irradiance.id);
-                    r3d_shader_bind_samplerCube(raster.forwardInst, uCubePrefilter, R3D.env.sky.prefilter.id);
-                    r3d_shader_bind_sampler2D(raster.forwardInst, uTexBrdfLut, R3D.texture.iblBrdfLut);
+        // Reset projection matrix
+        rlMatrixMode(RL_PROJECTION);
+        rlPopMatrix();
 
-                    r3d_shader_set_vec4(raster.forwardInst, uQuatSkybox, R3D.env.quatSky);
-                    r3d_shader_set_int(raster.forwardInst, uHasSkybox, true);
-                }
-                else {
-                    r3d_shader_set_vec3(raster.forwardInst, uColAmbient, R3D.env.ambientColor);
-                    r3d_shader_set_int(raster.forwardInst, uHasSkybox, false);
-                }
+        // Reset view matrix
+        rlMatrixMode(RL_MODELVIEW);
+        rlLoadIdentity();
+    }
+}
 
-                r3d_shader_set_vec3(raster.forwardInst, uViewPosition, R3D.state.transform.position);
+void r3d_pass_scene_transparent(void)
+{
+    rlEnableFramebuffer(R3D.framebuffer.oit.id);
+    {
+        rlViewport(0, 0, R3D.state.resolution.width, R3D.state.resolution.height);
+        rlColorMask(true, true, true, true);
+        rlEnableBackfaceCulling();
 
-                for (int i = 0; i < R3D.container.aDrawForwardInst.count; i++) {
-                    r3d_drawcall_t* call = r3d_array_at(&R3D.container.aDrawForwardInst, i);
-                    r3d_pass_scene_forward_inst_filter_and_send_lights(call);
-                    r3d_render_apply_blend_mode(call->forward.blendMode);
-                    r3d_drawcall_raster_forward_inst(call);
-                }
+        // The surfaces are tested against the opaque depth without writing it
+        glDepthFunc(GL_LEQUAL);
+        rlEnableDepthTest();
+        rlDisableDepthMask();
+        r3d_gbuffer_enable_stencil_write();
 
-                r3d_shader_unbind_sampler2D(raster.forwardInst, uTexNoise);
+        // Nothing accumulated, everything behind is fully revealed
+        glClearBufferfv(GL_COLOR, 0, (float[4]) { 0.0f, 0.0f, 0.0f, 1.0f });
+        glClearBufferfv(GL_COLOR, 1, (float[4]) { 0.0f, 0.0f, 0.0f, 0.0f });
 
-                if (R3D.env.useSky) {
-                    r3d_shader_unbind_samplerCube(raster.forwardInst, uCubeIrradiance);
-                    r3d_shader_unbind_samplerCube(raster.forwardInst, uCubePrefilter);
-                    r3d_shader_unbind_sampler2D(raster.forwardInst, uTexBrdfLut);
-                }
+        // Both targets share the blending, without per-target functions in GL 3.3:
+        // the weighted colors and weights are summed, the alpha keeps the product of the transmittances
+        glEnable(GL_BLEND);
+        glBlendFuncSeparate(GL_ONE, GL_ONE, GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
 
-                for (int i = 0; i < R3D_SHADER_FORWARD_NUM_LIGHTS; i++) {
-                    r3d_shader_unbind_samplerCube(raster.forwardInst, uLights[i].shadowCubemap);
-                    r3d_shader_unbind_sampler2D(raster.forwardInst, uLights[i].shadowMap);
-                }
-            }
-            r3d_shader_disable();
-        }
+        // Setup projection matrix
+        rlMatrixMode(RL_PROJECTION);
+        rlPushMatrix();
+        rlSetMatrixProjection(R3D.state.transform.proj);
 
-        // Render non-instanced meshes
-        if (R3D.container.aDrawForward.count > 0) {
-            r3d_shader_enable(raster.forward);
-            {
-                r3d_shader_bind_sampler2D(raster.forward, uTexNoise, R3D.texture.randNoise);
+        // Setup view matrix
+        rlMatrixMode(RL_MODELVIEW);
+        rlLoadIdentity();
+        rlMultMatrixf(MatrixToFloat(R3D.state.transform.view));
 
-                if (R3D.env.useSky) {
-                    r3d_shader_bind_samplerCube(raster.forward, uCubeIrradiance, R3D.env.sky.irradiance.id);
-                    r3d_shader_bind_samplerCube(raster.forward, uCubePrefilter, R3D.env.sky.prefilter.id);
-                    r3d_shader_bind_sampler2D(raster.forward, uTexBrdfLut, R3D.texture.iblBrdfLut);
+        r3d_pass_scene_forward_draw(true);
 
-                    r3d_shader_set_vec4(raster.forward, uQuatSkybox, R3D.env.quatSky);
-                    r3d_shader_set_int(raster.forward, uHasSkybox, true);
-                }
-                else {
-                    r3d_shader_set_vec3(raster.forward, uColAmbient, R3D.env.ambientColor);
-                    r3d_shader_set_int(raster.forward, uHasSkybox, false);
-                }
+        // Reset projection matrix
+        rlMatrixMode(RL_PROJECTION);
+        rlPopMatrix();
 
-                r3d_shader_set_vec3(raster.forward, uViewPosition, R3D.state.transform.position);
+        // Reset view matrix
+        rlMatrixMode(RL_MODELVIEW);
+        rlLoadIdentity();
 
-                for (int i = 0; i < R3D.container.aDrawForward.count; i++) {
-                    r3d_drawcall_t* call = r3d_array_at(&R3D.container.aDrawForward, i);
-                    r3d_pass_scene_forward_filter_and_send_lights(call);
-                    r3d_render_apply_blend_mode(call->forward.blendMode);
-                    r3d_drawcall_raster_forward(call);
-                }
+        rlEnableDepthMask();
+    }
+}
 
-                r3d_shader_unbind_sampler2D(raster.forward, uTexNoise);
+void r3d_pass_scene_transparent_composite(void)
+{
+    rlEnableFramebuffer(R3D.framebuffer.scene.id);
+    {
+        rlViewport(0, 0, R3D.state.resolution.width, R3D.state.resolution.height);
+        rlDisableDepthTest();
+        r3d_gbuffer_disable_stencil();
 
-                if (R3D.env.useSky) {
-                    r3d_shader_unbind_samplerCube(raster.forward, uCubeIrradiance);
-                    r3d_shader_unbind_samplerCube(raster.forward, uCubePrefilter);
-                    r3d_shader_unbind_sampler2D(raster.forward, uTexBrdfLut);
-                }
+        // The resolved color is blended over the scene by the coverage, one minus the revealage
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-                for (int i = 0; i < R3D_SHADER_FORWARD_NUM_LIGHTS; i++) {
-                    r3d_shader_unbind_samplerCube(raster.forward, uLights[i].shadowCubemap);
-                    r3d_shader_unbind_sampler2D(raster.forward, uLights[i].shadowMap);
-                }
-            }
-            r3d_shader_disable();
+        r3d_shader_enable(screen.oit);
+        {
+            r3d_shader_bind_sampler2D(screen.oit, uTexAccum, R3D.framebuffer.oit.accum);
+            r3d_shader_bind_sampler2D(screen.oit, uTexWeight, R3D.framebuffer.oit.weight);
+
+            r3d_primitive_draw_screen();
+
+            r3d_shader_unbind_sampler2D(screen.oit, uTexAccum);
+            r3d_shader_unbind_sampler2D(screen.oit, uTexWeight);
         }
+        r3d_shader_disable();
 
-        // Reset projection matrix
-        rlMatrixMode(RL_PROJECTION);
-        rlPopMatrix();
+        rlDisableColorBlend();
+    }
+}
 
-        // Reset view matrix
-        rlMatrixMode(RL_MODELVIEW);
-        rlLoadIdentity();
+void r3d_pass_taa(void)
+{
+    bool primary = (R3D.state.views.current == 0);
+
+    r3d_gbuffer_disable_stencil();
+
+    rlEnableFramebuffer(R3D.framebuffer.taa.id);
+    {
+        rlViewport(0, 0, R3D.state.resolution.outputWidth, R3D.state.resolution.outputHeight);
+        rlDisableColorBlend();
+        rlDisableDepthTest();
+
+        // The frame resolved last time becomes the history
+        r3d_framebuffer_swap_pingpong(R3D.framebuffer.taa);
+
+        r3d_shader_enable(screen.taa);
+        {
+            r3d_shader_bind_sampler2D(screen.taa, uTexColor, R3D.framebuffer.scene.color);
+            r3d_shader_bind_sampler2D(screen.taa, uTexDepth, R3D.framebuffer.gBuffer.depth);
+            r3d_shader_bind_sampler2D(screen.taa, uTexHistory, R3D.framebuffer.taa.source);
+
+            r3d_shader_set_mat4(screen.taa, uMatInvViewProj, R3D.state.taa.invViewProj);
+            r3d_shader_set_mat4(screen.taa, uMatPrevViewProj, R3D.state.taa.prevViewProj);
+            r3d_shader_set_vec2(screen.taa, uJitter, primary ? R3D.state.taa.jitter : (Vector2) { 0 });
+
+            r3d_shader_set_vec2(screen.taa, uResolution, ((Vector2) {
+                (float)R3D.state.resolution.width,
+                (float)R3D.state.resolution.height
+            }));
+
+            // Without history the current frame is taken as is
+            r3d_shader_set_float(screen.taa, uBlend, (primary && R3D.state.taa.historyValid) ? R3D_TAA_BLEND : 1.0f);
+
+            r3d_primitive_draw_screen();
+        }
+        r3d_shader_disable();
     }
+
+    // The other views are only upsampled, 'r3d_pass_post_init' restores the history of the first one
+    if (!primary) {
+        return;
+    }
+
+    R3D.state.taa.prevViewProj = R3D.state.taa.viewProj;
+    R3D.state.taa.historyValid = true;
+    R3D.state.taa.frameIndex++;
 }
 
-void r3d_pass_post_init(unsigned int fb, unsigned srcAttach)
+void r3d_pass_post_init(void)
 {
     r3d_gbuffer_disable_stencil();
 
@@ -1816,17 +2539,26 @@ void r3d_pass_post_init(unsigned int fb, unsigned srcAttach)
 
     r3d_framebuffer_swap_pingpong(R3D.framebuffer.post);
 
+    // Start from the TAA output when enabled, it is already at the output resolution
+    bool taa = (R3D.state.flags & R3D_FLAG_TAA);
+
     glBindFramebuffer(GL_DRAW_FRAMEBUFFER, R3D.framebuffer.post.id);
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, fb);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, taa ? R3D.framebuffer.taa.id : R3D.framebuffer.scene.id);
 
-    glReadBuffer(srcAttach);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
     glDrawBuffer(GL_COLOR_ATTACHMENT0);
 
     glBlitFramebuffer(
-        0, 0, R3D.state.resolution.width, R3D.state.resolution.height,
-        0, 0, R3D.state.resolution.width, R3D.state.resolution.height,
+        0, 0, R3D.state.resolution.outputWidth, R3D.state.resolution.outputHeight,
+        0, 0, R3D.state.resolution.outputWidth, R3D.state.resolution.outputHeight,
         GL_COLOR_BUFFER_BIT, GL_NEAREST
     );
+
+    // Once copied, the output of another view is dropped so the first one stays in the history
+    if (taa && R3D.state.views.current > 0) {
+        glBindFramebuffer(GL_FRAMEBUFFER, R3D.framebuffer.taa.id);
+        r3d_framebuffer_swap_pingpong(R3D.framebuffer.taa);
+    }
 }
 
 void r3d_pass_post_bloom(void)
@@ -1909,7 +2641,7 @@ void r3d_pass_post_bloom(void)
 
     rlEnableFramebuffer(R3D.framebuffer.post.id);
     {
-        rlViewport(0, 0, R3D.state.resolution.width, R3D.state.resolution.height);
+        rlViewport(0, 0, R3D.state.resolution.outputWidth, R3D.state.resolution.outputHeight);
         rlDisableColorBlend();
         rlDisableDepthTest();
 
@@ -1929,76 +2661,51 @@ void r3d_pass_post_bloom(void)
     }
 }
 
-void r3d_pass_post_fog(void)
+void r3d_pass_post_uber(void)
 {
-    rlEnableFramebuffer(R3D.framebuffer.post.id);
-    {
-        rlViewport(0, 0, R3D.state.resolution.width, R3D.state.resolution.height);
-        rlDisableColorBlend();
-        rlDisableDepthTest();
-
-        r3d_framebuffer_swap_pingpong(R3D.framebuffer.post);
-
-        r3d_shader_enable(screen.fog);
-        {
-            r3d_shader_bind_sampler2D(screen.fog, uTexColor, R3D.framebuffer.post.source);
-            r3d_shader_bind_sampler2D(screen.fog, uTexDepth, R3D.framebuffer.gBuffer.depth);
+    // Fog, tonemapping and color adjustment only read the current pixel,
+    // so they are merged into a single pass whose variant matches the enabled modes
+    R3D_Fog fog = R3D.env.fogMode;
+    R3D_Tonemap tonemap = R3D.env.tonemapMode;
 
-            r3d_shader_set_float(screen.fog, uNear, (float)rlGetCullDistanceNear());
-            r3d_shader_set_float(screen.fog, uFar, (float)rlGetCullDistanceFar());
-            r3d_shader_set_int(screen.fog, uFogMode, R3D.env.fogMode);
-            r3d_shader_set_vec3(screen.fog, uFogColor, R3D.env.fogColor);
-            r3d_shader_set_float(screen.fog, uFogStart, R3D.env.fogStart);
-            r3d_shader_set_float(screen.fog, uFogEnd, R3D.env.fogEnd);
-            r3d_shader_set_float(screen.fog, uFogDensity, R3D.env.fogDensity);
+    if ((unsigned int)fog >= R3D_SHADER_POST_FOG_VARIANTS || (unsigned int)tonemap >= R3D_SHADER_POST_TONEMAP_VARIANTS) {
+        TraceLog(LOG_WARNING, "R3D: Invalid fog (%i) or tonemap (%i) mode, post-processing skipped", (int)fog, (int)tonemap);
+        return;
+    }
 
-            r3d_primitive_draw_screen();
-        }
-        r3d_shader_disable();
+    if (R3D.shader.screen.post[fog][tonemap].id == 0) {
+        r3d_shader_load_screen_post(fog, tonemap);
     }
-}
 
-void r3d_pass_post_tonemap(void)
-{
     rlEnableFramebuffer(R3D.framebuffer.post.id);
     {
-        rlViewport(0, 0, R3D.state.resolution.width, R3D.state.resolution.height);
+        rlViewport(0, 0, R3D.state.resolution.outputWidth, R3D.state.resolution.outputHeight);
         rlDisableColorBlend();
         rlDisableDepthTest();
 
         r3d_framebuffer_swap_pingpong(R3D.framebuffer.post);
 
-        r3d_shader_enable(screen.tonemap);
+        r3d_shader_enable(screen.post[fog][tonemap]);
         {
-            r3d_shader_bind_sampler2D(screen.tonemap, uTexColor, R3D.framebuffer.post.source);
-
-            r3d_shader_set_int(screen.tonemap, uTonemapMode, R3D.env.tonemapMode);
-            r3d_shader_set_float(screen.tonemap, uTonemapExposure, R3D.env.tonemapExposure);
-            r3d_shader_set_float(screen.tonemap, uTonemapWhite, R3D.env.tonemapWhite);
+            r3d_shader_bind_sampler2D(screen.post[fog][tonemap], uTexColor, R3D.framebuffer.post.source);
 
-            r3d_primitive_draw_screen();
-        }
-        r3d_shader_disable();
-    }
-}
-
-void r3d_pass_post_adjustment(void)
-{
-    rlEnableFramebuffer(R3D.framebuffer.post.id);
-    {
-        rlViewport(0, 0, R3D.state.resolution.width, R3D.state.resolution.height);
-        rlDisableColorBlend();
-        rlDisableDepthTest();
+            if (fog != R3D_FOG_DISABLED) {
+                r3d_shader_bind_sampler2D(screen.post[fog][tonemap], uTexDepth, R3D.framebuffer.gBuffer.depth);
 
-        r3d_framebuffer_swap_pingpong(R3D.framebuffer.post);
+                r3d_shader_set_float(screen.post[fog][tonemap], uNear, (float)rlGetCullDistanceNear());
+                r3d_shader_set_float(screen.post[fog][tonemap], uFar, (float)rlGetCullDistanceFar());
+                r3d_shader_set_vec3(screen.post[fog][tonemap], uFogColor, R3D.env.fogColor);
+                r3d_shader_set_float(screen.post[fog][tonemap], uFogStart, R3D.env.fogStart);
+                r3d_shader_set_float(screen.post[fog][tonemap], uFogEnd, R3D.env.fogEnd);
+                r3d_shader_set_float(screen.post[fog][tonemap], uFogDensity, R3D.env.fogDensity);
+            }
 
-        r3d_shader_enable(screen.adjustment);
-        {
-            r3d_shader_bind_sampler2D(screen.adjustment, uTexColor, R3D.framebuffer.post.source);
+            r3d_shader_set_float(screen.post[fog][tonemap], uTonemapExposure, R3D.env.tonemapExposure);
+            r3d_shader_set_float(screen.post[fog][tonemap], uTonemapWhite, R3D.env.tonemapWhite);
 
-            r3d_shader_set_float(screen.adjustment, uBrightness, R3D.env.brightness);
-            r3d_shader_set_float(screen.adjustment, uContrast, R3D.env.contrast);
-            r3d_shader_set_float(screen.adjustment, uSaturation, R3D.env.saturation);
+            r3d_shader_set_float(screen.post[fog][tonemap], uBrightness, R3D.env.brightness);
+            r3d_shader_set_float(screen.post[fog][tonemap], uContrast, R3D.env.contrast);
+            r3d_shader_set_float(screen.post[fog][tonemap], uSaturation, R3D.env.saturation);
 
             r3d_primitive_draw_screen();
         }
@@ -2010,7 +2717,7 @@ void r3d_pass_post_fxaa(void)
 {
     rlEnableFramebuffer(R3D.framebuffer.post.id);
     {
-        rlViewport(0, 0, R3D.state.resolution.width, R3D.state.resolution.height);
+        rlViewport(0, 0, R3D.state.resolution.outputWidth, R3D.state.resolution.outputHeight);
         rlDisableColorBlend();
         rlDisableDepthTest();
 
@@ -2021,8 +2728,8 @@ void r3d_pass_post_fxaa(void)
             r3d_shader_bind_sampler2D(screen.fxaa, uTexture, R3D.framebuffer.post.source);
 
             r3d_shader_set_vec2(screen.fxaa, uTexelSize, ((Vector2) {
-                R3D.state.resolution.texelX,
-                R3D.state.resolution.texelY
+                1.0f / R3D.state.resolution.outputWidth,
+                1.0f / R3D.state.resolution.outputHeight
             }));
 
             r3d_primitive_draw_screen();
@@ -2045,19 +2752,28 @@ void r3d_pass_final_blit(void)
         dstH = R3D.framebuffer.customTarget.texture.height;
     }
 
+    // Restrict the destination to the viewport of the view, given from the top-left corner
+    Rectangle viewport = R3D.state.views.list[R3D.state.views.current].viewport;
+    if (viewport.width > 0 && viewport.height > 0) {
+        dstX = (int)viewport.x;
+        dstY = dstH - (int)(viewport.y + viewport.height);
+        dstW = (int)viewport.width;
+        dstH = (int)viewport.height;
+    }
+
     // Maintain aspect ratio if the corresponding flag is set
     if (R3D.state.flags & R3D_FLAG_ASPECT_KEEP) {
-        float srcRatio = (float)R3D.state.resolution.width / R3D.state.resolution.height;
+        float srcRatio = (float)R3D.state.resolution.outputWidth / R3D.state.resolution.outputHeight;
         float dstRatio = (float)dstW / dstH;
         if (srcRatio > dstRatio) {
             int prevH = dstH;
             dstH = (int)(dstW * srcRatio + 0.5f);
-            dstY = (prevH - dstH) / 2;
+            dstY += (prevH - dstH) / 2;
         }
         else {
             int prevW = dstW;
             dstW = (int)(dstH * srcRatio + 0.5f);
-            dstX = (prevW - dstW) / 2;
+            dstX += (prevW - dstW) / 2;
         }
     }
 
@@ -2067,7 +2783,7 @@ void r3d_pass_final_blit(void)
     // Blit only the color data from the post-processing framebuffer to the main framebuffer
     glBindFramebuffer(GL_READ_FRAMEBUFFER, R3D.framebuffer.post.id);
     glBlitFramebuffer(
-        0, 0, R3D.state.resolution.width, R3D.state.resolution.height,
+        0, 0, R3D.state.resolution.outputWidth, R3D.state.resolution.outputHeight,
         dstX, dstY, dstX + dstW, dstY + dstH, GL_COLOR_BUFFER_BIT,
         (R3D.state.flags & R3D_FLAG_BLIT_LINEAR) ? GL_LINEAR : GL_NEAREST
     );
@@ -2081,6 +2797,583 @@ void r3d_pass_final_blit(void)
     );
 }
 
+void r3d_pass_capture_frame(void)
+{
+    if (R3D.state.resolution.outputWidth != R3D.readback.captureWidth ||
+        R3D.state.resolution.outputHeight != R3D.readback.captureHeight) {
+        TraceLog(LOG_WARNING, "R3D: The resolution changed during the frame capture, stopping it");
+        R3D_StopFrameCapture();
+        return;
+    }
+
+    // Hand over the frames the GPU has finished copying, then queue the copy of this one
+    r3d_capture_flush(false);
+
+    unsigned int fbo = R3D.framebuffer.post.id;
+    int width = R3D.state.resolution.outputWidth;
+    int height = R3D.state.resolution.outputHeight;
+
+    if (r3d_readback_push(&R3D.readback.capture, fbo, width, height, false) == 0) {
+        // The GPU is a whole ring behind, only wait for the oldest copy
+        r3d_capture_write(r3d_readback_oldest(&R3D.readback.capture), true);
+        r3d_readback_push(&R3D.readback.capture, fbo, width, height, false);
+    }
+}
+
+void r3d_capture_flush(bool wait)
+{
+    // Frames are written in order, stop at the first copy still in flight
+    unsigned int request = 0;
+    while ((request = r3d_readback_oldest(&R3D.readback.capture)) != 0) {
+        if (r3d_readback_poll(&R3D.readback.capture, request, wait) != R3D_READBACK_STATUS_READY) {
+            break;
+        }
+        r3d_capture_write(request, false);
+    }
+}
+
+void r3d_capture_write(unsigned int request, bool wait)
+{
+    unsigned char* frame = r3d_capture_acquire(R3D.readback.writer);
+
+    // A buffer that could not be mapped holds no valid pixels, the frame is dropped
+    if (r3d_readback_fetch(&R3D.readback.capture, request, frame, wait) != R3D_READBACK_STATUS_READY) {
+        TraceLog(LOG_WARNING, "R3D: Failed to read back a captured frame, skipping it");
+        r3d_capture_release(R3D.readback.writer, frame);
+        return;
+    }
+
+    r3d_capture_submit(R3D.readback.writer, frame);
+}
+
+void r3d_render_graph_declare(bool allPasses)
+{
+    r3d_render_graph_t* graph = &R3D.container.renderGraph;
+
+    int w = R3D.state.resolution.width;
+    int h = R3D.state.resolution.height;
+    int ow = R3D.state.resolution.outputWidth;
+    int oh = R3D.state.resolution.outputHeight;
+
+    // Same choice as the HDR texture creation
+    unsigned int hdrFormat = GL_RGB8, hdrSize = 3;
+    if (R3D.support.TEX_R11G11B10F) hdrFormat = GL_R11F_G11F_B10F, hdrSize = 4;
+    else if (R3D.support.TEX_RGB16F) hdrFormat = GL_RGB16F, hdrSize = 6;
+    else if (R3D.support.TEX_RGB32F) hdrFormat = GL_RGB32F, hdrSize = 12;
+
+    bool normal8 = (R3D.state.flags & R3D_FLAG_8_BIT_NORMALS) || !R3D.support.TEX_RG16F;
+
+    unsigned int bloomSize = 0;
+    for (int i = 0; i < R3D.framebuffer.mipChainBloom.mipCount; i++) {
+        bloomSize += R3D.framebuffer.mipChainBloom.mipChain[i].iW * R3D.framebuffer.mipChainBloom.mipChain[i].iH * 4;
+    }
+
+    r3d_render_graph_begin(graph);
+
+    /* --- Declare the render targets --- */
+
+    r3d_render_graph_set_resource(graph, R3D_TARGET_ALBEDO, (r3d_render_resource_t) {
+        "albedo", GL_RGB8, w, h, w * h * 3, false, true
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_EMISSION, (r3d_render_resource_t) {
+        "emission", hdrFormat, w, h, w * h * hdrSize, false, true
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_NORMAL, (r3d_render_resource_t) {
+        "normal", normal8 ? GL_RG8 : GL_RG16F, w, h, w * h * (normal8 ? 2 : 4), false, true
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_ORM, (r3d_render_resource_t) {
+        "orm", GL_RGB565, w, h, w * h * 2, false, true
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_DEPTH, (r3d_render_resource_t) {
+        "depth", GL_DEPTH24_STENCIL8, w, h, w * h * 4, false, true
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_SSAO, (r3d_render_resource_t) {
+        "ssao", GL_R8, w / 2, h / 2, (w / 2) * (h / 2) * (R3D.env.ssaoTemporal ? 2 + 2 * 4 : 2), false, R3D.framebuffer.pingPongSSAO.id != 0
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_DIFFUSE, (r3d_render_resource_t) {
+        "diffuse", hdrFormat, w, h, w * h * hdrSize, true, true
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_SPECULAR, (r3d_render_resource_t) {
+        "specular", hdrFormat, w, h, w * h * hdrSize, true, true
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_SCENE, (r3d_render_resource_t) {
+        "scene", hdrFormat, w, h, w * h * hdrSize, false, true
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_OIT, (r3d_render_resource_t) {
+        "oit", R3D.support.TEX_RG16F ? GL_RGBA16F : GL_RGBA32F, w, h,
+        w * h * (R3D.support.TEX_RG16F ? 8 + 2 : 16 + 4), false, R3D.framebuffer.oit.id != 0
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_BLOOM, (r3d_render_resource_t) {
+        "bloom", GL_R11F_G11F_B10F, w / 2, h / 2, bloomSize, false, R3D.framebuffer.mipChainBloom.id != 0
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_HISTORY, (r3d_render_resource_t) {
+        "taa history", hdrFormat, ow, oh, 2 * ow * oh * hdrSize, false, R3D.framebuffer.taa.id != 0
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_POST_SOURCE, (r3d_render_resource_t) {
+        "post source", hdrFormat, ow, oh, ow * oh * hdrSize, true, true
+    });
+    r3d_render_graph_set_resource(graph, R3D_TARGET_POST_TARGET, (r3d_render_resource_t) {
+        "post target", hdrFormat, ow, oh, ow * oh * hdrSize, true, true
+    });
+
+    /* --- Declare the passes in execution order --- */
+
+    bool deferred = allPasses || r3d_has_deferred_calls();
+    bool forward = allPasses || r3d_has_forward_calls();
+    bool ssao = allPasses || R3D.env.ssaoEnabled;
+    bool bloom = allPasses || (R3D.env.bloomMode != R3D_BLOOM_DISABLED);
+    bool prepass = allPasses || (R3D.state.flags & R3D_FLAG_DEPTH_PREPASS);
+    bool fxaa = allPasses || (R3D.state.flags & R3D_FLAG_FXAA);
+    bool taa = allPasses || (R3D.state.flags & R3D_FLAG_TAA);
+    bool oit = (allPasses && (R3D.state.flags & R3D_FLAG_OIT)) || r3d_has_oit_calls();
+
+    // The shadow maps are shared by the views, they are rendered with the first one
+    bool shadows = allPasses || (R3D.state.views.current == 0);
+
+    int pass = r3d_render_graph_add_pass(graph, "shadow maps", r3d_pass_shadow_maps, shadows, true);
+
+    pass = r3d_render_graph_add_pass(graph, "gbuffer", r3d_pass_gbuffer, deferred, false);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_ALBEDO);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_EMISSION);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_NORMAL);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_ORM);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_DEPTH);
+
+    pass = r3d_render_graph_add_pass(graph, "ssao", r3d_pass_ssao, ssao, false);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_NORMAL);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_DEPTH);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_SSAO);
+
+    pass = r3d_render_graph_add_pass(graph, "deferred ambient", r3d_pass_deferred_ambient, deferred, false);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_ALBEDO);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_NORMAL);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_ORM);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_DEPTH);
+    if (ssao) r3d_render_graph_read(graph, pass, R3D_TARGET_SSAO);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_DIFFUSE);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_SPECULAR);
+
+    pass = r3d_render_graph_add_pass(graph, "deferred lights", r3d_pass_deferred_lights, deferred, false);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_ALBEDO);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_NORMAL);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_ORM);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_DEPTH);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_DIFFUSE);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_SPECULAR);
+
+    pass = r3d_render_graph_add_pass(graph, "scene background", r3d_pass_scene_background, true, false);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_DEPTH);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_SCENE);
+
+    pass = r3d_render_graph_add_pass(graph, "scene deferred", r3d_pass_scene_deferred, deferred, false);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_ALBEDO);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_EMISSION);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_DIFFUSE);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_SPECULAR);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_DEPTH);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_SCENE);
+
+    pass = r3d_render_graph_add_pass(graph, "forward depth prepass", r3d_pass_scene_forward_depth_prepass, forward && prepass, false);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_DEPTH);
+
+    pass = r3d_render_graph_add_pass(graph, "scene forward", r3d_pass_scene_forward, forward, false);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_DEPTH);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_SCENE);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_DEPTH);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_SCENE);
+
+    pass = r3d_render_graph_add_pass(graph, "scene transparent", r3d_pass_scene_transparent, oit, false);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_DEPTH);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_OIT);
+
+    pass = r3d_render_graph_add_pass(graph, "transparent composite", r3d_pass_scene_transparent_composite, oit, false);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_OIT);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_SCENE);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_SCENE);
+
+    pass = r3d_render_graph_add_pass(graph, "taa", r3d_pass_taa, taa, false);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_SCENE);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_DEPTH);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_HISTORY);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_HISTORY);
+
+    pass = r3d_render_graph_add_pass(graph, "post init", r3d_pass_post_init, true, false);
+    r3d_render_graph_read(graph, pass, taa ? R3D_TARGET_HISTORY : R3D_TARGET_SCENE);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_POST_SOURCE);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_POST_TARGET);
+
+    pass = r3d_render_graph_add_pass(graph, "bloom", r3d_pass_post_bloom, bloom, false);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_SCENE);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_POST_SOURCE);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_BLOOM);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_POST_SOURCE);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_POST_TARGET);
+
+    pass = r3d_render_graph_add_pass(graph, "post uber", r3d_pass_post_uber, true, false);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_POST_SOURCE);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_DEPTH);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_POST_SOURCE);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_POST_TARGET);
+
+    pass = r3d_render_graph_add_pass(graph, "fxaa", r3d_pass_post_fxaa, fxaa, false);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_POST_SOURCE);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_POST_SOURCE);
+    r3d_render_graph_write(graph, pass, R3D_TARGET_POST_TARGET);
+
+    // The final blit writes to the screen or the custom target, outside of the graph
+    pass = r3d_render_graph_add_pass(graph, "final blit", r3d_pass_final_blit, true, true);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_POST_SOURCE);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_POST_TARGET);
+    r3d_render_graph_read(graph, pass, R3D_TARGET_DEPTH);
+}
+
+void r3d_resolution_apply(int width, int height)
+{
+    // With TAA the output stays at the base resolution, so it can change on its own
+    bool taa = (R3D.state.flags & R3D_FLAG_TAA);
+    int outputWidth = taa ? R3D.state.dynamicResolution.baseWidth : width;
+    int outputHeight = taa ? R3D.state.dynamicResolution.baseHeight : height;
+
+    if (width == R3D.state.resolution.width && height == R3D.state.resolution.height &&
+        outputWidth == R3D.state.resolution.outputWidth && outputHeight == R3D.state.resolution.outputHeight) {
+        return;
+    }
+
+    R3D.state.resolution.width = width;
+    R3D.state.resolution.height = height;
+    R3D.state.resolution.texelX = 1.0f / width;
+    R3D.state.resolution.texelY = 1.0f / height;
+
+    r3d_framebuffers_reload();
+}
+
+void r3d_framebuffers_reload(void)
+{
+    // TAA resolves into the base resolution, everything after it runs at that size
+    if (R3D.state.flags & R3D_FLAG_TAA) {
+        R3D.state.resolution.outputWidth = R3D.state.dynamicResolution.baseWidth;
+        R3D.state.resolution.outputHeight = R3D.state.dynamicResolution.baseHeight;
+    }
+    else {
+        R3D.state.resolution.outputWidth = R3D.state.resolution.width;
+        R3D.state.resolution.outputHeight = R3D.state.resolution.height;
+    }
+
+    // The targets of the scaled views follow the new slots and sizes, they are reloaded when next used
+    for (int i = 0; i < R3D_MAX_VIEWS; i++) {
+        r3d_view_targets_unload(i);
+    }
+
+    r3d_framebuffers_unload();
+
+    r3d_render_graph_declare(true);
+    r3d_render_graph_compile(&R3D.container.renderGraph);
+    r3d_render_graph_alias(&R3D.container.renderGraph);
+    r3d_framebuffers_load(R3D.state.resolution.width, R3D.state.resolution.height);
+}
+
+void r3d_dynamic_resolution_update(void)
+{
+    struct r3d_dynamic_resolution_t* dynRes = &R3D.state.dynamicResolution;
+
+    // Only react to new measures, they arrive a few frames late
+    if (!R3D.state.stats.gpuTimeUpdated) {
+        return;
+    }
+
+    // The renderer is bound by the slowest of the GPU work and the CPU submission
+    float frameTime = (float)fmax(R3D.state.stats.gpuTime, R3D.state.stats.cpuTime);
+    dynRes->frameTime = (dynRes->frameTime > 0.0f) ? Lerp(dynRes->frameTime, frameTime, 0.1f) : frameTime;
+
+    if (dynRes->cooldown > 0) {
+        dynRes->cooldown--;
+        return;
+    }
+
+    // Leave a margin around the target so the scale does not oscillate between two steps
+    float scale = dynRes->scale;
+    if (dynRes->frameTime > 1.05f * dynRes->targetTime || dynRes->frameTime < 0.85f * dynRes->targetTime) {
+        // The cost of most passes follows the pixel count, i.e. the square of the scale
+        scale *= sqrtf(dynRes->targetTime / dynRes->frameTime);
+    }
+
+    // Only a few distinct sizes are used, so the targets are rarely reallocated
+    scale = roundf(scale / R3D_DYNAMIC_RESOLUTION_STEP) * R3D_DYNAMIC_RESOLUTION_STEP;
+    scale = Clamp(scale, dynRes->minScale, dynRes->maxScale);
+
+    if (fabsf(scale - dynRes->scale) < 0.5f * R3D_DYNAMIC_RESOLUTION_STEP) {
+        return;
+    }
+
+    dynRes->scale = scale;
+    dynRes->frameTime = 0.0f;
+    dynRes->cooldown = R3D_DYNAMIC_RESOLUTION_COOLDOWN;
+
+    r3d_resolution_apply(
+        (int)fmaxf(1.0f, dynRes->baseWidth * scale + 0.5f),
+        (int)fmaxf(1.0f, dynRes->baseHeight * scale + 0.5f)
+    );
+}
+
+void r3d_view_setup(r3d_view_t* view, const R3D_View* desc, bool jitter)
+{
+    Camera3D camera = desc->camera;
+
+    view->viewport = desc->viewport;
+    view->position = camera.position;
+    view->scale = (desc->resolutionScale > 0.0f) ? fminf(desc->resolutionScale, 1.0f) : 1.0f;
+
+    // Compute aspect ratio
+    float aspect = 1.0f;
+    if (R3D.state.flags & R3D_FLAG_ASPECT_KEEP) {
+        aspect = (float)R3D.state.resolution.width / R3D.state.resolution.height;
+    }
+    else if (desc->viewport.width > 0 && desc->viewport.height > 0) {
+        aspect = desc->viewport.width / desc->viewport.height;
+    }
+    else {
+        aspect = (float)GetScreenWidth() / GetScreenHeight();
+    }
+
+    // Compute projection matrix
+    if (camera.projection == CAMERA_PERSPECTIVE) {
+        double top = rlGetCullDistanceNear() * tan(camera.fovy * 0.5 * DEG2RAD);
+        double right = top * aspect;
+        view->proj = MatrixFrustum(
+            -right, right, -top, top,
+            rlGetCullDistanceNear(),
+            rlGetCullDistanceFar()
+        );
+    }
+    else if (camera.projection == CAMERA_ORTHOGRAPHIC) {
+        double top = camera.fovy / 2.0;
+        double right = top * aspect;
+        view->proj = MatrixOrtho(
+            -right, right, -top, top,
+            rlGetCullDistanceNear(),
+            rlGetCullDistanceFar()
+        );
+    }
+
+    // Compute view matrix
+    view->view = MatrixLookAt(
+        camera.position,
+        camera.target,
+        camera.up
+    );
+
+    // Offset the projection by a different sub-pixel amount each frame, TAA accumulates the samples
+    if (jitter) {
+        R3D.state.taa.viewProj = MatrixMultiply(view->view, view->proj);
+        R3D.state.taa.invViewProj = MatrixInvert(R3D.state.taa.viewProj);
+
+        unsigned int index = (R3D.state.taa.frameIndex % R3D_TAA_JITTER_SAMPLES) + 1;
+        Vector2 offset = {
+            (2.0f * r3d_taa_halton(index, 2) - 1.0f) * R3D.state.resolution.texelX,
+            (2.0f * r3d_taa_halton(index, 3) - 1.0f) * R3D.state.resolution.texelY
+        };
+
+        // Adding the last row shifts the NDC position by the offset, for both projection types
+        Matrix* proj = &view->proj;
+        proj->m0 += offset.x * proj->m3, proj->m4 += offset.x * proj->m7;
+        proj->m8 += offset.x * proj->m11, proj->m12 += offset.x * proj->m15;
+        proj->m1 += offset.y * proj->m3, proj->m5 += offset.y * proj->m7;
+        proj->m9 += offset.y * proj->m11, proj->m13 += offset.y * proj->m15;
+
+        R3D.state.taa.jitter = Vector2Scale(offset, 0.5f);
+    }
+
+    // Store inverse matrices
+    view->invProj = MatrixInvert(view->proj);
+    view->invView = MatrixInvert(view->view);
+
+    // Compute frustum
+    Matrix matMV = MatrixMultiply(view->view, view->proj);
+    view->frustumAABB = r3d_frustum_get_bounding_box(matMV);
+    view->frustum = r3d_frustum_create(matMV);
+
+    // The visible lights are gathered by 'R3D_End'
+    view->lights = r3d_array_create_in_arena(
+        &R3D.container.frameArena, R3D.container.aLightBatch.capacity, sizeof(r3d_light_batched_t)
+    );
+}
+
+void r3d_view_apply(int index)
+{
+    const r3d_view_t* view = &R3D.state.views.list[index];
+
+    R3D.state.transform.view = view->view;
+    R3D.state.transform.invView = view->invView;
+    R3D.state.transform.proj = view->proj;
+    R3D.state.transform.invProj = view->invProj;
+    R3D.state.transform.position = view->position;
+
+    R3D.state.frustum.shape = view->frustum;
+    R3D.state.frustum.aabb = view->frustumAABB;
+
+    R3D.container.aLightBatch = view->lights;
+    R3D.state.views.current = index;
+}
+
+bool r3d_view_targets_update(int index)
+{
+    struct r3d_view_targets_t* targets = &R3D.state.viewTargets[index];
+    float scale = R3D.state.views.list[index].scale;
+
+    if (scale >= 1.0f) {
+        r3d_view_targets_unload(index);
+        return false;
+    }
+
+    struct r3d_resolution_t resolution = {
+        .width = (int)fmaxf(1.0f, R3D.state.resolution.width * scale + 0.5f),
+        .height = (int)fmaxf(1.0f, R3D.state.resolution.height * scale + 0.5f),
+        .outputWidth = (int)fmaxf(1.0f, R3D.state.resolution.outputWidth * scale + 0.5f),
+        .outputHeight = (int)fmaxf(1.0f, R3D.state.resolution.outputHeight * scale + 0.5f)
+    };
+    resolution.texelX = 1.0f / resolution.width;
+    resolution.texelY = 1.0f / resolution.height;
+
+    // The optional targets are loaded from the same flags and settings as the full ones,
+    // they only differ when a setter changed the full ones since the last load
+    const struct r3d_framebuffers_t* full = &R3D.framebuffer;
+    const struct r3d_framebuffers_t* own = &targets->framebuffer;
+
+    bool valid = (targets->resolution.width == resolution.width)
+        && (targets->resolution.height == resolution.height)
+        && (targets->resolution.outputWidth == resolution.outputWidth)
+        && (targets->resolution.outputHeight == resolution.outputHeight)
+        && ((full->taa.id != 0) == (own->taa.id != 0))
+        && ((full->oit.id != 0) == (own->oit.id != 0))
+        && ((full->pingPongSSAO.id != 0) == (own->pingPongSSAO.id != 0))
+        && ((full->pingPongSSAO.history != 0) == (own->pingPongSSAO.history != 0))
+        && ((full->mipChainBloom.id != 0) == (own->mipChainBloom.id != 0));
+
+    if (!valid) {
+        r3d_view_targets_unload(index);
+
+        // The loaders write to the current targets at the current resolution
+        targets->resolution = resolution;
+        r3d_view_targets_swap(index);
+        r3d_framebuffers_load(resolution.width, resolution.height);
+        r3d_view_targets_swap(index);
+    }
+
+    return true;
+}
+
+void r3d_view_targets_swap(int index)
+{
+    struct r3d_view_targets_t* targets = &R3D.state.viewTargets[index];
+
+    struct r3d_framebuffers_t framebuffer = R3D.framebuffer;
+    R3D.framebuffer = targets->framebuffer;
+    targets->framebuffer = framebuffer;
+
+    struct r3d_resolution_t resolution = R3D.state.resolution;
+    R3D.state.resolution = targets->resolution;
+    targets->resolution = resolution;
+
+    // The destination is shared by every view
+    R3D.framebuffer.customTarget = targets->framebuffer.customTarget;
+}
+
+void r3d_view_targets_unload(int index)
+{
+    struct r3d_view_targets_t* targets = &R3D.state.viewTargets[index];
+
+    if (targets->resolution.width == 0) {
+        return;
+    }
+
+    r3d_view_targets_swap(index);
+    r3d_framebuffers_unload();
+    r3d_view_targets_swap(index);
+
+    memset(targets, 0, sizeof(struct r3d_view_targets_t));
+}
+
+void r3d_stats_begin_frame(void)
+{
+    struct r3d_stats_t* stats = &R3D.state.stats;
+
+    stats->gpuTimeUpdated = r3d_gpu_timer_poll(&stats->gpuTimer, &stats->gpuTime);
+
+    if (R3D.state.flags & R3D_FLAG_PASS_TIMINGS) {
+        for (int i = 0; i < R3D_RENDER_GRAPH_MAX_PASSES; i++) {
+            r3d_gpu_timer_poll(&stats->passGpuTimers[i], &stats->passGpuTime[i]);
+        }
+    }
+
+    stats->drawCalls = 0;
+    stats->instances = 0;
+    stats->triangles = 0;
+    stats->lights = 0;
+
+    for (int i = 0; i < R3D_RENDER_GRAPH_MAX_PASSES; i++) {
+        stats->passExecuted[i] = false;
+        stats->passCpuTime[i] = 0.0;
+    }
+
+    stats->cpuStart = GetTime();
+}
+
+void r3d_stats_pass_hook(int pass, bool after)
+{
+    struct r3d_stats_t* stats = &R3D.state.stats;
+    bool gpuTimings = (R3D.state.flags & R3D_FLAG_PASS_TIMINGS);
+
+    // The GPU time is taken from the first view running the pass, a timer measures once per frame
+    bool firstRun = !stats->passExecuted[pass];
+
+    if (!after) {
+        stats->passCpuStart = GetTime();
+        if (gpuTimings && firstRun) r3d_gpu_timer_begin(&stats->passGpuTimers[pass]);
+    }
+    else {
+        if (gpuTimings && firstRun) r3d_gpu_timer_end(&stats->passGpuTimers[pass]);
+        stats->passCpuTime[pass] += 1000.0 * (GetTime() - stats->passCpuStart);
+        stats->passExecuted[pass] = true;
+    }
+}
+
+float r3d_taa_halton(unsigned int index, unsigned int base)
+{
+    float result = 0.0f;
+    float fraction = 1.0f;
+
+    while (index > 0) {
+        fraction /= base;
+        result += fraction * (index % base);
+        index /= base;
+    }
+
+    return result;
+}
+
+void r3d_reset_frame_arena(void)
+{
+    r3d_arena_t* arena = &R3D.container.frameArena;
+
+    r3d_arena_reset(arena);
+
+    // Recreate the arrays with the capacity reached during the previous frame,
+    // the arena now holds a single block large enough to fit them all again
+    R3D.container.aDrawForward = r3d_frame_array_recreate(arena, &R3D.container.aDrawForward, 128, sizeof(r3d_drawcall_t));
+    R3D.container.aDrawDeferred = r3d_frame_array_recreate(arena, &R3D.container.aDrawDeferred, 128, sizeof(r3d_drawcall_t));
+    R3D.container.aDrawForwardInst = r3d_frame_array_recreate(arena, &R3D.container.aDrawForwardInst, 8, sizeof(r3d_drawcall_t));
+    R3D.container.aDrawDeferredInst = r3d_frame_array_recreate(arena, &R3D.container.aDrawDeferredInst, 8, sizeof(r3d_drawcall_t));
+    R3D.container.aSpriteBatches = r3d_frame_array_recreate(arena, &R3D.container.aSpriteBatches, 8, sizeof(r3d_sprite_batch_t));
+    R3D.container.aLightBatch = r3d_frame_array_recreate(arena, &R3D.container.aLightBatch, 8, sizeof(r3d_light_batched_t));
+}
+
+r3d_array_t r3d_frame_array_recreate(r3d_arena_t* arena, const r3d_array_t* array, size_t minCapacity, size_t elemSize)
+{
+    // Never below the initial capacity, so a failed allocation is retried with it on the next frame
+    size_t capacity = (array->capacity > minCapacity) ? array->capacity : minCapacity;
+    return r3d_array_create_in_arena(arena, capacity, elemSize);
+}
+
 void r3d_reset_raylib_state(void)
 {
     rlDisableFramebuffer();
@@ -2,22 +2,48 @@
 
 #include "./r3d_state.h"
 
+// With several views, an object is visible if any of them sees it
+
 bool R3D_IsPointInFrustum(Vector3 position)
 {
-	return r3d_frustum_is_point_in(&R3D.state.frustum.shape, position);
+	for (int i = 0; i < R3D.state.views.count; i++) {
+		if (r3d_frustum_is_point_in(&R3D.state.views.list[i].frustum, position)) return true;
+	}
+	return false;
 }
 
 bool R3D_IsPointInFrustumXYZ(float x, float y, float z)
 {
-	return r3d_frustum_is_point_in_xyz(&R3D.state.frustum.shape, x, y, z);
+	for (int i = 0; i < R3D.state.views.count; i++) {
+		if (r3d_frustum_is_point_in_xyz(&R3D.state.views.list[i].frustum, x, y, z)) return true;
+	}
+	return false;
 }
 
 bool R3D_IsSphereInFrustum(Vector3 position, float radius)
 {
-	return r3d_frustum_is_sphere_in(&R3D.state.frustum.shape, position, radius);
+	for (int i = 0; i < R3D.state.views.count; i++) {
+		if (r3d_frustum_is_sphere_in(&R3D.state.views.list[i].frustum, position, radius)) return true;
+	}
+	return false;
 }
 
 bool R3D_IsBoundingBoxInFrustum(BoundingBox aabb)
 {
-	return r3d_frustum_is_bounding_box_in(&R3D.state.frustum.shape, aabb);
+	for (int i = 0; i < R3D.state.views.count; i++) {
+		if (r3d_frustum_is_bounding_box_in(&R3D.state.views.list[i].frustum, aabb)) return true;
+	}
+	return false;
+}
+
+// The scene queries run on the meshes gathered by the last 'R3D_End'
+
+R3D_RayHit R3D_Raycast(Ray ray, float maxDistance, bool precise)
+{
+	return r3d_scene_query_raycast(&R3D.container.sceneQuery, ray, maxDistance, precise);
+}
+
+int R3D_QueryAABB(BoundingBox aabb, R3D_QueryHit* hits, int maxHits)
+{
+	return r3d_scene_query_aabb(&R3D.container.sceneQuery, aabb, hits, maxHits);
 }
@@ -5,20 +5,82 @@
 #include <raymath.h>
 #include <stdlib.h>
 
+/* Helper functions */
+
+static float r3d_curve_get_tangent(const R3D_InterpolationCurve* curve, int index)
+{
+    // Catmull-Rom tangent, one-sided on the first and last keyframes
+    int prev = (index > 0) ? index - 1 : index;
+    int next = (index < (int)curve->count - 1) ? index + 1 : index;
+
+    float dt = curve->keyframes[next].time - curve->keyframes[prev].time;
+    if (dt <= 0.0f) return 0.0f;
+
+    return (curve->keyframes[next].value - curve->keyframes[prev].value) / dt;
+}
+
+static float r3d_curve_evaluate_keyframes(const R3D_InterpolationCurve* curve, float time)
+{
+    if (curve->count == 0) return 0.0f;
+    if (time <= curve->keyframes[0].time) return curve->keyframes[0].value;
+    if (time >= curve->keyframes[curve->count - 1].time) return curve->keyframes[curve->count - 1].value;
+
+    // Find the two keyframes surrounding the given time
+    for (int i = 0; i < (int)curve->count - 1; i++) {
+        const R3D_Keyframe* kf1 = &curve->keyframes[i];
+        const R3D_Keyframe* kf2 = &curve->keyframes[i + 1];
+
+        if (time >= kf1->time && time <= kf2->time) {
+            float h = kf2->time - kf1->time;
+            float t = (time - kf1->time) / h; // Normalized time between kf1 and kf2
+
+            if (curve->interpolation == R3D_CURVE_HERMITE) {
+                float m1 = r3d_curve_get_tangent(curve, i) * h;
+                float m2 = r3d_curve_get_tangent(curve, i + 1) * h;
+                float t2 = t * t;
+                float t3 = t2 * t;
+                return (2.0f * t3 - 3.0f * t2 + 1.0f) * kf1->value + (t3 - 2.0f * t2 + t) * m1
+                     + (-2.0f * t3 + 3.0f * t2) * kf2->value + (t3 - t2) * m2;
+            }
+
+            return Lerp(kf1->value, kf2->value, t);
+        }
+    }
+
+    return 0.0f; // Fallback (should not be reached)
+}
+
+static inline float r3d_curve_evaluate_lut(const float* lut, float x, float maxIndex)
+{
+    // 'x' is the position in samples, the last interval is reused for the last sample
+    // NOTE: Ternaries compile to min/max instructions, unlike 'fminf' and 'fmaxf' which handle NaN
+    x = (x > 0.0f) ? x : 0.0f;
+    x = (x < maxIndex) ? x : maxIndex;
+    float base = (x < maxIndex - 1.0f) ? x : maxIndex - 1.0f;
+    int i = (int)base;
+    float f = x - (float)i;
+    return lut[i] + (lut[i + 1] - lut[i]) * f;
+}
+
+/* Public functions */
+
 R3D_InterpolationCurve R3D_LoadInterpolationCurve(int capacity)
 {
-    R3D_InterpolationCurve curve;
+    R3D_InterpolationCurve curve = { 0 };
 
     curve.keyframes = RL_MALLOC(capacity * sizeof(R3D_Keyframe));
     curve.capacity = capacity;
     curve.count = 0;
 
+    curve.interpolation = R3D_CURVE_LINEAR;
+
     return curve;
 }
 
 void R3D_UnloadInterpolationCurve(R3D_InterpolationCurve curve)
 {
     RL_FREE(curve.keyframes);
+    RL_FREE(curve.lut);
     curve.capacity = 0;
     curve.count = 0;
 }
@@ -43,25 +105,67 @@ bool R3D_AddKeyframe(R3D_InterpolationCurve* curve, float time, float value)
     curve->capacity = (unsigned int)array.capacity;
     curve->count = (unsigned int)array.count;
 
+    // Keep the lookup table in sync with the keyframes
+    if (result == R3D_ARRAY_SUCCESS && curve->lut != NULL) {
+        R3D_BakeCurve(curve, curve->lutSize, curve->interpolation);
+    }
+
     return result == R3D_ARRAY_SUCCESS;
 }
 
 float R3D_EvaluateCurve(R3D_InterpolationCurve curve, float time)
 {
-    if (curve.count == 0) return 0.0f;
-    if (time <= curve.keyframes[0].time) return curve.keyframes[0].value;
-    if (time >= curve.keyframes[curve.count - 1].time) return curve.keyframes[curve.count - 1].value;
+    if (curve.lut != NULL) {
+        return r3d_curve_evaluate_lut(curve.lut, (time - curve.lutStart) * curve.lutScale, (float)(curve.lutSize - 1));
+    }
 
-    // Find the two keyframes surrounding the given time
-    for (int i = 0; i < (int)curve.count - 1; i++) {
-        const R3D_Keyframe* kf1 = &curve.keyframes[i];
-        const R3D_Keyframe* kf2 = &curve.keyframes[i + 1];
+    return r3d_curve_evaluate_keyframes(&curve, time);
+}
 
-        if (time >= kf1->time && time <= kf2->time) {
-            float t = (time - kf1->time) / (kf2->time - kf1->time); // Normalized time between kf1 and kf2
-            return Lerp(kf1->value, kf2->value, t);
+void R3D_BakeCurve(R3D_InterpolationCurve* curve, int resolution, R3D_CurveInterpolation interpolation)
+{
+    if (resolution < 2) resolution = 2;
+
+    curve->interpolation = interpolation;
+
+    if (curve->lut == NULL || curve->lutSize != resolution) {
+        float* lut = RL_REALLOC(curve->lut, resolution * sizeof(float));
+        if (lut == NULL) {
+            TraceLog(LOG_WARNING, "R3D: Failed to allocate the lookup table of an interpolation curve, keyframes will be evaluated directly");
+            return;
         }
+        curve->lut = lut;
+        curve->lutSize = resolution;
     }
 
-    return 0.0f; // Fallback (should not be reached)
+    float start = (curve->count > 0) ? curve->keyframes[0].time : 0.0f;
+    float end = (curve->count > 0) ? curve->keyframes[curve->count - 1].time : 0.0f;
+    float range = end - start;
+
+    for (int i = 0; i < resolution; i++) {
+        float time = start + range * (float)i / (float)(resolution - 1);
+        curve->lut[i] = r3d_curve_evaluate_keyframes(curve, time);
+    }
+
+    curve->lutStart = start;
+    curve->lutScale = (range > 0.0f) ? (float)(resolution - 1) / range : 0.0f;
+}
+
+void R3D_EvaluateCurveBatch(R3D_InterpolationCurve curve, const float* times, float* results, int count)
+{
+    if (curve.lut == NULL) {
+        for (int i = 0; i < count; i++) {
+            results[i] = r3d_curve_evaluate_keyframes(&curve, times[i]);
+        }
+        return;
+    }
+
+    const float* lut = curve.lut;
+    const float start = curve.lutStart;
+    const float scale = curve.lutScale;
+    const float maxIndex = (float)(curve.lutSize - 1);
+
+    for (int i = 0; i < count; i++) {
+        results[i] = r3d_curve_evaluate_lut(lut, (times[i] - start) * scale, maxIndex);
+    }
 }
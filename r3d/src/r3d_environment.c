@@ -77,6 +77,12 @@ void R3D_SetSSAO(bool enabled)
 		if (R3D.shader.generate.gaussianBlurDualPass.id == 0) {
 			r3d_shader_load_generate_gaussian_blur_dual_pass();
 		}
+		if (R3D.env.ssaoTemporal && R3D.shader.screen.ssaoTemporal.id == 0) {
+			r3d_shader_load_screen_ssao_temporal();
+		}
+	}
+	else if (R3D.framebuffer.pingPongSSAO.id != 0) {
+		r3d_framebuffer_unload_pingpong_ssao();
 	}
 }
 
@@ -115,6 +121,33 @@ int R3D_GetSSAOIterations(void)
 	return R3D.env.ssaoIterations;
 }
 
+void R3D_SetSSAOTemporal(bool enabled)
+{
+	if (R3D.env.ssaoTemporal == enabled) {
+		return;
+	}
+
+	R3D.env.ssaoTemporal = enabled;
+
+	if (enabled && R3D.env.ssaoEnabled && R3D.shader.screen.ssaoTemporal.id == 0) {
+		r3d_shader_load_screen_ssao_temporal();
+	}
+
+	// The accumulation buffers are only allocated in temporal mode
+	if (R3D.framebuffer.pingPongSSAO.id != 0) {
+		r3d_framebuffer_unload_pingpong_ssao();
+		r3d_framebuffer_load_pingpong_ssao(
+			R3D.state.resolution.width,
+			R3D.state.resolution.height
+		);
+	}
+}
+
+bool R3D_GetSSAOTemporal(void)
+{
+	return R3D.env.ssaoTemporal;
+}
+
 void R3D_SetBloomMode(R3D_Bloom mode)
 {
 	R3D.env.bloomMode = mode;
@@ -136,6 +169,9 @@ void R3D_SetBloomMode(R3D_Bloom mode)
 			r3d_shader_load_generate_upsampling();
 		}
 	}
+	else if (R3D.framebuffer.mipChainBloom.id != 0) {
+		r3d_framebuffer_unload_mipchain_bloom();
+	}
 }
 
 R3D_Bloom R3D_GetBloomMode(void)
@@ -165,12 +201,16 @@ int R3D_GetBloomFilterRadius(void)
 
 void R3D_SetFogMode(R3D_Fog mode)
 {
+	// The mode indexes the post-processing variants, it must stay in range
+	if ((unsigned int)mode >= R3D_SHADER_POST_FOG_VARIANTS) {
+		TraceLog(LOG_WARNING, "R3D: Invalid fog mode (%i)", (int)mode);
+		return;
+	}
+
 	R3D.env.fogMode = mode;
 
-	if (mode != R3D_FOG_DISABLED) {
-		if (R3D.shader.screen.fog.id == 0) {
-			r3d_shader_load_screen_fog();
-		}
+	if (R3D.shader.screen.post[mode][R3D.env.tonemapMode].id == 0) {
+		r3d_shader_load_screen_post(mode, R3D.env.tonemapMode);
 	}
 }
 
@@ -228,7 +268,16 @@ float R3D_GetFogDensity(void)
 
 void R3D_SetTonemapMode(R3D_Tonemap mode)
 {
+	if ((unsigned int)mode >= R3D_SHADER_POST_TONEMAP_VARIANTS) {
+		TraceLog(LOG_WARNING, "R3D: Invalid tonemap mode (%i)", (int)mode);
+		return;
+	}
+
 	R3D.env.tonemapMode = mode;
+
+	if (R3D.shader.screen.post[R3D.env.fogMode][mode].id == 0) {
+		r3d_shader_load_screen_post(R3D.env.fogMode, mode);
+	}
 }
 
 R3D_Tonemap R3D_GetTonemapMode(void)
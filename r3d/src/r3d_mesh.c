@@ -0,0 +1,634 @@
+/*
+ * Copyright (c) 2025 Le Juez Victor
+ *
+ * This software is provided "as-is", without any express or implied warranty. In no event
+ * will the authors be held liable for any damages arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose, including commercial
+ * applications, and to alter it and redistribute it freely, subject to the following restrictions:
+ *
+ *   1. The origin of this software must not be misrepresented; you must not claim that you
+ *   wrote the original software. If you use this software in a product, an acknowledgment
+ *   in the product documentation would be appreciated but is not required.
+ *
+ *   2. Altered source versions must be plainly marked as such, and must not be misrepresented
+ *   as being the original software.
+ *
+ *   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "r3d.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <raylib.h>
+#include <raymath.h>
+#include <rlgl.h>
+#include <glad.h>
+
+#include "./details/misc/r3d_half.h"
+
+/* === Internal defines === */
+
+// Post-transform cache size used by the reordering and the ACMR reports
+#define R3D_MESH_VERTEX_CACHE_SIZE 16
+
+// Must match the value raylib was built with (see raylib's 'config.h')
+#ifndef MAX_MESH_VERTEX_BUFFERS
+#   define MAX_MESH_VERTEX_BUFFERS 9
+#endif
+
+/* === Internal types === */
+
+typedef struct {
+    void** data;        // Address of the mesh attribute pointer
+    int size;           // Size of the attribute for one vertex, in bytes
+} r3d_mesh_stream_t;
+
+typedef struct {
+    float key;          // Overdraw sort key, higher clusters are drawn first
+    int start;          // First triangle of the cluster
+    int count;          // Number of triangles in the cluster
+} r3d_mesh_cluster_t;
+
+/* === Internal functions === */
+
+static int r3d_mesh_get_streams(Mesh* mesh, r3d_mesh_stream_t streams[])
+{
+    int count = 0;
+
+    if (mesh->vertices) streams[count++] = (r3d_mesh_stream_t) { (void**)&mesh->vertices, 3 * sizeof(float) };
+    if (mesh->texcoords) streams[count++] = (r3d_mesh_stream_t) { (void**)&mesh->texcoords, 2 * sizeof(float) };
+    if (mesh->texcoords2) streams[count++] = (r3d_mesh_stream_t) { (void**)&mesh->texcoords2, 2 * sizeof(float) };
+    if (mesh->normals) streams[count++] = (r3d_mesh_stream_t) { (void**)&mesh->normals, 3 * sizeof(float) };
+    if (mesh->tangents) streams[count++] = (r3d_mesh_stream_t) { (void**)&mesh->tangents, 4 * sizeof(float) };
+    if (mesh->colors) streams[count++] = (r3d_mesh_stream_t) { (void**)&mesh->colors, 4 * sizeof(unsigned char) };
+    if (mesh->animVertices) streams[count++] = (r3d_mesh_stream_t) { (void**)&mesh->animVertices, 3 * sizeof(float) };
+    if (mesh->animNormals) streams[count++] = (r3d_mesh_stream_t) { (void**)&mesh->animNormals, 3 * sizeof(float) };
+    if (mesh->boneIds) streams[count++] = (r3d_mesh_stream_t) { (void**)&mesh->boneIds, 4 * sizeof(unsigned char) };
+    if (mesh->boneWeights) streams[count++] = (r3d_mesh_stream_t) { (void**)&mesh->boneWeights, 4 * sizeof(float) };
+
+    return count;
+}
+
+static uint32_t r3d_mesh_hash_vertex(const r3d_mesh_stream_t* streams, int streamCount, int vertex)
+{
+    uint32_t hash = 2166136261u;
+
+    for (int i = 0; i < streamCount; i++) {
+        const unsigned char* bytes = (const unsigned char*)(*streams[i].data) + (size_t)vertex * streams[i].size;
+        for (int j = 0; j < streams[i].size; j++) {
+            hash = (hash ^ bytes[j]) * 16777619u;
+        }
+    }
+
+    return hash;
+}
+
+static bool r3d_mesh_compare_vertex(const r3d_mesh_stream_t* streams, int streamCount, int a, int b)
+{
+    for (int i = 0; i < streamCount; i++) {
+        const unsigned char* data = (const unsigned char*)(*streams[i].data);
+        if (memcmp(data + (size_t)a * streams[i].size, data + (size_t)b * streams[i].size, streams[i].size) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Welds identical vertices of a non-indexed mesh, writes one index per source vertex
+// and returns the number of unique vertices
+static int r3d_mesh_weld_vertices(unsigned int* indices, const r3d_mesh_stream_t* streams, int streamCount, int vertexCount)
+{
+    int tableSize = 1;
+    while (tableSize < 2 * vertexCount) tableSize <<= 1;
+
+    int* table = RL_MALLOC(tableSize * sizeof(int));
+    memset(table, -1, tableSize * sizeof(int));
+
+    int uniqueCount = 0;
+
+    for (int v = 0; v < vertexCount; v++) {
+        uint32_t slot = r3d_mesh_hash_vertex(streams, streamCount, v) & (tableSize - 1);
+        // Linear probing, the table is at most half full
+        while (table[slot] >= 0 && !r3d_mesh_compare_vertex(streams, streamCount, table[slot], v)) {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+        if (table[slot] < 0) {
+            table[slot] = v;
+            uniqueCount++;
+        }
+        indices[v] = (unsigned int)table[slot];
+    }
+
+    RL_FREE(table);
+
+    return uniqueCount;
+}
+
+static float r3d_mesh_compute_acmr(const unsigned int* indices, int indexCount, int vertexCount, int cacheSize)
+{
+    if (indexCount < 3) return 0.0f;
+
+    // FIFO cache simulation, a vertex is a hit if it was loaded less than 'cacheSize' misses ago
+    int* cacheTime = RL_CALLOC(vertexCount, sizeof(int));
+    int timeStamp = cacheSize + 1;
+    int misses = 0;
+
+    for (int i = 0; i < indexCount; i++) {
+        unsigned int v = indices[i];
+        if (timeStamp - cacheTime[v] > cacheSize) {
+            cacheTime[v] = timeStamp++;
+            misses++;
+        }
+    }
+
+    RL_FREE(cacheTime);
+
+    return (float)misses / (indexCount / 3);
+}
+
+// Tipsify, from Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"
+// Writes the reordered triangles to 'dst' and the first triangle of each cluster to 'clusters'.
+// A new cluster starts each time the walk has to jump to a vertex that is no longer in the cache.
+static int r3d_mesh_tipsify(unsigned int* dst, int* clusters, const unsigned int* indices, int indexCount, int vertexCount, int cacheSize)
+{
+    int triCount = indexCount / 3;
+
+    int* live = RL_CALLOC(vertexCount, sizeof(int));
+    int* offsets = RL_CALLOC(vertexCount + 1, sizeof(int));
+    int* adjacency = RL_MALLOC(indexCount * sizeof(int));
+    int* cacheTime = RL_CALLOC(vertexCount, sizeof(int));
+    int* deadEnd = RL_MALLOC(indexCount * sizeof(int));
+    bool* emitted = RL_CALLOC(triCount, sizeof(bool));
+
+    // Build vertex-triangle adjacency
+
+    for (int i = 0; i < indexCount; i++) {
+        live[indices[i]]++;
+    }
+
+    for (int v = 0; v < vertexCount; v++) {
+        offsets[v + 1] = offsets[v] + live[v];
+    }
+
+    for (int i = 0; i < indexCount; i++) {
+        unsigned int v = indices[i];
+        adjacency[offsets[v] + cacheTime[v]++] = i / 3;
+    }
+
+    memset(cacheTime, 0, vertexCount * sizeof(int));
+
+    // Walk the mesh by fanning around vertices
+
+    int timeStamp = cacheSize + 1;
+    int deadEndTop = 0;
+    int cursor = 0;
+    int outTri = 0;
+    int clusterCount = 0;
+    bool newCluster = true;
+
+    while (cursor < vertexCount && live[cursor] == 0) cursor++;
+    int fanning = (cursor < vertexCount) ? cursor : -1;
+
+    while (fanning >= 0) {
+        if (newCluster) {
+            clusters[clusterCount++] = outTri;
+            newCluster = false;
+        }
+
+        int candidates = deadEndTop;
+
+        for (int i = offsets[fanning]; i < offsets[fanning + 1]; i++) {
+            int t = adjacency[i];
+            if (emitted[t]) continue;
+            for (int c = 0; c < 3; c++) {
+                unsigned int v = indices[3 * t + c];
+                dst[3 * outTri + c] = v;
+                deadEnd[deadEndTop++] = v;
+                live[v]--;
+                if (timeStamp - cacheTime[v] > cacheSize) {
+                    cacheTime[v] = timeStamp++;
+                }
+            }
+            emitted[t] = true;
+            outTri++;
+        }
+
+        // Pick the next fanning vertex among the 1-ring of the current one,
+        // favoring vertices that will still be in the cache once all their triangles are emitted
+        int next = -1, bestPriority = -1;
+        for (int i = candidates; i < deadEndTop; i++) {
+            int v = deadEnd[i];
+            if (live[v] <= 0) continue;
+            int priority = 0;
+            if (timeStamp - cacheTime[v] + 2 * live[v] <= cacheSize) {
+                priority = timeStamp - cacheTime[v];
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = v;
+            }
+        }
+
+        // Dead end, go back to a recently used vertex, or scan for any live one
+        if (next < 0) {
+            while (deadEndTop > 0) {
+                int v = deadEnd[--deadEndTop];
+                if (live[v] > 0) {
+                    next = v;
+                    break;
+                }
+            }
+            if (next < 0) {
+                while (cursor < vertexCount && live[cursor] == 0) cursor++;
+                next = (cursor < vertexCount) ? cursor : -1;
+            }
+            if (next >= 0 && timeStamp - cacheTime[next] > cacheSize) {
+                newCluster = true;
+            }
+        }
+
+        fanning = next;
+    }
+
+    RL_FREE(live);
+    RL_FREE(offsets);
+    RL_FREE(adjacency);
+    RL_FREE(cacheTime);
+    RL_FREE(deadEnd);
+    RL_FREE(emitted);
+
+    return clusterCount;
+}
+
+static int r3d_mesh_cluster_compare(const void* a, const void* b)
+{
+    float ka = ((const r3d_mesh_cluster_t*)a)->key;
+    float kb = ((const r3d_mesh_cluster_t*)b)->key;
+    return (ka < kb) - (ka > kb);
+}
+
+// Sorts clusters so that those facing outward from the mesh centroid are drawn first,
+// which statistically occludes the inner ones (view-independent overdraw reduction)
+static void r3d_mesh_sort_clusters(unsigned int* indices, const int* clusterStarts, int clusterCount, int indexCount, const float* positions)
+{
+    int triCount = indexCount / 3;
+
+    r3d_mesh_cluster_t* clusters = RL_MALLOC(clusterCount * sizeof(r3d_mesh_cluster_t));
+
+    Vector3 meshCentroid = { 0 };
+    float meshArea = 0.0f;
+
+    Vector3* centroids = RL_MALLOC(clusterCount * sizeof(Vector3));
+    Vector3* normals = RL_MALLOC(clusterCount * sizeof(Vector3));
+
+    for (int c = 0; c < clusterCount; c++) {
+        int start = clusterStarts[c];
+        int end = (c + 1 < clusterCount) ? clusterStarts[c + 1] : triCount;
+
+        Vector3 centroid = { 0 };
+        Vector3 normal = { 0 };
+        float area = 0.0f;
+
+        for (int t = start; t < end; t++) {
+            const float* p0 = &positions[3 * indices[3 * t + 0]];
+            const float* p1 = &positions[3 * indices[3 * t + 1]];
+            const float* p2 = &positions[3 * indices[3 * t + 2]];
+
+            Vector3 e0 = { p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2] };
+            Vector3 e1 = { p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2] };
+            Vector3 n = Vector3CrossProduct(e0, e1);
+            float a = Vector3Length(n);
+
+            Vector3 center = {
+                (p0[0] + p1[0] + p2[0]) / 3.0f,
+                (p0[1] + p1[1] + p2[1]) / 3.0f,
+                (p0[2] + p1[2] + p2[2]) / 3.0f
+            };
+
+            centroid = Vector3Add(centroid, Vector3Scale(center, a));
+            normal = Vector3Add(normal, n);
+            area += a;
+        }
+
+        meshCentroid = Vector3Add(meshCentroid, centroid);
+        meshArea += area;
+
+        centroids[c] = (area > 0.0f) ? Vector3Scale(centroid, 1.0f / area) : centroid;
+        normals[c] = Vector3Normalize(normal);
+
+        clusters[c].start = start;
+        clusters[c].count = end - start;
+    }
+
+    if (meshArea > 0.0f) {
+        meshCentroid = Vector3Scale(meshCentroid, 1.0f / meshArea);
+    }
+
+    for (int c = 0; c < clusterCount; c++) {
+        clusters[c].key = Vector3DotProduct(Vector3Subtract(centroids[c], meshCentroid), normals[c]);
+    }
+
+    qsort(clusters, clusterCount, sizeof(r3d_mesh_cluster_t), r3d_mesh_cluster_compare);
+
+    unsigned int* sorted = RL_MALLOC(indexCount * sizeof(unsigned int));
+
+    for (int c = 0, offset = 0; c < clusterCount; c++) {
+        memcpy(sorted + offset, indices + 3 * clusters[c].start, 3 * clusters[c].count * sizeof(unsigned int));
+        offset += 3 * clusters[c].count;
+    }
+
+    memcpy(indices, sorted, indexCount * sizeof(unsigned int));
+
+    RL_FREE(sorted);
+    RL_FREE(centroids);
+    RL_FREE(normals);
+    RL_FREE(clusters);
+}
+
+// Renumbers vertices in order of first use and drops unreferenced ones,
+// returns the new vertex count
+static int r3d_mesh_remap_vertices(unsigned int* indices, int indexCount, r3d_mesh_stream_t* streams, int streamCount, int vertexCount)
+{
+    int* remap = RL_MALLOC(vertexCount * sizeof(int));
+    memset(remap, -1, vertexCount * sizeof(int));
+
+    int newCount = 0;
+
+    for (int i = 0; i < indexCount; i++) {
+        unsigned int v = indices[i];
+        if (remap[v] < 0) remap[v] = newCount++;
+        indices[i] = (unsigned int)remap[v];
+    }
+
+    for (int i = 0; i < streamCount; i++) {
+        unsigned char* src = *streams[i].data;
+        unsigned char* dst = RL_MALLOC((size_t)newCount * streams[i].size);
+        for (int v = 0; v < vertexCount; v++) {
+            if (remap[v] < 0) continue;
+            memcpy(dst + (size_t)remap[v] * streams[i].size, src + (size_t)v * streams[i].size, streams[i].size);
+        }
+        RL_FREE(src);
+        *streams[i].data = dst;
+    }
+
+    RL_FREE(remap);
+
+    return newCount;
+}
+
+static void r3d_mesh_reupload(Mesh* mesh)
+{
+    rlUnloadVertexArray(mesh->vaoId);
+
+    if (mesh->vboId != NULL) {
+        for (int i = 0; i < MAX_MESH_VERTEX_BUFFERS; i++) {
+            rlUnloadVertexBuffer(mesh->vboId[i]);
+        }
+        RL_FREE(mesh->vboId);
+    }
+
+    mesh->vaoId = 0;
+    mesh->vboId = NULL;
+
+    UploadMesh(mesh, false);
+}
+
+// Replaces the GPU copies of normals and tangents with normalized bytes, texture
+// coordinates and optionally positions with half floats; CPU arrays are left untouched
+static void r3d_mesh_quantize(Mesh* mesh, bool positions)
+{
+    int count = mesh->vertexCount;
+
+    glBindVertexArray(mesh->vaoId);
+
+    if (positions) {
+        BoundingBox bounds = GetMeshBoundingBox(*mesh);
+        Vector3 size = Vector3Subtract(bounds.max, bounds.min);
+        float extent = fmaxf(size.x, fmaxf(size.y, size.z));
+        float reach = fmaxf(Vector3Length(bounds.min), Vector3Length(bounds.max));
+
+        // Half floats keep 11 significant bits, the rounding error is about 'reach / 2048'
+        // so limiting the reach to twice the size keeps it below 1/1024 of the mesh
+        if (reach > 2.0f * extent || reach > 65504.0f) {
+            TraceLog(LOG_WARNING, "R3D: Keeping float positions for a mesh too far from its origin to quantize them");
+        }
+        else {
+            r3d_half_t* packed = RL_MALLOC(4 * count * sizeof(r3d_half_t));
+            for (int i = 0; i < count; i++) {
+                for (int c = 0; c < 3; c++) {
+                    packed[4 * i + c] = r3d_cvt_fh(mesh->vertices[3 * i + c]);
+                }
+                packed[4 * i + 3] = 0;
+            }
+            glBindBuffer(GL_ARRAY_BUFFER, mesh->vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION]);
+            glBufferData(GL_ARRAY_BUFFER, 4 * count * sizeof(r3d_half_t), packed, GL_STATIC_DRAW);
+            glVertexAttribPointer(RL_DEFAULT_SHADER_ATTRIB_LOCATION_POSITION, 3, GL_HALF_FLOAT, GL_FALSE, 4 * sizeof(r3d_half_t), 0);
+            RL_FREE(packed);
+        }
+    }
+
+    if (mesh->normals != NULL) {
+        int8_t* packed = RL_MALLOC(4 * count);
+        for (int i = 0; i < count; i++) {
+            for (int c = 0; c < 3; c++) {
+                packed[4 * i + c] = (int8_t)roundf(Clamp(mesh->normals[3 * i + c], -1.0f, 1.0f) * 127.0f);
+            }
+            packed[4 * i + 3] = 0;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, mesh->vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL]);
+        glBufferData(GL_ARRAY_BUFFER, 4 * count, packed, GL_STATIC_DRAW);
+        glVertexAttribPointer(RL_DEFAULT_SHADER_ATTRIB_LOCATION_NORMAL, 3, GL_BYTE, GL_TRUE, 4, 0);
+        RL_FREE(packed);
+    }
+
+    if (mesh->tangents != NULL) {
+        int8_t* packed = RL_MALLOC(4 * count);
+        for (int i = 0; i < 4 * count; i++) {
+            packed[i] = (int8_t)roundf(Clamp(mesh->tangents[i], -1.0f, 1.0f) * 127.0f);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, mesh->vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_TANGENT]);
+        glBufferData(GL_ARRAY_BUFFER, 4 * count, packed, GL_STATIC_DRAW);
+        glVertexAttribPointer(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TANGENT, 4, GL_BYTE, GL_TRUE, 4, 0);
+        RL_FREE(packed);
+    }
+
+    if (mesh->texcoords != NULL) {
+        r3d_half_t* packed = RL_MALLOC(2 * count * sizeof(r3d_half_t));
+        for (int i = 0; i < 2 * count; i++) {
+            packed[i] = r3d_cvt_fh(mesh->texcoords[i]);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, mesh->vboId[RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD]);
+        glBufferData(GL_ARRAY_BUFFER, 2 * count * sizeof(r3d_half_t), packed, GL_STATIC_DRAW);
+        glVertexAttribPointer(RL_DEFAULT_SHADER_ATTRIB_LOCATION_TEXCOORD, 2, GL_HALF_FLOAT, GL_FALSE, 0, 0);
+        RL_FREE(packed);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+/* === Public functions === */
+
+float R3D_GetMeshACMR(Mesh mesh, int cacheSize)
+{
+    if (mesh.vertexCount <= 0 || cacheSize <= 0) {
+        return 0.0f;
+    }
+
+    int indexCount = (mesh.indices != NULL) ? 3 * mesh.triangleCount : mesh.vertexCount;
+    unsigned int* indices = RL_MALLOC(indexCount * sizeof(unsigned int));
+
+    for (int i = 0; i < indexCount; i++) {
+        indices[i] = (mesh.indices != NULL) ? mesh.indices[i] : (unsigned int)i;
+    }
+
+    float acmr = r3d_mesh_compute_acmr(indices, indexCount, mesh.vertexCount, cacheSize);
+
+    RL_FREE(indices);
+
+    return acmr;
+}
+
+bool R3D_OptimizeMesh(Mesh* mesh, R3D_MeshOptimizeFlags flags, R3D_MeshOptimizeStats* stats)
+{
+    if (mesh->vertices == NULL || mesh->vertexCount < 3) {
+        TraceLog(LOG_WARNING, "R3D: Cannot optimize a mesh without CPU vertex data");
+        return false;
+    }
+
+    r3d_mesh_stream_t streams[16];
+    int streamCount = r3d_mesh_get_streams(mesh, streams);
+
+    int vertexCount = mesh->vertexCount;
+    int indexCount = (mesh->indices != NULL) ? 3 * mesh->triangleCount : vertexCount - vertexCount % 3;
+    unsigned int* indices = RL_MALLOC(indexCount * sizeof(unsigned int));
+
+    float acmrBefore = 0.0f;
+    bool remap = (flags & R3D_MESH_OPTIMIZE_VERTEX_FETCH) != 0;
+
+    // Work on 32-bit indices, welding non-indexed meshes first
+
+    if (mesh->indices != NULL) {
+        for (int i = 0; i < indexCount; i++) {
+            indices[i] = mesh->indices[i];
+        }
+        acmrBefore = r3d_mesh_compute_acmr(indices, indexCount, vertexCount, R3D_MESH_VERTEX_CACHE_SIZE);
+    }
+    else {
+        for (int i = 0; i < indexCount; i++) {
+            indices[i] = (unsigned int)i;
+        }
+        acmrBefore = r3d_mesh_compute_acmr(indices, indexCount, vertexCount, R3D_MESH_VERTEX_CACHE_SIZE);
+        int uniqueCount = r3d_mesh_weld_vertices(indices, streams, streamCount, indexCount);
+        if (uniqueCount > 0xFFFF) {
+            TraceLog(LOG_WARNING, "R3D: Cannot optimize mesh; %i unique vertices exceed the 16-bit index range", uniqueCount);
+            RL_FREE(indices);
+            return false;
+        }
+        remap = true; // Duplicates must be dropped
+    }
+
+    // Reorder triangles for the post-transform cache, then sort clusters for overdraw
+
+    int clusterCount = 0;
+
+    if (flags & (R3D_MESH_OPTIMIZE_VERTEX_CACHE | R3D_MESH_OPTIMIZE_OVERDRAW)) {
+        unsigned int* reordered = RL_MALLOC(indexCount * sizeof(unsigned int));
+        int* clusters = RL_MALLOC((indexCount / 3 + 1) * sizeof(int));
+        clusterCount = r3d_mesh_tipsify(reordered, clusters, indices, indexCount, vertexCount, R3D_MESH_VERTEX_CACHE_SIZE);
+        if (flags & R3D_MESH_OPTIMIZE_OVERDRAW) {
+            r3d_mesh_sort_clusters(reordered, clusters, clusterCount, indexCount, mesh->vertices);
+        }
+        RL_FREE(indices);
+        RL_FREE(clusters);
+        indices = reordered;
+    }
+
+    // Renumber vertices in fetch order
+
+    if (remap) {
+        vertexCount = r3d_mesh_remap_vertices(indices, indexCount, streams, streamCount, vertexCount);
+    }
+
+    float acmrAfter = r3d_mesh_compute_acmr(indices, indexCount, vertexCount, R3D_MESH_VERTEX_CACHE_SIZE);
+
+    // Write back CPU data
+
+    if (mesh->indices == NULL || indexCount != 3 * mesh->triangleCount) {
+        RL_FREE(mesh->indices);
+        mesh->indices = RL_MALLOC(indexCount * sizeof(unsigned short));
+    }
+
+    for (int i = 0; i < indexCount; i++) {
+        mesh->indices[i] = (unsigned short)indices[i];
+    }
+
+    RL_FREE(indices);
+
+    if (stats != NULL) {
+        stats->acmrBefore = acmrBefore;
+        stats->acmrAfter = acmrAfter;
+        stats->vertexCountBefore = mesh->vertexCount;
+        stats->vertexCountAfter = vertexCount;
+        stats->clusterCount = clusterCount;
+    }
+
+    mesh->vertexCount = vertexCount;
+    mesh->triangleCount = indexCount / 3;
+
+    // Update GPU buffers if the mesh was already uploaded
+
+    if (mesh->vaoId > 0) {
+        r3d_mesh_reupload(mesh);
+        if (flags & R3D_MESH_OPTIMIZE_QUANTIZE) {
+            if (mesh->animNormals != NULL || mesh->boneIds != NULL) {
+                TraceLog(LOG_WARNING, "R3D: Skipping quantization of an animated mesh; its buffers are updated as floats");
+            }
+            else {
+                r3d_mesh_quantize(mesh, (flags & R3D_MESH_OPTIMIZE_QUANTIZE_POSITIONS) != 0);
+            }
+        }
+    }
+    else if (flags & R3D_MESH_OPTIMIZE_QUANTIZE) {
+        TraceLog(LOG_WARNING, "R3D: Quantization requires the mesh to be uploaded to the GPU");
+    }
+
+    return true;
+}
+
+void R3D_OptimizeModel(Model* model, R3D_MeshOptimizeFlags flags, R3D_MeshOptimizeStats* stats)
+{
+    R3D_MeshOptimizeStats total = { 0 };
+    int totalTriangles = 0;
+
+    for (int i = 0; i < model->meshCount; i++) {
+        R3D_MeshOptimizeStats meshStats = { 0 };
+        if (!R3D_OptimizeMesh(&model->meshes[i], flags, &meshStats)) {
+            continue;
+        }
+        int triangles = model->meshes[i].triangleCount;
+        total.acmrBefore += meshStats.acmrBefore * triangles;
+        total.acmrAfter += meshStats.acmrAfter * triangles;
+        total.vertexCountBefore += meshStats.vertexCountBefore;
+        total.vertexCountAfter += meshStats.vertexCountAfter;
+        total.clusterCount += meshStats.clusterCount;
+        totalTriangles += triangles;
+    }
+
+    if (totalTriangles > 0) {
+        total.acmrBefore /= totalTriangles;
+        total.acmrAfter /= totalTriangles;
+    }
+
+    TraceLog(LOG_INFO, "R3D: Model optimized; ACMR %.3f -> %.3f, vertices %i -> %i",
+        total.acmrBefore, total.acmrAfter, total.vertexCountBefore, total.vertexCountAfter);
+
+    if (stats != NULL) {
+        *stats = total;
+    }
+}
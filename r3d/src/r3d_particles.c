@@ -1,106 +1,448 @@
 #include "r3d.h"
+#include "./r3d_state.h"
 
 #include <math.h>
 #include <float.h>
 #include <limits.h>
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
 #include <raylib.h>
 #include <raymath.h>
+#include <glad.h>
+
+#include "./details/misc/r3d_simd.h"
+#include "./details/misc/r3d_hash.h"
+#include "./details/misc/r3d_random.h"
+#include "./details/r3d_jobs.h"
+
+/* Defines */
+
+#ifndef R3D_PARTICLE_CHUNK_SIZE
+#   define R3D_PARTICLE_CHUNK_SIZE 4096    //< Particles per update job, must be a multiple of 8
+#endif
+
+#define R3D_PARTICLE_EMIT_BATCH 128         //< Particles whose random values are generated together
+#define R3D_PARTICLE_EMIT_RANDOMS 17        //< Random values consumed by each emitted particle
+
+#define R3D_PARTICLE_CURVE_BATCH 256        //< Particles whose curves are evaluated together
+
+#define R3D_PARTICLE_BOUNDS_MAX_STEP 0.1f   //< Largest update step covered by the analytic bounds, in seconds
+
+#define R3D_PARTICLE_GPU_CURVE_SIZE 256     //< Samples per lifetime curve in the GPU curve texture
+
+/* Types */
+
+typedef struct {
+    R3D_ParticleSystem* system;
+    int start;
+    int end;
+    int alive;
+    Vector3 boundsMin;
+    Vector3 boundsMax;
+} r3d_particle_chunk_t;
+
+typedef struct {
+    r3d_particle_chunk_t* chunks;
+    float deltaTime;
+} r3d_particle_update_t;
+
+typedef struct {
+    Vector3 direction;
+    Vector3 binormal;
+    Vector3 normal;
+    float speed;
+} r3d_particle_emitter_t;
 
 /* Helper functions */
 
-static float r3d_randf(void)
+static float r3d_lerp_rand(float min, float max, float rand)
 {
-    static const float INV_65535 = 1.0f / 0xFFFF;
-    return (float)GetRandomValue(0, 0xFFFF) * INV_65535;
+    return min + rand * (max - min);
 }
 
-static float r3d_randf_range(float min, float max)
+static unsigned char r3d_vary_channel(unsigned char base, unsigned char variance, float rand)
 {
-    return min + r3d_randf() * (max - min);
+    // Uniform integer offset in [-variance, variance]
+    int offset = (int)(rand * (2 * variance + 1)) - variance;
+    if (offset > variance) offset = variance;
+    return (unsigned char)(base + offset);
 }
 
-static float r3d_min3f(float a, float b, float c)
+static void r3d_curve_get_range(const R3D_InterpolationCurve* curve, float* min, float* max)
 {
-    float min = a;
-    if (b < min) min = b;
-    if (c < min) min = c;
-    return min;
+    // Baked samples are linearly interpolated, as are unbaked keyframes, the curve never leaves their value range
+    if (curve->lut != NULL) {
+        *min = *max = curve->lut[0];
+        for (int i = 1; i < curve->lutSize; i++) {
+            *min = fminf(*min, curve->lut[i]);
+            *max = fmaxf(*max, curve->lut[i]);
+        }
+        return;
+    }
+
+    *min = *max = (curve->count > 0) ? curve->keyframes[0].value : 0.0f;
+
+    for (unsigned int i = 1; i < curve->count; i++) {
+        *min = fminf(*min, curve->keyframes[i].value);
+        *max = fmaxf(*max, curve->keyframes[i].value);
+    }
 }
 
-static float r3d_max3f(float a, float b, float c)
+/* SoA storage functions */
+
+#define R3D_PARTICLE_SOA_FLOAT_ARRAYS 25
+
+static void r3d_particles_soa_get_float_arrays(R3D_ParticleArrays* arrays, float** out[R3D_PARTICLE_SOA_FLOAT_ARRAYS])
 {
-    float max = a;
-    if (b > max) max = b;
-    if (c > max) max = c;
-    return max;
+    float** fields[R3D_PARTICLE_SOA_FLOAT_ARRAYS] = {
+        &arrays->lifetime,
+        &arrays->positionX, &arrays->positionY, &arrays->positionZ,
+        &arrays->rotationX, &arrays->rotationY, &arrays->rotationZ,
+        &arrays->scaleX, &arrays->scaleY, &arrays->scaleZ,
+        &arrays->velocityX, &arrays->velocityY, &arrays->velocityZ,
+        &arrays->angularVelocityX, &arrays->angularVelocityY, &arrays->angularVelocityZ,
+        &arrays->baseScaleX, &arrays->baseScaleY, &arrays->baseScaleZ,
+        &arrays->baseVelocityX, &arrays->baseVelocityY, &arrays->baseVelocityZ,
+        &arrays->baseAngularVelocityX, &arrays->baseAngularVelocityY, &arrays->baseAngularVelocityZ
+    };
+
+    memcpy(out, fields, sizeof(fields));
 }
 
-/* Public functions */
+static bool r3d_particles_soa_alloc(R3D_ParticleArrays* arrays, int capacity)
+{
+    // Capacity is padded so the kernels can always process full vectors, 8 being the widest
+    size_t padded = (size_t)((capacity + 7) & ~7);
+    size_t floatBytes = padded * sizeof(float);
 
-R3D_ParticleSystem R3D_LoadParticleSystem(int maxParticles)
+    size_t total = R3D_SIMD_ALIGNMENT
+        + R3D_PARTICLE_SOA_FLOAT_ARRAYS * floatBytes
+        + padded * sizeof(Matrix)
+        + padded * sizeof(Color)
+        + padded * sizeof(unsigned char);
+
+    unsigned char* memory = RL_CALLOC(total, 1);
+    if (memory == NULL) return false;
+
+    // Each float array size is a multiple of 32 bytes, aligning the first one aligns them all
+    unsigned char* ptr = (unsigned char*)(((size_t)memory + R3D_SIMD_ALIGNMENT - 1) & ~(size_t)(R3D_SIMD_ALIGNMENT - 1));
+
+    float** fields[R3D_PARTICLE_SOA_FLOAT_ARRAYS];
+    r3d_particles_soa_get_float_arrays(arrays, fields);
+
+    for (int i = 0; i < R3D_PARTICLE_SOA_FLOAT_ARRAYS; i++) {
+        *fields[i] = (float*)ptr;
+        ptr += floatBytes;
+    }
+
+    arrays->transforms = (Matrix*)ptr;
+    ptr += padded * sizeof(Matrix);
+
+    arrays->colors = (Color*)ptr;
+    ptr += padded * sizeof(Color);
+
+    arrays->baseOpacity = ptr;
+    arrays->memory = memory;
+
+    return true;
+}
+
+static void r3d_particles_soa_write(R3D_ParticleArrays* arrays, int index, const R3D_Particle* particle)
 {
-    R3D_ParticleSystem system = { 0 };
+    arrays->lifetime[index] = particle->lifetime;
 
-    system.particles = RL_MALLOC(sizeof(R3D_Particle) * maxParticles);
-    system.capacity = maxParticles;
-    system.count = 0;
+    arrays->positionX[index] = particle->position.x;
+    arrays->positionY[index] = particle->position.y;
+    arrays->positionZ[index] = particle->position.z;
 
-    system.position = (Vector3){ 0, 0, 0 };
-    system.gravity = (Vector3){ 0, -9.81f, 0 };
+    arrays->rotationX[index] = particle->rotation.x;
+    arrays->rotationY[index] = particle->rotation.y;
+    arrays->rotationZ[index] = particle->rotation.z;
 
-    system.initialScale = Vector3One();
-    system.scaleVariance = 0.0f;
+    arrays->scaleX[index] = particle->scale.x;
+    arrays->scaleY[index] = particle->scale.y;
+    arrays->scaleZ[index] = particle->scale.z;
 
-    system.initialRotation = Vector3Zero();
-    system.rotationVariance = Vector3Zero();
+    arrays->velocityX[index] = particle->velocity.x;
+    arrays->velocityY[index] = particle->velocity.y;
+    arrays->velocityZ[index] = particle->velocity.z;
 
-    system.initialColor = WHITE;
-    system.colorVariance = BLANK;
+    arrays->angularVelocityX[index] = particle->angularVelocity.x;
+    arrays->angularVelocityY[index] = particle->angularVelocity.y;
+    arrays->angularVelocityZ[index] = particle->angularVelocity.z;
 
-    system.initialVelocity = (Vector3){ 0, 0, 0 };
-    system.velocityVariance = Vector3Zero();
+    arrays->baseScaleX[index] = particle->baseScale.x;
+    arrays->baseScaleY[index] = particle->baseScale.y;
+    arrays->baseScaleZ[index] = particle->baseScale.z;
 
-    system.initialAngularVelocity = Vector3Zero();
-    system.angularVelocityVariance = Vector3Zero();
+    arrays->baseVelocityX[index] = particle->baseVelocity.x;
+    arrays->baseVelocityY[index] = particle->baseVelocity.y;
+    arrays->baseVelocityZ[index] = particle->baseVelocity.z;
 
-    system.lifetime = 1.0f;
-    system.lifetimeVariance = 0.0f;
+    arrays->baseAngularVelocityX[index] = particle->baseAngularVelocity.x;
+    arrays->baseAngularVelocityY[index] = particle->baseAngularVelocity.y;
+    arrays->baseAngularVelocityZ[index] = particle->baseAngularVelocity.z;
 
-    system.emissionTimer = 0.0f;
-    system.emissionRate = 1.0f;
-    system.spreadAngle = 0.0f;
+    arrays->baseOpacity[index] = particle->baseOpacity;
+    arrays->colors[index] = particle->color;
+    arrays->transforms[index] = particle->transform;
+}
 
-    system.scaleOverLifetime = NULL;
-    system.speedOverLifetime = NULL;
-    system.opacityOverLifetime = NULL;
-    system.angularVelocityOverLifetime = NULL;
+static void r3d_particles_soa_move(R3D_ParticleArrays* arrays, int src, int dst)
+{
+    float** fields[R3D_PARTICLE_SOA_FLOAT_ARRAYS];
+    r3d_particles_soa_get_float_arrays(arrays, fields);
 
-    system.autoEmission = true;
+    for (int i = 0; i < R3D_PARTICLE_SOA_FLOAT_ARRAYS; i++) {
+        (*fields[i])[dst] = (*fields[i])[src];
+    }
 
-    return system;
+    arrays->baseOpacity[dst] = arrays->baseOpacity[src];
+    arrays->colors[dst] = arrays->colors[src];
+    arrays->transforms[dst] = arrays->transforms[src];
 }
 
-void R3D_UnloadParticleSystem(R3D_ParticleSystem* system)
+static void r3d_particles_soa_apply_curves(R3D_ParticleSystem* system, int start, int end)
 {
-    if (system) {
-        RL_FREE(system->particles);
+    R3D_ParticleArrays* arrays = &system->arrays;
+
+    float times[R3D_PARTICLE_CURVE_BATCH];
+    float scales[R3D_PARTICLE_CURVE_BATCH];
+
+    for (int base = start; base < end; base += R3D_PARTICLE_CURVE_BATCH) {
+        int count = (end - base < R3D_PARTICLE_CURVE_BATCH) ? end - base : R3D_PARTICLE_CURVE_BATCH;
+
+        for (int i = 0; i < count; i++) {
+            times[i] = 1.0f - (arrays->lifetime[base + i] / system->lifetime);
+        }
+
+        if (system->scaleOverLifetime) {
+            R3D_EvaluateCurveBatch(*system->scaleOverLifetime, times, scales, count);
+            for (int i = 0; i < count; i++) {
+                arrays->scaleX[base + i] = arrays->baseScaleX[base + i] * scales[i];
+                arrays->scaleY[base + i] = arrays->baseScaleY[base + i] * scales[i];
+                arrays->scaleZ[base + i] = arrays->baseScaleZ[base + i] * scales[i];
+            }
+        }
+
+        if (system->opacityOverLifetime) {
+            R3D_EvaluateCurveBatch(*system->opacityOverLifetime, times, scales, count);
+            for (int i = 0; i < count; i++) {
+                arrays->colors[base + i].a = (unsigned char)Clamp(arrays->baseOpacity[base + i] * scales[i], 0.0f, 255.0f);
+            }
+        }
+
+        if (system->speedOverLifetime) {
+            R3D_EvaluateCurveBatch(*system->speedOverLifetime, times, scales, count);
+            for (int i = 0; i < count; i++) {
+                arrays->velocityX[base + i] = arrays->baseVelocityX[base + i] * scales[i];
+                arrays->velocityY[base + i] = arrays->baseVelocityY[base + i] * scales[i];
+                arrays->velocityZ[base + i] = arrays->baseVelocityZ[base + i] * scales[i];
+            }
+        }
+
+        if (system->angularVelocityOverLifetime) {
+            R3D_EvaluateCurveBatch(*system->angularVelocityOverLifetime, times, scales, count);
+            for (int i = 0; i < count; i++) {
+                arrays->angularVelocityX[base + i] = arrays->baseAngularVelocityX[base + i] * scales[i];
+                arrays->angularVelocityY[base + i] = arrays->baseAngularVelocityY[base + i] * scales[i];
+                arrays->angularVelocityZ[base + i] = arrays->baseAngularVelocityZ[base + i] * scales[i];
+            }
+        }
     }
 }
 
-bool R3D_EmitParticle(R3D_ParticleSystem* system)
+static void r3d_particles_soa_get_bounds(const R3D_ParticleArrays* arrays, int start, int end, Vector3* outMin, Vector3* outMax)
+{
+    r3d_simd_t minX = r3d_simd_set1(FLT_MAX), maxX = r3d_simd_set1(-FLT_MAX);
+    r3d_simd_t minY = minX, maxY = maxX;
+    r3d_simd_t minZ = minX, maxZ = maxX;
+
+    int i = start;
+    for (; i + R3D_SIMD_WIDTH <= end; i += R3D_SIMD_WIDTH) {
+        r3d_simd_t x = r3d_simd_load(arrays->positionX + i);
+        r3d_simd_t y = r3d_simd_load(arrays->positionY + i);
+        r3d_simd_t z = r3d_simd_load(arrays->positionZ + i);
+        minX = r3d_simd_min(minX, x); maxX = r3d_simd_max(maxX, x);
+        minY = r3d_simd_min(minY, y); maxY = r3d_simd_max(maxY, y);
+        minZ = r3d_simd_min(minZ, z); maxZ = r3d_simd_max(maxZ, z);
+    }
+
+    union {
+        r3d_simd_t v[6];
+        float f[6][R3D_SIMD_WIDTH];
+    } lanes = { { minX, minY, minZ, maxX, maxY, maxZ } };
+
+    Vector3 min = { FLT_MAX, FLT_MAX, FLT_MAX };
+    Vector3 max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (int l = 0; l < R3D_SIMD_WIDTH; l++) {
+        min.x = fminf(min.x, lanes.f[0][l]); max.x = fmaxf(max.x, lanes.f[3][l]);
+        min.y = fminf(min.y, lanes.f[1][l]); max.y = fmaxf(max.y, lanes.f[4][l]);
+        min.z = fminf(min.z, lanes.f[2][l]); max.z = fmaxf(max.z, lanes.f[5][l]);
+    }
+
+    // Remaining particles that do not fill a whole vector
+    for (; i < end; i++) {
+        min.x = fminf(min.x, arrays->positionX[i]); max.x = fmaxf(max.x, arrays->positionX[i]);
+        min.y = fminf(min.y, arrays->positionY[i]); max.y = fmaxf(max.y, arrays->positionY[i]);
+        min.z = fminf(min.z, arrays->positionZ[i]); max.z = fmaxf(max.z, arrays->positionZ[i]);
+    }
+
+    *outMin = min;
+    *outMax = max;
+}
+
+static int r3d_particles_soa_update_range(R3D_ParticleSystem* system, int start, int end, float deltaTime)
 {
-    if (system->count >= system->capacity) {
-        return false;
+    R3D_ParticleArrays* arrays = &system->arrays;
+
+    // Compact the live particles at the front of the range so that the kernel only runs on them
+    int alive = start;
+    for (int i = start; i < end; i++) {
+        arrays->lifetime[i] -= deltaTime;
+        if (arrays->lifetime[i] > 0.0f) {
+            if (alive != i) r3d_particles_soa_move(arrays, i, alive);
+            alive++;
+        }
+    }
+    end = alive;
+
+    bool hasCurves = system->scaleOverLifetime || system->opacityOverLifetime
+        || system->speedOverLifetime || system->angularVelocityOverLifetime;
+
+    if (hasCurves) {
+        r3d_particles_soa_apply_curves(system, start, end);
+    }
+
+    const r3d_simd_t zero = r3d_simd_set1(0.0f);
+    const r3d_simd_t dt = r3d_simd_set1(deltaTime);
+    const r3d_simd_t dtRad = r3d_simd_set1(deltaTime * DEG2RAD);
+    const r3d_simd_t gx = r3d_simd_set1(system->gravity.x * deltaTime);
+    const r3d_simd_t gy = r3d_simd_set1(system->gravity.y * deltaTime);
+    const r3d_simd_t gz = r3d_simd_set1(system->gravity.z * deltaTime);
+
+    // NOTE: The last vector may read and write lanes past the live particles, they
+    //       stay inside the range since its start and size are multiples of the width
+    for (int i = start; i < end; i += R3D_SIMD_WIDTH) {
+        // Integrate rotation
+        r3d_simd_t rx = r3d_simd_load(arrays->rotationX + i);
+        r3d_simd_t ry = r3d_simd_load(arrays->rotationY + i);
+        r3d_simd_t rz = r3d_simd_load(arrays->rotationZ + i);
+
+        rx = r3d_simd_add(rx, r3d_simd_mul(r3d_simd_load(arrays->angularVelocityX + i), dtRad));
+        ry = r3d_simd_add(ry, r3d_simd_mul(r3d_simd_load(arrays->angularVelocityY + i), dtRad));
+        rz = r3d_simd_add(rz, r3d_simd_mul(r3d_simd_load(arrays->angularVelocityZ + i), dtRad));
+
+        r3d_simd_store(arrays->rotationX + i, rx);
+        r3d_simd_store(arrays->rotationY + i, ry);
+        r3d_simd_store(arrays->rotationZ + i, rz);
+
+        // Integrate position, then apply gravity to the velocity
+        r3d_simd_t vx = r3d_simd_load(arrays->velocityX + i);
+        r3d_simd_t vy = r3d_simd_load(arrays->velocityY + i);
+        r3d_simd_t vz = r3d_simd_load(arrays->velocityZ + i);
+
+        r3d_simd_t px = r3d_simd_add(r3d_simd_load(arrays->positionX + i), r3d_simd_mul(vx, dt));
+        r3d_simd_t py = r3d_simd_add(r3d_simd_load(arrays->positionY + i), r3d_simd_mul(vy, dt));
+        r3d_simd_t pz = r3d_simd_add(r3d_simd_load(arrays->positionZ + i), r3d_simd_mul(vz, dt));
+
+        r3d_simd_store(arrays->positionX + i, px);
+        r3d_simd_store(arrays->positionY + i, py);
+        r3d_simd_store(arrays->positionZ + i, pz);
+
+        r3d_simd_store(arrays->velocityX + i, r3d_simd_add(vx, gx));
+        r3d_simd_store(arrays->velocityY + i, r3d_simd_add(vy, gy));
+        r3d_simd_store(arrays->velocityZ + i, r3d_simd_add(vz, gz));
+
+        // Build 'MatrixScale * MatrixRotateXYZ * MatrixTranslate', raymath rotates by the negated angles
+        r3d_simd_t sx, cx, sy, cy, sz, cz;
+        r3d_simd_sincos(r3d_simd_sub(zero, rx), &sx, &cx);
+        r3d_simd_sincos(r3d_simd_sub(zero, ry), &sy, &cy);
+        r3d_simd_sincos(r3d_simd_sub(zero, rz), &sz, &cz);
+
+        r3d_simd_t scaleX = r3d_simd_load(arrays->scaleX + i);
+        r3d_simd_t scaleY = r3d_simd_load(arrays->scaleY + i);
+        r3d_simd_t scaleZ = r3d_simd_load(arrays->scaleZ + i);
+
+        r3d_simd_t sysx = r3d_simd_mul(sy, sx);
+        r3d_simd_t sycx = r3d_simd_mul(sy, cx);
+
+        union {
+            r3d_simd_t v[12];
+            float f[12][R3D_SIMD_WIDTH];
+        } m;
+
+        m.v[0] = r3d_simd_mul(r3d_simd_mul(cz, cy), scaleX);
+        m.v[1] = r3d_simd_mul(r3d_simd_sub(r3d_simd_mul(cz, sysx), r3d_simd_mul(sz, cx)), scaleX);
+        m.v[2] = r3d_simd_mul(r3d_simd_add(r3d_simd_mul(cz, sycx), r3d_simd_mul(sz, sx)), scaleX);
+        m.v[3] = r3d_simd_mul(r3d_simd_mul(sz, cy), scaleY);
+        m.v[4] = r3d_simd_mul(r3d_simd_add(r3d_simd_mul(sz, sysx), r3d_simd_mul(cz, cx)), scaleY);
+        m.v[5] = r3d_simd_mul(r3d_simd_sub(r3d_simd_mul(sz, sycx), r3d_simd_mul(cz, sx)), scaleY);
+        m.v[6] = r3d_simd_mul(r3d_simd_sub(zero, sy), scaleZ);
+        m.v[7] = r3d_simd_mul(r3d_simd_mul(cy, sx), scaleZ);
+        m.v[8] = r3d_simd_mul(r3d_simd_mul(cy, cx), scaleZ);
+        m.v[9] = px;
+        m.v[10] = py;
+        m.v[11] = pz;
+
+        // Scatter into the instance transforms (raylib matrices are stored row by row)
+        // The transforms are padded like the other arrays, always writing full vectors keeps the loop count constant
+        for (int l = 0; l < R3D_SIMD_WIDTH; l++) {
+            arrays->transforms[i + l] = (Matrix) {
+                m.f[0][l], m.f[3][l], m.f[6][l], m.f[9][l],
+                m.f[1][l], m.f[4][l], m.f[7][l], m.f[10][l],
+                m.f[2][l], m.f[5][l], m.f[8][l], m.f[11][l],
+                0.0f, 0.0f, 0.0f, 1.0f
+            };
+        }
     }
 
+    return end - start;
+}
+
+/* Emission functions */
+
+static Matrix r3d_particles_compose_transform(Vector3 scale, Vector3 rotation, Vector3 position)
+{
+    // Same result as 'MatrixScale * MatrixRotateXYZ * MatrixTranslate' without the two full products
+    float cx = cosf(-rotation.x), sx = sinf(-rotation.x);
+    float cy = cosf(-rotation.y), sy = sinf(-rotation.y);
+    float cz = cosf(-rotation.z), sz = sinf(-rotation.z);
+
+    return (Matrix) {
+        cz * cy * scale.x, sz * cy * scale.y, -sy * scale.z, position.x,
+        (cz * sy * sx - sz * cx) * scale.x, (sz * sy * sx + cz * cx) * scale.y, cy * sx * scale.z, position.y,
+        (cz * sy * cx + sz * sx) * scale.x, (sz * sy * cx - cz * sx) * scale.y, cy * cx * scale.z, position.z,
+        0.0f, 0.0f, 0.0f, 1.0f
+    };
+}
+
+static r3d_particle_emitter_t r3d_particles_get_emitter(const R3D_ParticleSystem* system)
+{
+    r3d_particle_emitter_t emitter = { 0 };
+
     // Normalize the initial direction
-    Vector3 direction = Vector3Normalize(system->initialVelocity);
+    emitter.direction = Vector3Normalize(system->initialVelocity);
+    emitter.speed = Vector3Length(system->initialVelocity);
+
+    // Generate the local basis around 'direction'
+    Vector3 arbitraryAxis = (fabsf(emitter.direction.y) > 0.9999f)
+        ? (Vector3) { 0.0f, 0.0f, 1.0f }
+        : (Vector3) { 1.0f, 0.0f, 0.0f };
 
+    emitter.binormal = Vector3Normalize(Vector3CrossProduct(arbitraryAxis, emitter.direction));
+    emitter.normal = Vector3CrossProduct(emitter.direction, emitter.binormal);
+
+    return emitter;
+}
+
+static void r3d_particles_init(const R3D_ParticleSystem* system, const r3d_particle_emitter_t* emitter, const float* rand, R3D_Particle* particle)
+{
     // Generate random angles
-    float elevation = r3d_randf_range(0, system->spreadAngle * DEG2RAD);
-    float azimuth = r3d_randf_range(0, 2.0f * PI);
+    float elevation = r3d_lerp_rand(0, system->spreadAngle * DEG2RAD, rand[0]);
+    float azimuth = r3d_lerp_rand(0, 2.0f * PI, rand[1]);
 
     // Precompute trigonometric values for the cone
     float cosElevation = cosf(elevation);
@@ -115,91 +457,76 @@ bool R3D_EmitParticle(R3D_ParticleSystem* system)
         cosElevation
     };
 
-    // Generate the local basis around 'direction'
-    Vector3 arbitraryAxis = (fabsf(direction.y) > 0.9999f)
-        ? (Vector3) { 0.0f, 0.0f, 1.0f }
-        : (Vector3) { 1.0f, 0.0f, 0.0f };
-
-    Vector3 binormal = Vector3Normalize(Vector3CrossProduct(arbitraryAxis, direction));
-    Vector3 normal = Vector3CrossProduct(direction, binormal);
-
-    // Transform 'spreadDirection' to the global coordinate system
+    // Transform 'spreadDirection' to the global coordinate system and scale it
     Vector3 velocity = {
-        spreadDirection.x * binormal.x + spreadDirection.y * normal.x + spreadDirection.z * direction.x,
-        spreadDirection.x * binormal.y + spreadDirection.y * normal.y + spreadDirection.z * direction.y,
-        spreadDirection.x * binormal.z + spreadDirection.y * normal.z + spreadDirection.z * direction.z
+        spreadDirection.x * emitter->binormal.x + spreadDirection.y * emitter->normal.x + spreadDirection.z * emitter->direction.x,
+        spreadDirection.x * emitter->binormal.y + spreadDirection.y * emitter->normal.y + spreadDirection.z * emitter->direction.y,
+        spreadDirection.x * emitter->binormal.z + spreadDirection.y * emitter->normal.z + spreadDirection.z * emitter->direction.z
     };
 
-    // Scale the final velocity
-    velocity = Vector3Scale(velocity, Vector3Length(system->initialVelocity));
+    velocity = Vector3Scale(velocity, emitter->speed);
 
     // Initialize particle
-    R3D_Particle particle = { 0 };
+    *particle = (R3D_Particle) { 0 };
 
-    particle.lifetime = system->lifetime + r3d_randf_range(-system->lifetimeVariance, system->lifetimeVariance);
+    particle->lifetime = system->lifetime + r3d_lerp_rand(-system->lifetimeVariance, system->lifetimeVariance, rand[2]);
 
-    particle.position = system->position;
+    particle->position = system->position;
 
-    particle.rotation = (Vector3){
-        (system->initialRotation.x + r3d_randf_range(-system->rotationVariance.x, system->rotationVariance.x)) * DEG2RAD,
-        (system->initialRotation.y + r3d_randf_range(-system->rotationVariance.y, system->rotationVariance.y)) * DEG2RAD,
-        (system->initialRotation.z + r3d_randf_range(-system->rotationVariance.z, system->rotationVariance.z)) * DEG2RAD
+    particle->rotation = (Vector3){
+        (system->initialRotation.x + r3d_lerp_rand(-system->rotationVariance.x, system->rotationVariance.x, rand[3])) * DEG2RAD,
+        (system->initialRotation.y + r3d_lerp_rand(-system->rotationVariance.y, system->rotationVariance.y, rand[4])) * DEG2RAD,
+        (system->initialRotation.z + r3d_lerp_rand(-system->rotationVariance.z, system->rotationVariance.z, rand[5])) * DEG2RAD
     };
 
-    particle.scale = particle.baseScale = Vector3AddValue(
-        system->initialScale, r3d_randf_range(-system->scaleVariance, system->scaleVariance)
+    particle->scale = particle->baseScale = Vector3AddValue(
+        system->initialScale, r3d_lerp_rand(-system->scaleVariance, system->scaleVariance, rand[6])
     );
 
-    particle.transform = MatrixScale(particle.scale.x, particle.scale.y, particle.scale.z);
-    particle.transform = MatrixMultiply(particle.transform, MatrixRotateXYZ(particle.rotation));
-    particle.transform = MatrixMultiply(particle.transform, MatrixTranslate(particle.position.x, particle.position.y, particle.position.z));
+    particle->transform = r3d_particles_compose_transform(particle->scale, particle->rotation, particle->position);
 
-    particle.velocity = particle.baseVelocity = (Vector3){
-        velocity.x + r3d_randf_range(-system->velocityVariance.x, system->velocityVariance.x),
-        velocity.y + r3d_randf_range(-system->velocityVariance.y, system->velocityVariance.y),
-        velocity.z + r3d_randf_range(-system->velocityVariance.z, system->velocityVariance.z)
+    particle->velocity = particle->baseVelocity = (Vector3){
+        velocity.x + r3d_lerp_rand(-system->velocityVariance.x, system->velocityVariance.x, rand[7]),
+        velocity.y + r3d_lerp_rand(-system->velocityVariance.y, system->velocityVariance.y, rand[8]),
+        velocity.z + r3d_lerp_rand(-system->velocityVariance.z, system->velocityVariance.z, rand[9])
     };
 
-    particle.angularVelocity = particle.baseAngularVelocity = (Vector3){
-        system->initialAngularVelocity.x + r3d_randf_range(-system->angularVelocityVariance.x, system->angularVelocityVariance.x),
-        system->initialAngularVelocity.y + r3d_randf_range(-system->angularVelocityVariance.y, system->angularVelocityVariance.y),
-        system->initialAngularVelocity.z + r3d_randf_range(-system->angularVelocityVariance.z, system->angularVelocityVariance.z)
+    particle->angularVelocity = particle->baseAngularVelocity = (Vector3){
+        system->initialAngularVelocity.x + r3d_lerp_rand(-system->angularVelocityVariance.x, system->angularVelocityVariance.x, rand[10]),
+        system->initialAngularVelocity.y + r3d_lerp_rand(-system->angularVelocityVariance.y, system->angularVelocityVariance.y, rand[11]),
+        system->initialAngularVelocity.z + r3d_lerp_rand(-system->angularVelocityVariance.z, system->angularVelocityVariance.z, rand[12])
     };
 
-    particle.color = (Color){
-        (unsigned char)(system->initialColor.r + GetRandomValue(-system->colorVariance.r, system->colorVariance.r)),
-        (unsigned char)(system->initialColor.g + GetRandomValue(-system->colorVariance.g, system->colorVariance.g)),
-        (unsigned char)(system->initialColor.g + GetRandomValue(-system->colorVariance.b, system->colorVariance.b)),
-        (unsigned char)(system->initialColor.a + GetRandomValue(-system->colorVariance.a, system->colorVariance.a))
+    particle->color = (Color){
+        r3d_vary_channel(system->initialColor.r, system->colorVariance.r, rand[13]),
+        r3d_vary_channel(system->initialColor.g, system->colorVariance.g, rand[14]),
+        r3d_vary_channel(system->initialColor.b, system->colorVariance.b, rand[15]),
+        r3d_vary_channel(system->initialColor.a, system->colorVariance.a, rand[16])
     };
 
-    particle.baseOpacity = particle.color.a;
-
-    // Adding the particle to the system
-    system->particles[system->count++] = particle;
-
-    return true;
+    particle->baseOpacity = particle->color.a;
 }
 
-void R3D_UpdateParticleSystem(R3D_ParticleSystem* system, float deltaTime)
+/* AoS storage functions */
+
+static int r3d_particles_aos_update_range(R3D_ParticleSystem* system, int start, int end, float deltaTime)
 {
-    if (system->autoEmission && system->emissionRate > 0.0f) {
-        system->emissionTimer -= deltaTime;
-        while (system->emissionTimer <= 0.0f) {
-            system->emissionTimer += 1.0f / system->emissionRate;
-            R3D_EmitParticle(system);
-        }
-    }
+    // Live particles are compacted at the front of the range, keeping their order
+    int alive = start;
 
-    for (int i = system->count - 1; i >= 0; i--) {
+    for (int i = start; i < end; i++) {
         R3D_Particle* particle = &system->particles[i];
 
         particle->lifetime -= deltaTime;
         if (particle->lifetime <= 0.0f) {
-            *particle = system->particles[--system->count];
             continue;
         }
 
+        if (alive != i) {
+            system->particles[alive] = *particle;
+        }
+        particle = &system->particles[alive++];
+
         float t = 1.0f - (particle->lifetime / system->lifetime);
 
         if (system->scaleOverLifetime) {
@@ -244,51 +571,579 @@ void R3D_UpdateParticleSystem(R3D_ParticleSystem* system, float deltaTime)
         particle->velocity.y += system->gravity.y * deltaTime;
         particle->velocity.z += system->gravity.z * deltaTime;
     }
+
+    return alive - start;
+}
+
+static void r3d_particles_aos_get_bounds(const R3D_Particle* particles, int start, int end, Vector3* outMin, Vector3* outMax)
+{
+    Vector3 min = { FLT_MAX, FLT_MAX, FLT_MAX };
+    Vector3 max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (int i = start; i < end; i++) {
+        min = Vector3Min(min, particles[i].position);
+        max = Vector3Max(max, particles[i].position);
+    }
+
+    *outMin = min;
+    *outMax = max;
+}
+
+/* GPU storage functions */
+
+static bool r3d_particles_gpu_alloc(R3D_ParticleBuffers* buffers, int capacity)
+{
+    if (R3D.shader.simulate.particles.id == 0) {
+        r3d_shader_load_simulate_particles();
+        if (R3D.shader.simulate.particles.id == 0) return false;
+    }
+
+    // Zeroed particles have no lifetime left, the buffers start empty
+    void* zero = RL_CALLOC(capacity, sizeof(r3d_particle_gpu_t));
+    if (zero == NULL) return false;
+
+    glGenBuffers(2, buffers->vbo);
+    glGenVertexArrays(2, buffers->vao);
+
+    for (int i = 0; i < 2; i++) {
+        glBindVertexArray(buffers->vao[i]);
+        glBindBuffer(GL_ARRAY_BUFFER, buffers->vbo[i]);
+        glBufferData(GL_ARRAY_BUFFER, capacity * sizeof(r3d_particle_gpu_t), zero, GL_DYNAMIC_COPY);
+
+        GLsizei stride = sizeof(r3d_particle_gpu_t);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(r3d_particle_gpu_t, positionLifetime));
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(r3d_particle_gpu_t, velocity));
+        glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(r3d_particle_gpu_t, rotation));
+        glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(r3d_particle_gpu_t, baseVelocity));
+        glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(r3d_particle_gpu_t, baseAngularVelocity));
+        glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(r3d_particle_gpu_t, baseScaleOpacity));
+        glVertexAttribIPointer(6, 1, GL_UNSIGNED_INT, stride, (void*)offsetof(r3d_particle_gpu_t, color));
+
+        for (int j = 0; j <= 6; j++) {
+            glEnableVertexAttribArray(j);
+        }
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    RL_FREE(zero);
+
+    // Curves are sampled with linear filtering, out of range lifetimes use the end values
+    glGenTextures(1, &buffers->curves);
+    glBindTexture(GL_TEXTURE_1D, buffers->curves);
+    glTexImage1D(GL_TEXTURE_1D, 0, GL_RGBA32F, R3D_PARTICLE_GPU_CURVE_SIZE, 0, GL_RGBA, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_1D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_1D, 0);
+
+    buffers->curveHash = 0;
+    buffers->current = 0;
+    buffers->emitCursor = 0;
+    buffers->emitPending = 0;
+
+    return true;
+}
+
+static void r3d_particles_gpu_free(R3D_ParticleBuffers* buffers)
+{
+    glDeleteVertexArrays(2, buffers->vao);
+    glDeleteBuffers(2, buffers->vbo);
+    glDeleteTextures(1, &buffers->curves);
+}
+
+static uint64_t r3d_particles_gpu_hash_curve(uint64_t hash, const R3D_InterpolationCurve* curve)
+{
+    unsigned char present = (curve != NULL);
+    hash = r3d_hash_fnv1a(hash, &present, sizeof(present));
+    if (curve == NULL) return hash;
+
+    hash = r3d_hash_fnv1a(hash, &curve->interpolation, sizeof(curve->interpolation));
+    hash = r3d_hash_fnv1a(hash, &curve->lutSize, sizeof(curve->lutSize));
+    hash = r3d_hash_fnv1a(hash, curve->keyframes, curve->count * sizeof(R3D_Keyframe));
+
+    return hash;
+}
+
+static void r3d_particles_gpu_bake_curves(R3D_ParticleSystem* system)
+{
+    const R3D_InterpolationCurve* curves[4] = {
+        system->scaleOverLifetime,
+        system->opacityOverLifetime,
+        system->speedOverLifetime,
+        system->angularVelocityOverLifetime
+    };
+
+    uint64_t hash = R3D_HASH_FNV1A_SEED;
+    for (int i = 0; i < 4; i++) {
+        hash = r3d_particles_gpu_hash_curve(hash, curves[i]);
+    }
+
+    if (hash == system->buffers.curveHash) {
+        return;
+    }
+
+    float times[R3D_PARTICLE_GPU_CURVE_SIZE];
+    float values[R3D_PARTICLE_GPU_CURVE_SIZE];
+    float texels[R3D_PARTICLE_GPU_CURVE_SIZE * 4];
+
+    for (int i = 0; i < R3D_PARTICLE_GPU_CURVE_SIZE; i++) {
+        times[i] = (float)i / (R3D_PARTICLE_GPU_CURVE_SIZE - 1);
+    }
+
+    // Missing curves are baked as a constant 1, which leaves the base values unchanged
+    for (int c = 0; c < 4; c++) {
+        if (curves[c] != NULL) {
+            R3D_EvaluateCurveBatch(*curves[c], times, values, R3D_PARTICLE_GPU_CURVE_SIZE);
+        }
+        for (int i = 0; i < R3D_PARTICLE_GPU_CURVE_SIZE; i++) {
+            texels[i * 4 + c] = (curves[c] != NULL) ? values[i] : 1.0f;
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_1D, system->buffers.curves);
+    glTexSubImage1D(GL_TEXTURE_1D, 0, 0, R3D_PARTICLE_GPU_CURVE_SIZE, GL_RGBA, GL_FLOAT, texels);
+    glBindTexture(GL_TEXTURE_1D, 0);
+
+    system->buffers.curveHash = hash;
+}
+
+static void r3d_particles_gpu_update(R3D_ParticleSystem* system, float deltaTime)
+{
+    R3D_ParticleBuffers* buffers = &system->buffers;
+    if (buffers->vbo[0] == 0 || system->capacity <= 0) return;
+
+    r3d_particles_gpu_bake_curves(system);
+
+    r3d_particle_emitter_t emitter = r3d_particles_get_emitter(system);
+    Color color = system->initialColor;
+    Color variance = system->colorVariance;
+
+    r3d_shader_enable(simulate.particles);
+
+    r3d_shader_set_int(simulate.particles, uSpeedCurve, system->speedOverLifetime != NULL);
+    r3d_shader_set_float(simulate.particles, uDeltaTime, deltaTime);
+    r3d_shader_set_float(simulate.particles, uLifetime, system->lifetime);
+    r3d_shader_set_vec3(simulate.particles, uGravity, system->gravity);
+
+    // Spawned particles draw their random values from a hash of this seed and their slot
+    uint64_t rngState = system->rngState;
+    r3d_shader_set_int(simulate.particles, uSeed, (int)r3d_pcg32_next(&rngState));
+    system->rngState = rngState;
+    r3d_shader_set_int(simulate.particles, uCapacity, system->capacity);
+    r3d_shader_set_int(simulate.particles, uEmitStart, buffers->emitCursor);
+    r3d_shader_set_int(simulate.particles, uEmitCount, buffers->emitPending);
+
+    r3d_shader_set_vec3(simulate.particles, uPosition, system->position);
+    r3d_shader_set_vec3(simulate.particles, uEmitDirection, emitter.direction);
+    r3d_shader_set_vec3(simulate.particles, uEmitBinormal, emitter.binormal);
+    r3d_shader_set_vec3(simulate.particles, uEmitNormal, emitter.normal);
+    r3d_shader_set_float(simulate.particles, uEmitSpeed, emitter.speed);
+    r3d_shader_set_float(simulate.particles, uSpreadAngle, system->spreadAngle * DEG2RAD);
+    r3d_shader_set_float(simulate.particles, uLifetimeVariance, system->lifetimeVariance);
+    r3d_shader_set_vec3(simulate.particles, uInitialRotation, system->initialRotation);
+    r3d_shader_set_vec3(simulate.particles, uRotationVariance, system->rotationVariance);
+    r3d_shader_set_vec3(simulate.particles, uInitialScale, system->initialScale);
+    r3d_shader_set_float(simulate.particles, uScaleVariance, system->scaleVariance);
+    r3d_shader_set_vec3(simulate.particles, uVelocityVariance, system->velocityVariance);
+    r3d_shader_set_vec3(simulate.particles, uInitialAngularVelocity, system->initialAngularVelocity);
+    r3d_shader_set_vec3(simulate.particles, uAngularVelocityVariance, system->angularVelocityVariance);
+    r3d_shader_set_vec4(simulate.particles, uInitialColor, ((Vector4) { color.r, color.g, color.b, color.a }));
+    r3d_shader_set_vec4(simulate.particles, uColorVariance, ((Vector4) { variance.r, variance.g, variance.b, variance.a }));
+
+    r3d_shader_bind_sampler1D(simulate.particles, uTexCurves, buffers->curves);
+
+    // One point per particle, the outputs are captured into the other buffer
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(buffers->vao[buffers->current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, buffers->vbo[1 - buffers->current]);
+
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, system->capacity);
+    glEndTransformFeedback();
+
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindVertexArray(0);
+    glDisable(GL_RASTERIZER_DISCARD);
+
+    r3d_shader_unbind_sampler1D(simulate.particles, uTexCurves);
+    r3d_shader_disable();
+
+    buffers->current = 1 - buffers->current;
+    buffers->emitCursor = (buffers->emitCursor + buffers->emitPending) % system->capacity;
+    buffers->emitPending = 0;
+}
+
+/* Chunked update functions */
+
+static void r3d_particles_update_chunk(void* data, int index)
+{
+    r3d_particle_update_t* update = data;
+    r3d_particle_chunk_t* chunk = &update->chunks[index];
+
+    R3D_ParticleSystem* system = chunk->system;
+
+    if (system->storage == R3D_PARTICLE_STORAGE_SOA) {
+        chunk->alive = r3d_particles_soa_update_range(system, chunk->start, chunk->end, update->deltaTime);
+        if (system->trackBounds) {
+            r3d_particles_soa_get_bounds(&system->arrays, chunk->start, chunk->start + chunk->alive, &chunk->boundsMin, &chunk->boundsMax);
+        }
+    }
+    else {
+        chunk->alive = r3d_particles_aos_update_range(system, chunk->start, chunk->end, update->deltaTime);
+        if (system->trackBounds) {
+            r3d_particles_aos_get_bounds(system->particles, chunk->start, chunk->start + chunk->alive, &chunk->boundsMin, &chunk->boundsMax);
+        }
+    }
+}
+
+static void r3d_particles_move_range(R3D_ParticleSystem* system, int src, int dst, int count)
+{
+    if (system->storage != R3D_PARTICLE_STORAGE_SOA) {
+        memmove(system->particles + dst, system->particles + src, count * sizeof(R3D_Particle));
+        return;
+    }
+
+    R3D_ParticleArrays* arrays = &system->arrays;
+
+    float** fields[R3D_PARTICLE_SOA_FLOAT_ARRAYS];
+    r3d_particles_soa_get_float_arrays(arrays, fields);
+
+    for (int i = 0; i < R3D_PARTICLE_SOA_FLOAT_ARRAYS; i++) {
+        memmove(*fields[i] + dst, *fields[i] + src, count * sizeof(float));
+    }
+
+    memmove(arrays->baseOpacity + dst, arrays->baseOpacity + src, count * sizeof(unsigned char));
+    memmove(arrays->colors + dst, arrays->colors + src, count * sizeof(Color));
+    memmove(arrays->transforms + dst, arrays->transforms + src, count * sizeof(Matrix));
+}
+
+static void r3d_particles_merge_chunks(R3D_ParticleSystem* system, const r3d_particle_chunk_t* chunks, int chunkCount)
+{
+    // Chunks are in ascending order, each one only moves towards the front
+    int count = 0;
+
+    Vector3 min = { FLT_MAX, FLT_MAX, FLT_MAX };
+    Vector3 max = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    for (int i = 0; i < chunkCount; i++) {
+        if (chunks[i].alive == 0) {
+            continue;
+        }
+        if (chunks[i].start != count) {
+            r3d_particles_move_range(system, chunks[i].start, count, chunks[i].alive);
+        }
+        if (system->trackBounds) {
+            min = Vector3Min(min, chunks[i].boundsMin);
+            max = Vector3Max(max, chunks[i].boundsMax);
+        }
+        count += chunks[i].alive;
+    }
+
+    system->count = count;
+
+    if (system->trackBounds) {
+        system->bounds = (count > 0)
+            ? (BoundingBox) { min, max }
+            : (BoundingBox) { system->position, system->position };
+    }
+}
+
+/* Public functions */
+
+R3D_ParticleSystem R3D_LoadParticleSystem(int maxParticles)
+{
+    return R3D_LoadParticleSystemEx(maxParticles, R3D_PARTICLE_STORAGE_AOS);
+}
+
+R3D_ParticleSystem R3D_LoadParticleSystemEx(int maxParticles, R3D_ParticleStorage storage)
+{
+    R3D_ParticleSystem system = { 0 };
+
+    if (storage == R3D_PARTICLE_STORAGE_SOA) {
+        if (!r3d_particles_soa_alloc(&system.arrays, maxParticles)) {
+            TraceLog(LOG_WARNING, "R3D: Failed to allocate particle arrays for %i particles", maxParticles);
+            return system;
+        }
+    }
+    else if (storage == R3D_PARTICLE_STORAGE_GPU) {
+        if (!r3d_particles_gpu_alloc(&system.buffers, maxParticles)) {
+            TraceLog(LOG_WARNING, "R3D: Failed to create particle buffers for %i particles", maxParticles);
+            return system;
+        }
+    }
+    else {
+        system.particles = RL_MALLOC(sizeof(R3D_Particle) * maxParticles);
+    }
+
+    system.storage = storage;
+    system.capacity = maxParticles;
+    system.count = 0;
+
+    system.position = (Vector3){ 0, 0, 0 };
+    system.gravity = (Vector3){ 0, -9.81f, 0 };
+
+    system.initialScale = Vector3One();
+    system.scaleVariance = 0.0f;
+
+    system.initialRotation = Vector3Zero();
+    system.rotationVariance = Vector3Zero();
+
+    system.initialColor = WHITE;
+    system.colorVariance = BLANK;
+
+    system.initialVelocity = (Vector3){ 0, 0, 0 };
+    system.velocityVariance = Vector3Zero();
+
+    system.initialAngularVelocity = Vector3Zero();
+    system.angularVelocityVariance = Vector3Zero();
+
+    system.lifetime = 1.0f;
+    system.lifetimeVariance = 0.0f;
+
+    system.emissionTimer = 0.0f;
+    system.emissionRate = 1.0f;
+    system.spreadAngle = 0.0f;
+
+    system.scaleOverLifetime = NULL;
+    system.speedOverLifetime = NULL;
+    system.opacityOverLifetime = NULL;
+    system.angularVelocityOverLifetime = NULL;
+
+    system.autoEmission = true;
+
+    // Seeded from raylib's generator so that 'SetRandomSeed' still drives the default sequences
+    R3D_SetParticleSystemSeed(&system, ((unsigned int)GetRandomValue(0, 0x7FFF) << 15) | (unsigned int)GetRandomValue(0, 0x7FFF));
+
+    return system;
+}
+
+void R3D_UnloadParticleSystem(R3D_ParticleSystem* system)
+{
+    if (system) {
+        RL_FREE(system->particles);
+        RL_FREE(system->arrays.memory);
+        if (system->storage == R3D_PARTICLE_STORAGE_GPU) {
+            r3d_particles_gpu_free(&system->buffers);
+        }
+    }
+}
+
+bool R3D_EmitParticle(R3D_ParticleSystem* system)
+{
+    return R3D_EmitParticles(system, 1) == 1;
+}
+
+int R3D_EmitParticles(R3D_ParticleSystem* system, int count)
+{
+    if (system->storage == R3D_PARTICLE_STORAGE_GPU) {
+        // Free slots are only known on the GPU, the next update spawns what it can
+        int available = system->capacity - system->buffers.emitPending;
+        if (count > available) count = available;
+        if (count <= 0) return 0;
+        system->buffers.emitPending += count;
+        return count;
+    }
+
+    int available = system->capacity - system->count;
+    if (count > available) count = available;
+    if (count <= 0) return 0;
+
+    r3d_particle_emitter_t emitter = r3d_particles_get_emitter(system);
+
+    float randoms[R3D_PARTICLE_EMIT_BATCH * R3D_PARTICLE_EMIT_RANDOMS];
+    uint64_t rngState = system->rngState;
+
+    for (int emitted = 0; emitted < count; emitted += R3D_PARTICLE_EMIT_BATCH) {
+        int batchCount = (count - emitted < R3D_PARTICLE_EMIT_BATCH) ? count - emitted : R3D_PARTICLE_EMIT_BATCH;
+        r3d_pcg32_fill_floats(&rngState, randoms, batchCount * R3D_PARTICLE_EMIT_RANDOMS);
+
+        for (int i = 0; i < batchCount; i++) {
+            R3D_Particle particle;
+            r3d_particles_init(system, &emitter, randoms + i * R3D_PARTICLE_EMIT_RANDOMS, &particle);
+
+            if (system->storage == R3D_PARTICLE_STORAGE_SOA) {
+                r3d_particles_soa_write(&system->arrays, system->count++, &particle);
+            }
+            else {
+                system->particles[system->count++] = particle;
+            }
+        }
+    }
+
+    system->rngState = rngState;
+
+    return count;
+}
+
+void R3D_SetParticleSystemSeed(R3D_ParticleSystem* system, unsigned int seed)
+{
+    system->rngState = r3d_pcg32_seed(seed);
+}
+
+void R3D_UpdateParticleSystem(R3D_ParticleSystem* system, float deltaTime)
+{
+    R3D_UpdateParticleSystems(&system, 1, deltaTime);
+}
+
+void R3D_UpdateParticleSystems(R3D_ParticleSystem** systems, int count, float deltaTime)
+{
+    // Emission stays on the calling thread, it is cheap and advances each system's generator in order
+    int chunkCount = 0;
+
+    for (int i = 0; i < count; i++) {
+        R3D_ParticleSystem* system = systems[i];
+        if (system->autoEmission && system->emissionRate > 0.0f) {
+            int emitCount = 0;
+            system->emissionTimer -= deltaTime;
+            while (system->emissionTimer <= 0.0f) {
+                system->emissionTimer += 1.0f / system->emissionRate;
+                emitCount++;
+            }
+            R3D_EmitParticles(system, emitCount);
+        }
+        if (system->storage == R3D_PARTICLE_STORAGE_GPU) {
+            r3d_particles_gpu_update(system, deltaTime);
+            if (system->trackBounds) {
+                system->bounds = R3D_GetParticleSystemBoundingBox(system);
+            }
+            continue;
+        }
+        chunkCount += (system->count + R3D_PARTICLE_CHUNK_SIZE - 1) / R3D_PARTICLE_CHUNK_SIZE;
+    }
+
+    if (chunkCount == 0) {
+        for (int i = 0; i < count; i++) {
+            if (systems[i]->trackBounds && systems[i]->storage != R3D_PARTICLE_STORAGE_GPU) {
+                systems[i]->bounds = (BoundingBox) { systems[i]->position, systems[i]->position };
+            }
+        }
+        return;
+    }
+
+    // The chunks only live for this call, they are taken from the frame arena and given back at the end
+    r3d_arena_mark_t mark = r3d_arena_get_mark(&R3D.container.frameArena);
+    r3d_particle_chunk_t* chunks = r3d_arena_alloc(&R3D.container.frameArena, chunkCount * sizeof(r3d_particle_chunk_t));
+    if (chunks == NULL) {
+        TraceLog(LOG_WARNING, "R3D: Failed to allocate particle update chunks");
+        return;
+    }
+
+    // Split every system into fixed size chunks, the result does not depend on the thread count
+    int chunkIndex = 0;
+    for (int i = 0; i < count; i++) {
+        for (int start = 0; start < systems[i]->count; start += R3D_PARTICLE_CHUNK_SIZE) {
+            int end = start + R3D_PARTICLE_CHUNK_SIZE;
+            chunks[chunkIndex++] = (r3d_particle_chunk_t) {
+                .system = systems[i],
+                .start = start,
+                .end = (end < systems[i]->count) ? end : systems[i]->count,
+                .alive = 0,
+                .boundsMin = { 0 },
+                .boundsMax = { 0 }
+            };
+        }
+    }
+
+    r3d_particle_update_t update = {
+        .chunks = chunks,
+        .deltaTime = deltaTime
+    };
+
+    r3d_jobs_dispatch(r3d_particles_update_chunk, &update, chunkCount);
+
+    // Close the gaps left by the expired particles of each chunk
+    chunkIndex = 0;
+    for (int i = 0; i < count; i++) {
+        if (systems[i]->storage == R3D_PARTICLE_STORAGE_GPU) continue;
+        int systemChunks = (systems[i]->count + R3D_PARTICLE_CHUNK_SIZE - 1) / R3D_PARTICLE_CHUNK_SIZE;
+        r3d_particles_merge_chunks(systems[i], chunks + chunkIndex, systemChunks);
+        chunkIndex += systemChunks;
+    }
+
+    r3d_arena_release(&R3D.container.frameArena, mark);
+}
+
+void R3D_SetParticleThreadCount(int count)
+{
+    if (!r3d_jobs_init(count)) {
+        TraceLog(LOG_WARNING, "R3D: Failed to start particle worker threads, particles will be updated on the calling thread");
+        return;
+    }
+
+    TraceLog(LOG_INFO, "R3D: Particle systems updated on %i thread(s)", r3d_jobs_get_thread_count());
+}
+
+int R3D_GetParticleThreadCount(void)
+{
+    return r3d_jobs_get_thread_count();
 }
 
 BoundingBox R3D_GetParticleSystemBoundingBox(R3D_ParticleSystem* system)
 {
-    // Initialize the AABB with extreme values (max for max bounds, min for min bounds)
-    Vector3 aabbMin = { FLT_MAX, FLT_MAX, FLT_MAX };
-    Vector3 aabbMax = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
-
-    // Loop over all particles in the emitter (considering the particle capacity)
-    for (int i = 0; i < system->capacity; i++) {
-        // Emit a particle for the current iteration
-        R3D_EmitParticle(system);
-
-        // Get the current particle from the emitter
-        const R3D_Particle* particle = &system->particles[i];
-
-        // Calculate the position of the particle at half its lifetime (intermediate position)
-        float halfLifetime = particle->lifetime * 0.5f;
-        Vector3 midPosition = {
-            particle->transform.m12 + particle->velocity.x * halfLifetime + 0.5f * system->gravity.x * halfLifetime * halfLifetime,
-            particle->transform.m13 + particle->velocity.y * halfLifetime + 0.5f * system->gravity.y * halfLifetime * halfLifetime,
-            particle->transform.m14 + particle->velocity.z * halfLifetime + 0.5f * system->gravity.z * halfLifetime * halfLifetime
-        };
-
-        // Calculate the position of the particle at the end of its lifetime (final position)
-        Vector3 futurePosition = {
-            particle->transform.m12 + particle->velocity.x * particle->lifetime + 0.5f * system->gravity.x * particle->lifetime * particle->lifetime,
-            particle->transform.m13 + particle->velocity.y * particle->lifetime + 0.5f * system->gravity.y * particle->lifetime * particle->lifetime,
-            particle->transform.m14 + particle->velocity.z * particle->lifetime + 0.5f * system->gravity.z * particle->lifetime * particle->lifetime
-        };
-
-        // Expand the AABB by comparing the current min and max with the calculated positions
-        // We include both the intermediate (halfway) and final (end of lifetime) positions
-        aabbMin.x = r3d_min3f(aabbMin.x, midPosition.x, futurePosition.x);
-        aabbMin.y = r3d_min3f(aabbMin.y, midPosition.y, futurePosition.y);
-        aabbMin.z = r3d_min3f(aabbMin.z, midPosition.z, futurePosition.z);
-
-        aabbMax.x = r3d_max3f(aabbMax.x, midPosition.x, futurePosition.x);
-        aabbMax.y = r3d_max3f(aabbMax.y, midPosition.y, futurePosition.y);
-        aabbMax.z = r3d_max3f(aabbMax.z, midPosition.z, futurePosition.z);
-    }
-
-    // Clear any previous state or data in the emitter
-    system->count = 0;
-
-    // Update the particle system's AABB with the calculated bounds
-    return (BoundingBox){ aabbMin, aabbMax };
+    float maxLifetime = fmaxf(system->lifetime + fabsf(system->lifetimeVariance), 0.0f);
+    float spread = fminf(fabsf(system->spreadAngle) * DEG2RAD, PI);
+
+    Vector3 direction = Vector3Normalize(system->initialVelocity);
+    float speed = Vector3Length(system->initialVelocity);
+
+    const float dir[3] = { direction.x, direction.y, direction.z };
+    const float gravity[3] = { system->gravity.x, system->gravity.y, system->gravity.z };
+    const float variance[3] = {
+        fabsf(system->velocityVariance.x),
+        fabsf(system->velocityVariance.y),
+        fabsf(system->velocityVariance.z)
+    };
+
+    float speedMin = 1.0f, speedMax = 1.0f;
+    if (system->speedOverLifetime) {
+        r3d_curve_get_range(system->speedOverLifetime, &speedMin, &speedMax);
+    }
+
+    float min[3], max[3];
+
+    for (int axis = 0; axis < 3; axis++) {
+        // Range of the initial velocity along this axis, from the directions inside the spread cone
+        float angle = acosf(Clamp(dir[axis], -1.0f, 1.0f));
+        float vMin = speed * cosf(fminf(angle + spread, PI)) - variance[axis];
+        float vMax = speed * cosf(fmaxf(angle - spread, 0.0f)) + variance[axis];
+
+        if (system->speedOverLifetime) {
+            // The curve resets the velocity before each step, gravity never accumulates
+            // Either factor may be negative, so any of the four products can be an extreme
+            float a = vMin * speedMin, b = vMin * speedMax;
+            float c = vMax * speedMin, d = vMax * speedMax;
+            float lo = fminf(fminf(a, b), fminf(c, d));
+            float hi = fmaxf(fmaxf(a, b), fmaxf(c, d));
+            min[axis] = fminf(0.0f, lo * maxLifetime);
+            max[axis] = fmaxf(0.0f, hi * maxLifetime);
+            continue;
+        }
+
+        // Explicit integration lags behind the exact trajectory by up to 'g * dt / 2' of initial velocity
+        float g = gravity[axis];
+        float lag = 0.5f * g * R3D_PARTICLE_BOUNDS_MAX_STEP;
+        if (lag > 0.0f) vMin -= lag;
+        else vMax -= lag;
+
+        // Extremes of 'v * t + g * t^2 / 2' over [0, maxLifetime], at both ends or at the apex
+        float t = maxLifetime;
+        min[axis] = fminf(0.0f, vMin * t + 0.5f * g * t * t);
+        max[axis] = fmaxf(0.0f, vMax * t + 0.5f * g * t * t);
+
+        if (g > 0.0f && vMin < 0.0f) {
+            float apex = fminf(-vMin / g, t);
+            min[axis] = fminf(min[axis], vMin * apex + 0.5f * g * apex * apex);
+        }
+        if (g < 0.0f && vMax > 0.0f) {
+            float apex = fminf(-vMax / g, t);
+            max[axis] = fmaxf(max[axis], vMax * apex + 0.5f * g * apex * apex);
+        }
+    }
+
+    return (BoundingBox) {
+        Vector3Add(system->position, (Vector3) { min[0], min[1], min[2] }),
+        Vector3Add(system->position, (Vector3) { max[0], max[1], max[2] })
+    };
 }
@@ -24,11 +24,31 @@
 #include "./r3d_state.h"
 
 #include <assert.h>
+#include <stdio.h>
+#include <string.h>
 #include <raylib.h>
 #include <raymath.h>
 #include <rlgl.h>
 #include <glad.h>
 
+#include "./details/misc/r3d_hash.h"
+
+
+/* === Internal types === */
+
+#define R3D_SKYBOX_CACHE_MAGIC 0x53443352   //< "R3DS"
+#define R3D_SKYBOX_CACHE_VERSION 1          //< Increment when the layout or the generation changes
+
+typedef struct {
+    unsigned int magic;             //< Always 'R3D_SKYBOX_CACHE_MAGIC'
+    unsigned int version;           //< Always 'R3D_SKYBOX_CACHE_VERSION'
+    uint64_t key;                   //< Hash of the source file content, its size and the cubemap size
+    int cubemapSize;                //< Environment cubemap face size, stored as RGB half floats
+    int irradianceSize;             //< Irradiance cubemap face size, stored as RGB floats
+    int prefilterSize;              //< Prefilter cubemap base face size, stored as RGB half floats
+    int prefilterMips;              //< Number of prefilter mip levels stored
+} r3d_skybox_cache_header_t;
+
 
 /* === Internal functions === */
 
@@ -241,6 +261,192 @@ static TextureCubemap r3d_skybox_generate_prefilter(TextureCubemap sky)
 }
 
 
+static int r3d_skybox_cache_data_size(int size, int mipCount, int pixelSize)
+{
+    int total = 0;
+    for (int mip = 0; mip < mipCount; mip++) {
+        int mipSize = (size >> mip) > 0 ? (size >> mip) : 1;
+        total += 6 * mipSize * mipSize * pixelSize;
+    }
+    return total;
+}
+
+static unsigned char* r3d_skybox_cache_pack(unsigned char* dst, unsigned int id, int size, int mipCount, GLenum type, int pixelSize)
+{
+    glBindTexture(GL_TEXTURE_CUBE_MAP, id);
+    for (int mip = 0; mip < mipCount; mip++) {
+        int mipSize = (size >> mip) > 0 ? (size >> mip) : 1;
+        for (int i = 0; i < 6; i++) {
+            glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, mip, GL_RGB, type, dst);
+            dst += mipSize * mipSize * pixelSize;
+        }
+    }
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+    return dst;
+}
+
+static const unsigned char* r3d_skybox_cache_unpack(const unsigned char* src, unsigned int* id, int size, int mipCount, GLenum internalFormat, GLenum type, int pixelSize)
+{
+    glGenTextures(1, id);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, *id);
+
+    for (int mip = 0; mip < mipCount; mip++) {
+        int mipSize = (size >> mip) > 0 ? (size >> mip) : 1;
+        for (int i = 0; i < 6; i++) {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, mip, internalFormat, mipSize, mipSize, 0, GL_RGB, type, src);
+            src += mipSize * mipSize * pixelSize;
+        }
+    }
+
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, (mipCount > 1) ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, mipCount - 1);
+
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+    return src;
+}
+
+static bool r3d_skybox_cache_key(const char* fileName, int size, uint64_t* key)
+{
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(fileName, &dataSize);
+    if (data == NULL) return false;
+
+    uint64_t hash = r3d_hash_fnv1a(R3D_HASH_FNV1A_SEED, data, dataSize);
+    hash = r3d_hash_fnv1a(hash, &dataSize, sizeof(dataSize));
+    hash = r3d_hash_fnv1a(hash, &size, sizeof(size));
+
+    UnloadFileData(data);
+
+    *key = hash;
+
+    return true;
+}
+
+static bool r3d_skybox_cache_load(uint64_t key, int size, R3D_Skybox* sky)
+{
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%016llx.bin", R3D_SKYBOX_CACHE_DIRECTORY, (unsigned long long)key);
+    if (!FileExists(path)) return false;
+
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(path, &dataSize);
+    if (data == NULL) return false;
+
+    r3d_skybox_cache_header_t header = { 0 };
+    if (dataSize > (int)sizeof(header)) {
+        memcpy(&header, data, sizeof(header));
+    }
+
+    bool valid = (header.magic == R3D_SKYBOX_CACHE_MAGIC)
+        && (header.version == R3D_SKYBOX_CACHE_VERSION)
+        && (header.key == key) && (header.cubemapSize == size)
+        && (header.irradianceSize > 0) && (header.prefilterSize > 0) && (header.prefilterMips > 0)
+        && (dataSize == (int)sizeof(header)
+            + r3d_skybox_cache_data_size(header.cubemapSize, 1, 3 * sizeof(uint16_t))
+            + r3d_skybox_cache_data_size(header.irradianceSize, 1, 3 * sizeof(float))
+            + r3d_skybox_cache_data_size(header.prefilterSize, header.prefilterMips, 3 * sizeof(uint16_t)));
+
+    if (!valid) {
+        TraceLog(LOG_WARNING, "R3D: Ignoring invalid skybox cache file '%s'", path);
+        UnloadFileData(data);
+        return false;
+    }
+
+    GLint unpackAlignment = 4;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &unpackAlignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    unsigned int cubemapId = 0, irradianceId = 0, prefilterId = 0;
+    const unsigned char* src = data + sizeof(header);
+    src = r3d_skybox_cache_unpack(src, &cubemapId, header.cubemapSize, 1, GL_RGB16F, GL_HALF_FLOAT, 3 * sizeof(uint16_t));
+    src = r3d_skybox_cache_unpack(src, &irradianceId, header.irradianceSize, 1, GL_RGB32F, GL_FLOAT, 3 * sizeof(float));
+    src = r3d_skybox_cache_unpack(src, &prefilterId, header.prefilterSize, header.prefilterMips, GL_RGB16F, GL_HALF_FLOAT, 3 * sizeof(uint16_t));
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, unpackAlignment);
+
+    sky->cubemap = (TextureCubemap) {
+        .id = cubemapId,
+        .width = header.cubemapSize,
+        .height = header.cubemapSize,
+        .mipmaps = 1,
+        .format = RL_PIXELFORMAT_UNCOMPRESSED_R16G16B16
+    };
+
+    sky->irradiance = (TextureCubemap) {
+        .id = irradianceId,
+        .width = header.irradianceSize,
+        .height = header.irradianceSize,
+        .mipmaps = 1,
+        .format = RL_PIXELFORMAT_UNCOMPRESSED_R32G32B32
+    };
+
+    sky->prefilter = (TextureCubemap) {
+        .id = prefilterId,
+        .width = header.prefilterSize,
+        .height = header.prefilterSize,
+        .mipmaps = header.prefilterMips,
+        .format = RL_PIXELFORMAT_UNCOMPRESSED_R16G16B16
+    };
+
+    UnloadFileData(data);
+
+    return true;
+}
+
+static void r3d_skybox_cache_save(uint64_t key, R3D_Skybox sky)
+{
+    if (!DirectoryExists(R3D_SKYBOX_CACHE_DIRECTORY) && MakeDirectory(R3D_SKYBOX_CACHE_DIRECTORY) != 0) {
+        TraceLog(LOG_WARNING, "R3D: Failed to create skybox cache directory '%s'", R3D_SKYBOX_CACHE_DIRECTORY);
+        return;
+    }
+
+    r3d_skybox_cache_header_t header = {
+        .magic = R3D_SKYBOX_CACHE_MAGIC,
+        .version = R3D_SKYBOX_CACHE_VERSION,
+        .key = key,
+        .cubemapSize = sky.cubemap.width,
+        .irradianceSize = sky.irradiance.width,
+        .prefilterSize = sky.prefilter.width,
+        .prefilterMips = sky.prefilter.mipmaps
+    };
+
+    int dataSize = (int)sizeof(header)
+        + r3d_skybox_cache_data_size(header.cubemapSize, 1, 3 * sizeof(uint16_t))
+        + r3d_skybox_cache_data_size(header.irradianceSize, 1, 3 * sizeof(float))
+        + r3d_skybox_cache_data_size(header.prefilterSize, header.prefilterMips, 3 * sizeof(uint16_t));
+
+    unsigned char* data = RL_MALLOC(dataSize);
+    if (data == NULL) return;
+
+    memcpy(data, &header, sizeof(header));
+
+    // Rows of small mips are not multiples of 4 bytes
+    GLint packAlignment = 4;
+    glGetIntegerv(GL_PACK_ALIGNMENT, &packAlignment);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    unsigned char* dst = data + sizeof(header);
+    dst = r3d_skybox_cache_pack(dst, sky.cubemap.id, header.cubemapSize, 1, GL_HALF_FLOAT, 3 * sizeof(uint16_t));
+    dst = r3d_skybox_cache_pack(dst, sky.irradiance.id, header.irradianceSize, 1, GL_FLOAT, 3 * sizeof(float));
+    dst = r3d_skybox_cache_pack(dst, sky.prefilter.id, header.prefilterSize, header.prefilterMips, GL_HALF_FLOAT, 3 * sizeof(uint16_t));
+
+    glPixelStorei(GL_PACK_ALIGNMENT, packAlignment);
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%016llx.bin", R3D_SKYBOX_CACHE_DIRECTORY, (unsigned long long)key);
+    if (!SaveFileData(path, data, dataSize)) {
+        TraceLog(LOG_WARNING, "R3D: Failed to write skybox cache file '%s'", path);
+    }
+
+    RL_FREE(data);
+}
+
+
 /* === Public functions === */
 
 R3D_Skybox R3D_LoadSkybox(const char* fileName, CubemapLayout layout)
@@ -262,9 +468,22 @@ R3D_Skybox R3D_LoadSkybox(const char* fileName, CubemapLayout layout)
 R3D_Skybox R3D_LoadSkyboxHDR(const char* fileName, int size)
 {
     R3D_Skybox sky = { 0 };
+
+    // Reuse the generated cubemaps from a previous load of the same file and size
+    uint64_t key = 0;
+    bool useCache = (R3D.state.flags & R3D_FLAG_SKYBOX_CACHE) && r3d_skybox_cache_key(fileName, size, &key);
+    if (useCache && r3d_skybox_cache_load(key, size, &sky)) {
+        return sky;
+    }
+
     sky.cubemap = r3d_skybox_load_from_panorama_hdr(fileName, size);
     sky.irradiance = r3d_skybox_generate_irradiance(sky.cubemap);
     sky.prefilter = r3d_skybox_generate_prefilter(sky.cubemap);
+
+    if (useCache) {
+        r3d_skybox_cache_save(key, sky);
+    }
+
     return sky;
 }
 
@@ -1,6 +1,7 @@
 #include "r3d.h"
 
 #include <raymath.h>
+#include <rlgl.h>
 
 R3D_Sprite R3D_LoadSprite(Texture2D texture, int xFrameCount, int yFrameCount)
 {
@@ -16,12 +17,16 @@ R3D_Sprite R3D_LoadSprite(Texture2D texture, int xFrameCount, int yFrameCount)
     sprite.xFrameCount = xFrameCount;
     sprite.yFrameCount = yFrameCount;
 
+    sprite.region = (Rectangle) { 0.0f, 0.0f, 1.0f, 1.0f };
+
     return sprite;
 }
 
 void R3D_UnloadSprite(R3D_Sprite sprite)
 {
     if (IsMaterialValid(sprite.material)) {
+        // The albedo texture belongs to the caller, often an atlas page shared by other sprites
+        sprite.material.maps[MATERIAL_MAP_ALBEDO].texture.id = rlGetTextureIdDefault();
         UnloadMaterial(sprite.material);
     }
 }
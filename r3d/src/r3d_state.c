@@ -20,6 +20,7 @@
 #include "./r3d_state.h"
 
 #include <assert.h>
+#include <stdio.h>
 #include <raylib.h>
 #include <raymath.h>
 #include <rlgl.h>
@@ -27,6 +28,7 @@
 
 #include "./details/misc/r3d_dds_loader_ext.h"
 #include "./details/misc/r3d_half.h"
+#include "./details/misc/r3d_hash.h"
 #include "./embedded/r3d_textures.h"
 #include "./embedded/r3d_shaders.h"
 
@@ -35,6 +37,19 @@
 
 struct R3D_State R3D = { 0 };
 
+
+/* === Internal types === */
+
+#define R3D_SHADER_CACHE_MAGIC 0x50443352   //< "R3DP"
+
+typedef struct {
+    unsigned int magic;             //< Always 'R3D_SHADER_CACHE_MAGIC'
+    unsigned int format;            //< Driver specific binary format
+    uint64_t key;                   //< Hash of the driver strings and shader sources
+    float compileTime;              //< Source compile time measured when the binary was written (seconds)
+    int length;                     //< Size of the binary data following the header
+} r3d_shader_cache_header_t;
+
 /* === Internal Functions === */
 
 static char* r3d_shader_inject_defines(const char* code, const char* defines[], int count)
@@ -78,6 +93,239 @@ static char* r3d_shader_inject_defines(const char* code, const char* defines[],
     return newShader;
 }
 
+static unsigned int r3d_shader_cache_load(uint64_t key, double* sourceTime)
+{
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%016llx.bin", R3D_SHADER_CACHE_DIRECTORY, (unsigned long long)key);
+    if (!FileExists(path)) return 0;
+
+    int size = 0;
+    unsigned char* data = LoadFileData(path, &size);
+    if (data == NULL) return 0;
+
+    unsigned int id = 0;
+    r3d_shader_cache_header_t header = { 0 };
+
+    if (size > (int)sizeof(header)) {
+        memcpy(&header, data, sizeof(header));
+    }
+
+    if (header.magic == R3D_SHADER_CACHE_MAGIC && header.key == key && header.length == size - (int)sizeof(header)) {
+        id = glCreateProgram();
+        glProgramBinary(id, header.format, data + sizeof(header), header.length);
+
+        // The driver may reject binaries it produced before an update, the caller then compiles from source
+        GLint status = GL_FALSE;
+        glGetProgramiv(id, GL_LINK_STATUS, &status);
+        if (status != GL_TRUE) {
+            TraceLog(LOG_INFO, "R3D: Program binary '%s' rejected by the driver, recompiling", path);
+            glDeleteProgram(id);
+            id = 0;
+        }
+        else {
+            *sourceTime = header.compileTime;
+        }
+    }
+
+    UnloadFileData(data);
+
+    return id;
+}
+
+static void r3d_shader_cache_save(unsigned int id, uint64_t key, double sourceTime)
+{
+    GLint length = 0;
+    glGetProgramiv(id, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        TraceLog(LOG_WARNING, "R3D: The driver returned no binary for program %u, it will not be cached", id);
+        return;
+    }
+
+    unsigned char* data = RL_MALLOC(sizeof(r3d_shader_cache_header_t) + length);
+    if (data == NULL) return;
+
+    GLenum format = 0;
+    glGetProgramBinary(id, length, &length, &format, data + sizeof(r3d_shader_cache_header_t));
+
+    r3d_shader_cache_header_t header = {
+        .magic = R3D_SHADER_CACHE_MAGIC,
+        .format = format,
+        .key = key,
+        .compileTime = (float)sourceTime,
+        .length = length
+    };
+
+    memcpy(data, &header, sizeof(header));
+
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%016llx.bin", R3D_SHADER_CACHE_DIRECTORY, (unsigned long long)key);
+    if (!SaveFileData(path, data, (int)sizeof(header) + length)) {
+        TraceLog(LOG_WARNING, "R3D: Failed to write program binary '%s'", path);
+    }
+
+    RL_FREE(data);
+}
+
+static void r3d_shader_cache_init(void)
+{
+    R3D.shader.cache.enabled = false;
+
+    if (!(R3D.state.flags & R3D_FLAG_SHADER_CACHE)) {
+        return;
+    }
+
+    if (!R3D.support.PROGRAM_BINARY) {
+        TraceLog(LOG_WARNING, "R3D: Shader cache requested but program binaries are not supported");
+        return;
+    }
+
+    if (!DirectoryExists(R3D_SHADER_CACHE_DIRECTORY) && MakeDirectory(R3D_SHADER_CACHE_DIRECTORY) != 0) {
+        TraceLog(LOG_WARNING, "R3D: Failed to create shader cache directory '%s'", R3D_SHADER_CACHE_DIRECTORY);
+        return;
+    }
+
+    // Binaries are only valid for the driver that produced them
+    uint64_t hash = R3D_HASH_FNV1A_SEED;
+    hash = r3d_hash_fnv1a_str(hash, (const char*)glGetString(GL_VENDOR));
+    hash = r3d_hash_fnv1a_str(hash, (const char*)glGetString(GL_RENDERER));
+    hash = r3d_hash_fnv1a_str(hash, (const char*)glGetString(GL_VERSION));
+
+    R3D.shader.cache.driverHash = hash;
+    R3D.shader.cache.enabled = true;
+}
+
+static unsigned int r3d_shader_link_retrievable(const char* vsCode, const char* fsCode)
+{
+    // Some drivers only keep the binary of programs linked with the retrievable hint,
+    // rlgl links before it could be set so the program is built here
+    unsigned int vs = rlCompileShader(vsCode, GL_VERTEX_SHADER);
+    if (vs == 0) return 0;
+
+    unsigned int fs = rlCompileShader(fsCode, GL_FRAGMENT_SHADER);
+    if (fs == 0) {
+        glDeleteShader(vs);
+        return 0;
+    }
+
+    unsigned int id = glCreateProgram();
+    glAttachShader(id, vs);
+    glAttachShader(id, fs);
+    glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(id);
+    glDetachShader(id, vs);
+    glDetachShader(id, fs);
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(id, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[512] = { 0 };
+        glGetProgramInfoLog(id, sizeof(log), NULL, log);
+        TraceLog(LOG_WARNING, "R3D: Failed to link shader program: %s", log);
+        glDeleteProgram(id);
+        return 0;
+    }
+
+    return id;
+}
+
+static unsigned int r3d_shader_compile(const char* vsCode, const char* fsCode)
+{
+    double start = GetTime();
+    unsigned int id = 0;
+
+    // Try the binary cache first, keyed by the final sources (defines included)
+    uint64_t key = 0;
+    if (R3D.shader.cache.enabled) {
+        key = r3d_hash_fnv1a_str(R3D.shader.cache.driverHash, vsCode);
+        key = r3d_hash_fnv1a_str(key, fsCode);
+
+        double sourceTime = 0.0;
+        id = r3d_shader_cache_load(key, &sourceTime);
+
+        if (id != 0) {
+            R3D.shader.stats.cacheHits++;
+            R3D.shader.stats.cacheSavedTime += sourceTime - (GetTime() - start);
+        }
+    }
+
+    // NOTE: rlgl queries the link status, so the driver has finished compiling on return
+    if (id == 0 && R3D.shader.cache.enabled && glProgramParameteri != NULL) {
+        id = r3d_shader_link_retrievable(vsCode, fsCode);
+        if (id != 0) {
+            r3d_shader_cache_save(id, key, GetTime() - start);
+        }
+    }
+    else if (id == 0) {
+        id = rlLoadShaderCode(vsCode, fsCode);
+        if (R3D.shader.cache.enabled && id != 0) {
+            r3d_shader_cache_save(id, key, GetTime() - start);
+        }
+    }
+
+    double elapsed = GetTime() - start;
+
+    R3D.shader.stats.programCount++;
+    R3D.shader.stats.compileTime += elapsed;
+    if (elapsed > R3D.shader.stats.maxCompileTime) {
+        R3D.shader.stats.maxCompileTime = elapsed;
+    }
+
+    return id;
+}
+
+static unsigned int r3d_shader_compile_variant(const char* vsCode, const char* fsCode, const char* defines[], int count)
+{
+    // Defines are injected in both stages so they can share the same feature switches
+    char* vsVariant = r3d_shader_inject_defines(vsCode, defines, count);
+    char* fsVariant = r3d_shader_inject_defines(fsCode, defines, count);
+
+    unsigned int id = r3d_shader_compile(vsVariant, fsVariant);
+    R3D.shader.stats.variantCount++;
+
+    RL_FREE(vsVariant);
+    RL_FREE(fsVariant);
+
+    return id;
+}
+
+static unsigned int r3d_shader_compile_feedback(const char* vsCode, const char* varyings[], int count)
+{
+    // The captured outputs must be declared before linking, so these programs skip rlgl and the binary cache
+    double start = GetTime();
+
+    unsigned int vs = rlCompileShader(vsCode, GL_VERTEX_SHADER);
+    if (vs == 0) return 0;
+
+    unsigned int id = glCreateProgram();
+    glAttachShader(id, vs);
+    glTransformFeedbackVaryings(id, count, varyings, GL_INTERLEAVED_ATTRIBS);
+    glLinkProgram(id);
+    glDetachShader(id, vs);
+    glDeleteShader(vs);
+
+    GLint status = GL_FALSE;
+    glGetProgramiv(id, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        char log[512] = { 0 };
+        glGetProgramInfoLog(id, sizeof(log), NULL, log);
+        TraceLog(LOG_WARNING, "R3D: Failed to link transform feedback program: %s", log);
+        glDeleteProgram(id);
+        return 0;
+    }
+
+    double elapsed = GetTime() - start;
+
+    R3D.shader.stats.programCount++;
+    R3D.shader.stats.compileTime += elapsed;
+    if (elapsed > R3D.shader.stats.maxCompileTime) {
+        R3D.shader.stats.maxCompileTime = elapsed;
+    }
+
+    return id;
+}
+
 static void r3d_texture_create_hdr(int width, int height)
 {
     if (R3D.support.TEX_R11G11B10F) {
@@ -95,6 +343,41 @@ static void r3d_texture_create_hdr(int width, int height)
 }
 
 
+// Returns the storage of a transient target, the slots come from the render graph aliasing
+// All transient targets are HDR color targets, post-processing ones are at the output resolution
+static unsigned int r3d_framebuffer_get_transient(r3d_target_t target, int width, int height)
+{
+    int slot = R3D.container.renderGraph.slots[target];
+    unsigned int* texture = &R3D.framebuffer.transient[slot];
+
+    if (*texture == 0) {
+        glGenTextures(1, texture);
+        glBindTexture(GL_TEXTURE_2D, *texture);
+
+        // Linear filtering is required by post-processing, other passes sample texel centers
+        r3d_texture_create_hdr(width, height);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    return *texture;
+}
+
+static void r3d_framebuffer_unload_transients(void)
+{
+    for (int i = 0; i < R3D_RENDER_GRAPH_MAX_RESOURCES; i++) {
+        if (R3D.framebuffer.transient[i] != 0) {
+            glDeleteTextures(1, &R3D.framebuffer.transient[i]);
+            R3D.framebuffer.transient[i] = 0;
+        }
+    }
+}
+
+
 /* === Helper functions === */
 
 bool r3d_check_texture_format_support(unsigned int format)
@@ -112,7 +395,20 @@ void r3d_framebuffers_load(int width, int height)
     r3d_framebuffer_load_gbuffer(width, height);
     r3d_framebuffer_load_deferred(width, height);
     r3d_framebuffer_load_scene(width, height);
-    r3d_framebuffer_load_pingpong_post(width, height);
+
+    // Post-processing runs at the output resolution, larger than the internal one when TAA upsamples
+    int outputWidth = R3D.state.resolution.outputWidth;
+    int outputHeight = R3D.state.resolution.outputHeight;
+
+    r3d_framebuffer_load_pingpong_post(outputWidth, outputHeight);
+
+    if (R3D.state.flags & R3D_FLAG_TAA) {
+        r3d_framebuffer_load_pingpong_taa(outputWidth, outputHeight);
+    }
+
+    if (R3D.state.flags & R3D_FLAG_OIT) {
+        r3d_framebuffer_load_oit(width, height);
+    }
 
     if (R3D.env.ssaoEnabled) {
         r3d_framebuffer_load_pingpong_ssao(width, height);
@@ -130,6 +426,14 @@ void r3d_framebuffers_unload(void)
     r3d_framebuffer_unload_scene();
     r3d_framebuffer_unload_pingpong_post();
 
+    if (R3D.framebuffer.taa.id != 0) {
+        r3d_framebuffer_unload_pingpong_taa();
+    }
+
+    if (R3D.framebuffer.oit.id != 0) {
+        r3d_framebuffer_unload_oit();
+    }
+
     if (R3D.framebuffer.pingPongSSAO.id != 0) {
         r3d_framebuffer_unload_pingpong_ssao();
     }
@@ -137,6 +441,8 @@ void r3d_framebuffers_unload(void)
     if (R3D.framebuffer.mipChainBloom.id != 0) {
         r3d_framebuffer_unload_mipchain_bloom();
     }
+
+    r3d_framebuffer_unload_transients();
 }
 
 void r3d_textures_load(void)
@@ -167,6 +473,13 @@ void r3d_textures_unload(void)
 
 void r3d_shaders_load(void)
 {
+    r3d_shader_cache_init();
+
+    int programCount = R3D.shader.stats.programCount;
+    int cacheHits = R3D.shader.stats.cacheHits;
+    double compileTime = R3D.shader.stats.compileTime;
+    double savedTime = R3D.shader.stats.cacheSavedTime;
+
     // Load generation shaders
     r3d_shader_load_generate_cubemap_from_equirectangular();
     r3d_shader_load_generate_irradiance_convolution();
@@ -186,10 +499,8 @@ void r3d_shaders_load(void)
     // Load screen shaders
     r3d_shader_load_screen_ambient_ibl();
     r3d_shader_load_screen_ambient();
-    r3d_shader_load_screen_lighting();
     r3d_shader_load_screen_scene();
-    r3d_shader_load_screen_tonemap();
-    r3d_shader_load_screen_adjustment();
+    r3d_shader_load_screen_post(R3D.env.fogMode, R3D.env.tonemapMode);
 
     if (R3D.env.ssaoEnabled) {
         r3d_shader_load_generate_gaussian_blur_dual_pass();
@@ -200,12 +511,23 @@ void r3d_shaders_load(void)
         r3d_shader_load_generate_upsampling();
         r3d_shader_load_screen_bloom();
     }
-    if (R3D.env.fogMode != R3D_FOG_DISABLED) {
-        r3d_shader_load_screen_fog();
-    }
     if (R3D.state.flags & R3D_FLAG_FXAA) {
         r3d_shader_load_screen_fxaa();
     }
+    if (R3D.state.flags & R3D_FLAG_TAA) {
+        r3d_shader_load_screen_taa();
+    }
+    if (R3D.state.flags & R3D_FLAG_OIT) {
+        r3d_shader_load_screen_oit();
+    }
+
+    // Startup report, lazily compiled variants are only counted in 'R3D_GetShaderStats'
+    TraceLog(LOG_INFO, "R3D: %i shader programs ready in %.2f ms (%i from binary cache, %.2f ms saved)",
+        R3D.shader.stats.programCount - programCount,
+        (R3D.shader.stats.compileTime - compileTime) * 1000.0,
+        R3D.shader.stats.cacheHits - cacheHits,
+        (R3D.shader.stats.cacheSavedTime - savedTime) * 1000.0
+    );
 }
 
 void r3d_shaders_unload(void)
@@ -230,23 +552,45 @@ void r3d_shaders_unload(void)
     // Unload screen shaders
     rlUnloadShaderProgram(R3D.shader.screen.ambientIbl.id);
     rlUnloadShaderProgram(R3D.shader.screen.ambient.id);
-    rlUnloadShaderProgram(R3D.shader.screen.lighting.id);
     rlUnloadShaderProgram(R3D.shader.screen.scene.id);
-    rlUnloadShaderProgram(R3D.shader.screen.tonemap.id);
-    rlUnloadShaderProgram(R3D.shader.screen.adjustment.id);
+
+    for (int i = 0; i < R3D_SHADER_LIGHTING_VARIANTS; i++) {
+        if (R3D.shader.screen.lighting[i].id != 0) {
+            rlUnloadShaderProgram(R3D.shader.screen.lighting[i].id);
+        }
+    }
+
+    for (int i = 0; i < R3D_SHADER_POST_FOG_VARIANTS; i++) {
+        for (int j = 0; j < R3D_SHADER_POST_TONEMAP_VARIANTS; j++) {
+            if (R3D.shader.screen.post[i][j].id != 0) {
+                rlUnloadShaderProgram(R3D.shader.screen.post[i][j].id);
+            }
+        }
+    }
 
     if (R3D.shader.screen.ssao.id != 0) {
         rlUnloadShaderProgram(R3D.shader.screen.ssao.id);
     }
+    if (R3D.shader.screen.ssaoTemporal.id != 0) {
+        rlUnloadShaderProgram(R3D.shader.screen.ssaoTemporal.id);
+    }
     if (R3D.shader.screen.bloom.id != 0) {
         rlUnloadShaderProgram(R3D.shader.screen.bloom.id);
     }
-    if (R3D.shader.screen.fog.id != 0) {
-        rlUnloadShaderProgram(R3D.shader.screen.fog.id);
-    }
     if (R3D.shader.screen.fxaa.id != 0) {
         rlUnloadShaderProgram(R3D.shader.screen.fxaa.id);
     }
+    if (R3D.shader.screen.taa.id != 0) {
+        rlUnloadShaderProgram(R3D.shader.screen.taa.id);
+    }
+    if (R3D.shader.screen.oit.id != 0) {
+        rlUnloadShaderProgram(R3D.shader.screen.oit.id);
+    }
+
+    // Unload simulation shaders
+    if (R3D.shader.simulate.particles.id != 0) {
+        rlUnloadShaderProgram(R3D.shader.simulate.particles.id);
+    }
 }
 
 
@@ -348,10 +692,28 @@ void r3d_framebuffer_load_pingpong_ssao(int width, int height)
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     }
-    glBindTexture(GL_TEXTURE_2D, 0);
     ssao->target = textures[0];
     ssao->source = textures[1];
 
+    // Generate the accumulation buffers, the view distance rejects the history on disocclusion
+    if (R3D.env.ssaoTemporal) {
+        GLuint history[2];
+        glGenTextures(2, history);
+        for (int i = 0; i < 2; i++) {
+            glBindTexture(GL_TEXTURE_2D, history[i]);
+            glTexImage2D(GL_TEXTURE_2D, 0, R3D.support.TEX_RG16F ? GL_RG16F : GL_RG32F, width, height, 0, GL_RG, GL_FLOAT, NULL);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        }
+        ssao->history = history[0];
+        ssao->accumulated = history[1];
+        R3D.state.ssaoHistory.historyValid = false;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
     // Activate the draw buffers for all the attachments
     rlActiveDrawBuffers(1);
 
@@ -375,21 +737,9 @@ void r3d_framebuffer_load_deferred(int width, int height)
 
     rlEnableFramebuffer(deferred->id);
 
-    // Generate diffuse/specular textures
-    GLuint textures[2];
-    glGenTextures(2, textures);
-    for (int i = 0; i < 2; i++) {
-        glBindTexture(GL_TEXTURE_2D, textures[i]);
-
-        r3d_texture_create_hdr(width, height);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    }
-    glBindTexture(GL_TEXTURE_2D, 0);
-    deferred->diffuse = textures[0];
-    deferred->specular = textures[1];
+    // Get diffuse/specular textures, shared with the post-processing targets
+    deferred->diffuse = r3d_framebuffer_get_transient(R3D_TARGET_DIFFUSE, width, height);
+    deferred->specular = r3d_framebuffer_get_transient(R3D_TARGET_SPECULAR, width, height);
 
     // Activate the draw buffers for all the attachments
     rlActiveDrawBuffers(2);
@@ -514,30 +864,109 @@ void r3d_framebuffer_load_pingpong_post(int width, int height)
 
     rlEnableFramebuffer(post->id);
 
-    // Generate (color) buffers
-    GLuint textures[2];
+    // Get (color) buffers, shared with the deferred lighting targets
+    post->target = r3d_framebuffer_get_transient(R3D_TARGET_POST_TARGET, width, height);
+    post->source = r3d_framebuffer_get_transient(R3D_TARGET_POST_SOURCE, width, height);
+
+    // Activate the draw buffers for all the attachments
+    rlActiveDrawBuffers(1);
+
+    // Attach the textures to the framebuffer
+    rlFramebufferAttach(post->id, post->target, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+
+    // Check if the framebuffer is complete
+    if (!rlFramebufferComplete(post->id)) {
+        TraceLog(LOG_WARNING, "Framebuffer is not complete");
+    }
+}
+
+void r3d_framebuffer_load_pingpong_taa(int width, int height)
+{
+    struct r3d_fb_pingpong_taa_t* taa = &R3D.framebuffer.taa;
+
+    taa->id = rlLoadFramebuffer();
+    if (taa->id == 0) {
+        TraceLog(LOG_WARNING, "Failed to create framebuffer");
+    }
+
+    rlEnableFramebuffer(taa->id);
+
+    // Generate (color) buffers, the history is sampled between pixels when reprojected
+    unsigned int textures[2];
     glGenTextures(2, textures);
+
     for (int i = 0; i < 2; i++) {
         glBindTexture(GL_TEXTURE_2D, textures[i]);
-
         r3d_texture_create_hdr(width, height);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     }
-    glBindTexture(GL_TEXTURE_2D, 0);
-    post->target = textures[0];
-    post->source = textures[1];
+
+    taa->source = textures[0];
+    taa->target = textures[1];
 
     // Activate the draw buffers for all the attachments
     rlActiveDrawBuffers(1);
 
     // Attach the textures to the framebuffer
-    rlFramebufferAttach(post->id, post->target, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+    rlFramebufferAttach(taa->id, taa->target, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
 
     // Check if the framebuffer is complete
-    if (!rlFramebufferComplete(post->id)) {
+    if (!rlFramebufferComplete(taa->id)) {
+        TraceLog(LOG_WARNING, "Framebuffer is not complete");
+    }
+
+    // The new history holds nothing to reproject yet
+    R3D.state.taa.historyValid = false;
+}
+
+void r3d_framebuffer_load_oit(int width, int height)
+{
+    struct r3d_fb_oit_t* oit = &R3D.framebuffer.oit;
+
+    oit->id = rlLoadFramebuffer();
+    if (oit->id == 0) {
+        TraceLog(LOG_WARNING, "Failed to create framebuffer");
+    }
+
+    rlEnableFramebuffer(oit->id);
+
+    // The accumulation needs float precision, the half-float formats go with the RG16F support
+    bool half = R3D.support.TEX_RG16F;
+
+    glGenTextures(1, &oit->accum);
+    glBindTexture(GL_TEXTURE_2D, oit->accum);
+    glTexImage2D(GL_TEXTURE_2D, 0, half ? GL_RGBA16F : GL_RGBA32F, width, height, 0, GL_RGBA, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glGenTextures(1, &oit->weight);
+    glBindTexture(GL_TEXTURE_2D, oit->weight);
+    glTexImage2D(GL_TEXTURE_2D, 0, half ? GL_R16F : GL_R32F, width, height, 0, GL_RED, GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // Attach the depth-stencil buffer from the G-buffer, the transparent surfaces only test against it
+    glFramebufferTexture2D(
+        GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+        GL_TEXTURE_2D, R3D.framebuffer.gBuffer.depth, 0
+    );
+
+    // Activate the draw buffers for all the attachments
+    rlActiveDrawBuffers(2);
+
+    // Attach the textures to the framebuffer
+    rlFramebufferAttach(oit->id, oit->accum, RL_ATTACHMENT_COLOR_CHANNEL0, RL_ATTACHMENT_TEXTURE2D, 0);
+    rlFramebufferAttach(oit->id, oit->weight, RL_ATTACHMENT_COLOR_CHANNEL1, RL_ATTACHMENT_TEXTURE2D, 0);
+
+    // Check if the framebuffer is complete
+    if (!rlFramebufferComplete(oit->id)) {
         TraceLog(LOG_WARNING, "Framebuffer is not complete");
     }
 }
@@ -564,6 +993,11 @@ void r3d_framebuffer_unload_pingpong_ssao(void)
     rlUnloadTexture(ssao->source);
     rlUnloadTexture(ssao->target);
 
+    if (ssao->history != 0) {
+        rlUnloadTexture(ssao->history);
+        rlUnloadTexture(ssao->accumulated);
+    }
+
     rlUnloadFramebuffer(ssao->id);
 
     memset(ssao, 0, sizeof(struct r3d_fb_pingpong_ssao_t));
@@ -573,9 +1007,7 @@ void r3d_framebuffer_unload_deferred(void)
 {
     struct r3d_fb_deferred_t* deferred = &R3D.framebuffer.deferred;
 
-    rlUnloadTexture(deferred->diffuse);
-    rlUnloadTexture(deferred->specular);
-
+    // The textures are transient targets, unloaded with the render graph slots
     rlUnloadFramebuffer(deferred->id);
 
     memset(deferred, 0, sizeof(struct r3d_fb_deferred_t));
@@ -612,20 +1044,42 @@ void r3d_framebuffer_unload_pingpong_post(void)
 {
     struct r3d_fb_pingpong_post_t* post = &R3D.framebuffer.post;
 
-    rlUnloadTexture(post->source);
-    rlUnloadTexture(post->target);
-
+    // The textures are transient targets, unloaded with the render graph slots
     rlUnloadFramebuffer(post->id);
 
     memset(post, 0, sizeof(struct r3d_fb_pingpong_post_t));
 }
 
+void r3d_framebuffer_unload_pingpong_taa(void)
+{
+    struct r3d_fb_pingpong_taa_t* taa = &R3D.framebuffer.taa;
+
+    rlUnloadTexture(taa->source);
+    rlUnloadTexture(taa->target);
+
+    rlUnloadFramebuffer(taa->id);
+
+    memset(taa, 0, sizeof(struct r3d_fb_pingpong_taa_t));
+}
+
+void r3d_framebuffer_unload_oit(void)
+{
+    struct r3d_fb_oit_t* oit = &R3D.framebuffer.oit;
+
+    rlUnloadTexture(oit->accum);
+    rlUnloadTexture(oit->weight);
+
+    rlUnloadFramebuffer(oit->id);
+
+    memset(oit, 0, sizeof(struct r3d_fb_oit_t));
+}
+
 
 /* === Shader loading functions === */
 
 void r3d_shader_load_generate_gaussian_blur_dual_pass(void)
 {
-    R3D.shader.generate.gaussianBlurDualPass.id = rlLoadShaderCode(
+    R3D.shader.generate.gaussianBlurDualPass.id = r3d_shader_compile(
         VS_COMMON_SCREEN, FS_GENERATE_GAUSSIAN_BLUR_DUAL_PASS
     );
 
@@ -639,7 +1093,7 @@ void r3d_shader_load_generate_gaussian_blur_dual_pass(void)
 
 void r3d_shader_load_generate_downsampling(void)
 {
-    R3D.shader.generate.downsampling.id = rlLoadShaderCode(
+    R3D.shader.generate.downsampling.id = r3d_shader_compile(
         VS_COMMON_SCREEN, FS_GENERATE_DOWNSAMPLING
     );
 
@@ -654,7 +1108,7 @@ void r3d_shader_load_generate_downsampling(void)
 
 void r3d_shader_load_generate_upsampling(void)
 {
-    R3D.shader.generate.upsampling.id = rlLoadShaderCode(
+    R3D.shader.generate.upsampling.id = r3d_shader_compile(
         VS_COMMON_SCREEN, FS_GENERATE_UPSAMPLING
     );
 
@@ -668,7 +1122,7 @@ void r3d_shader_load_generate_upsampling(void)
 
 void r3d_shader_load_generate_cubemap_from_equirectangular(void)
 {
-    R3D.shader.generate.cubemapFromEquirectangular.id = rlLoadShaderCode(
+    R3D.shader.generate.cubemapFromEquirectangular.id = r3d_shader_compile(
         VS_COMMON_CUBEMAP, FS_GENERATE_CUBEMAP_FROM_EQUIRECTANGULAR
     );
 
@@ -683,7 +1137,7 @@ void r3d_shader_load_generate_cubemap_from_equirectangular(void)
 
 void r3d_shader_load_generate_irradiance_convolution(void)
 {
-    R3D.shader.generate.irradianceConvolution.id = rlLoadShaderCode(
+    R3D.shader.generate.irradianceConvolution.id = r3d_shader_compile(
         VS_COMMON_CUBEMAP, FS_GENERATE_IRRADIANCE_CONVOLUTION
     );
 
@@ -698,7 +1152,7 @@ void r3d_shader_load_generate_irradiance_convolution(void)
 
 void r3d_shader_load_generate_prefilter(void)
 {
-    R3D.shader.generate.prefilter.id = rlLoadShaderCode(
+    R3D.shader.generate.prefilter.id = r3d_shader_compile(
         VS_COMMON_CUBEMAP, FS_GENERATE_PREFILTER
     );
 
@@ -714,7 +1168,7 @@ void r3d_shader_load_generate_prefilter(void)
 
 void r3d_shader_load_raster_geometry(void)
 {
-    R3D.shader.raster.geometry.id = rlLoadShaderCode(
+    R3D.shader.raster.geometry.id = r3d_shader_compile(
         VS_RASTER_GEOMETRY, FS_RASTER_GEOMETRY
     );
 
@@ -748,7 +1202,7 @@ void r3d_shader_load_raster_geometry(void)
 
 void r3d_shader_load_raster_geometry_inst(void)
 {
-    R3D.shader.raster.geometryInst.id = rlLoadShaderCode(
+    R3D.shader.raster.geometryInst.id = r3d_shader_compile(
         VS_RASTER_GEOMETRY_INST, FS_RASTER_GEOMETRY
     );
 
@@ -783,7 +1237,7 @@ void r3d_shader_load_raster_geometry_inst(void)
 
 void r3d_shader_load_raster_forward(void)
 {
-    R3D.shader.raster.forward.id = rlLoadShaderCode(
+    R3D.shader.raster.forward.id = r3d_shader_compile(
         VS_RASTER_FORWARD, FS_RASTER_FORWARD
     );
 
@@ -815,6 +1269,7 @@ void r3d_shader_load_raster_forward(void)
     r3d_shader_get_location(raster.forward, uHasSkybox);
     r3d_shader_get_location(raster.forward, uAlphaScissorThreshold);
     r3d_shader_get_location(raster.forward, uViewPosition);
+    r3d_shader_get_location(raster.forward, uOIT);
 
     r3d_shader_enable(raster.forward);
 
@@ -861,7 +1316,7 @@ void r3d_shader_load_raster_forward(void)
 
 void r3d_shader_load_raster_forward_inst(void)
 {
-    R3D.shader.raster.forwardInst.id = rlLoadShaderCode(
+    R3D.shader.raster.forwardInst.id = r3d_shader_compile(
         VS_RASTER_FORWARD_INST, FS_RASTER_FORWARD
     );
 
@@ -894,6 +1349,7 @@ void r3d_shader_load_raster_forward_inst(void)
     r3d_shader_get_location(raster.forwardInst, uHasSkybox);
     r3d_shader_get_location(raster.forwardInst, uAlphaScissorThreshold);
     r3d_shader_get_location(raster.forwardInst, uViewPosition);
+    r3d_shader_get_location(raster.forwardInst, uOIT);
 
     r3d_shader_enable(raster.forwardInst);
 
@@ -940,7 +1396,7 @@ void r3d_shader_load_raster_forward_inst(void)
 
 void r3d_shader_load_raster_skybox(void)
 {
-    R3D.shader.raster.skybox.id = rlLoadShaderCode(
+    R3D.shader.raster.skybox.id = r3d_shader_compile(
         VS_RASTER_SKYBOX, FS_RASTER_SKYBOX
     );
 
@@ -956,7 +1412,7 @@ void r3d_shader_load_raster_skybox(void)
 
 void r3d_shader_load_raster_depth(void)
 {
-    R3D.shader.raster.depth.id = rlLoadShaderCode(
+    R3D.shader.raster.depth.id = r3d_shader_compile(
         VS_RASTER_DEPTH, FS_RASTER_DEPTH
     );
 
@@ -968,7 +1424,7 @@ void r3d_shader_load_raster_depth(void)
 
 void r3d_shader_load_raster_depth_inst(void)
 {
-    R3D.shader.raster.depthInst.id = rlLoadShaderCode(
+    R3D.shader.raster.depthInst.id = r3d_shader_compile(
         VS_RASTER_DEPTH_INST, FS_RASTER_DEPTH
     );
 
@@ -983,7 +1439,7 @@ void r3d_shader_load_raster_depth_inst(void)
 
 void r3d_shader_load_raster_depth_cube(void)
 {
-    R3D.shader.raster.depthCube.id = rlLoadShaderCode(
+    R3D.shader.raster.depthCube.id = r3d_shader_compile(
         VS_RASTER_DEPTH_CUBE, FS_RASTER_DEPTH_CUBE
     );
 
@@ -998,7 +1454,7 @@ void r3d_shader_load_raster_depth_cube(void)
 
 void r3d_shader_load_raster_depth_cube_inst(void)
 {
-    R3D.shader.raster.depthCubeInst.id = rlLoadShaderCode(
+    R3D.shader.raster.depthCubeInst.id = r3d_shader_compile(
         VS_RASTER_DEPTH_CUBE_INST, FS_RASTER_DEPTH_CUBE
     );
 
@@ -1015,7 +1471,7 @@ void r3d_shader_load_raster_depth_cube_inst(void)
 
 void r3d_shader_load_screen_ssao(void)
 {
-    R3D.shader.screen.ssao.id = rlLoadShaderCode(
+    R3D.shader.screen.ssao.id = r3d_shader_compile(
         VS_COMMON_SCREEN, FS_SCREEN_SSAO
     );
 
@@ -1032,6 +1488,9 @@ void r3d_shader_load_screen_ssao(void)
     r3d_shader_get_location(screen.ssao, uFar);
     r3d_shader_get_location(screen.ssao, uRadius);
     r3d_shader_get_location(screen.ssao, uBias);
+    r3d_shader_get_location(screen.ssao, uSampleCount);
+    r3d_shader_get_location(screen.ssao, uSampleOffset);
+    r3d_shader_get_location(screen.ssao, uNoiseOffset);
 
     r3d_shader_enable(screen.ssao);
     r3d_shader_set_sampler2D_slot(screen.ssao, uTexDepth, 0);
@@ -1041,13 +1500,34 @@ void r3d_shader_load_screen_ssao(void)
     r3d_shader_disable();
 }
 
+void r3d_shader_load_screen_ssao_temporal(void)
+{
+    R3D.shader.screen.ssaoTemporal.id = r3d_shader_compile(
+        VS_COMMON_SCREEN, FS_SCREEN_SSAO_TEMPORAL
+    );
+
+    r3d_shader_get_location(screen.ssaoTemporal, uTexSSAO);
+    r3d_shader_get_location(screen.ssaoTemporal, uTexHistory);
+    r3d_shader_get_location(screen.ssaoTemporal, uTexDepth);
+    r3d_shader_get_location(screen.ssaoTemporal, uMatInvViewProj);
+    r3d_shader_get_location(screen.ssaoTemporal, uMatPrevViewProj);
+    r3d_shader_get_location(screen.ssaoTemporal, uViewPosition);
+    r3d_shader_get_location(screen.ssaoTemporal, uPrevViewPosition);
+    r3d_shader_get_location(screen.ssaoTemporal, uBlend);
+
+    r3d_shader_enable(screen.ssaoTemporal);
+    r3d_shader_set_sampler2D_slot(screen.ssaoTemporal, uTexSSAO, 0);
+    r3d_shader_set_sampler2D_slot(screen.ssaoTemporal, uTexHistory, 1);
+    r3d_shader_set_sampler2D_slot(screen.ssaoTemporal, uTexDepth, 2);
+    r3d_shader_disable();
+}
+
 void r3d_shader_load_screen_ambient_ibl(void)
 {
     const char* defines[] = { "#define IBL" };
-    char* fsCode = r3d_shader_inject_defines(FS_SCREEN_AMBIENT, defines, 1);
-    R3D.shader.screen.ambientIbl.id = rlLoadShaderCode(VS_COMMON_SCREEN, fsCode);
-
-    RL_FREE(fsCode);
+    R3D.shader.screen.ambientIbl.id = r3d_shader_compile_variant(
+        VS_COMMON_SCREEN, FS_SCREEN_AMBIENT, defines, 1
+    );
 
     r3d_shader_screen_ambient_ibl_t* shader = &R3D.shader.screen.ambientIbl;
 
@@ -1081,7 +1561,7 @@ void r3d_shader_load_screen_ambient_ibl(void)
 
 void r3d_shader_load_screen_ambient(void)
 {
-    R3D.shader.screen.ambient.id = rlLoadShaderCode(
+    R3D.shader.screen.ambient.id = r3d_shader_compile(
         VS_COMMON_SCREEN, FS_SCREEN_AMBIENT
     );
 
@@ -1097,57 +1577,75 @@ void r3d_shader_load_screen_ambient(void)
     r3d_shader_disable();
 }
 
-void r3d_shader_load_screen_lighting(void)
-{
-    R3D.shader.screen.lighting.id = rlLoadShaderCode(VS_COMMON_SCREEN, FS_SCREEN_LIGHTING);
-    r3d_shader_screen_lighting_t* shader = &R3D.shader.screen.lighting;
-
-    r3d_shader_get_location(screen.lighting, uTexAlbedo);
-    r3d_shader_get_location(screen.lighting, uTexNormal);
-    r3d_shader_get_location(screen.lighting, uTexDepth);
-    r3d_shader_get_location(screen.lighting, uTexORM);
-    r3d_shader_get_location(screen.lighting, uTexNoise);
-    r3d_shader_get_location(screen.lighting, uViewPosition);
-    r3d_shader_get_location(screen.lighting, uMatInvProj);
-    r3d_shader_get_location(screen.lighting, uMatInvView);
-
-    r3d_shader_get_location(screen.lighting, uLight.matVP);
-    r3d_shader_get_location(screen.lighting, uLight.shadowMap);
-    r3d_shader_get_location(screen.lighting, uLight.shadowCubemap);
-    r3d_shader_get_location(screen.lighting, uLight.color);
-    r3d_shader_get_location(screen.lighting, uLight.position);
-    r3d_shader_get_location(screen.lighting, uLight.direction);
-    r3d_shader_get_location(screen.lighting, uLight.specular);
-    r3d_shader_get_location(screen.lighting, uLight.energy);
-    r3d_shader_get_location(screen.lighting, uLight.range);
-    r3d_shader_get_location(screen.lighting, uLight.size);
-    r3d_shader_get_location(screen.lighting, uLight.near);
-    r3d_shader_get_location(screen.lighting, uLight.far);
-    r3d_shader_get_location(screen.lighting, uLight.attenuation);
-    r3d_shader_get_location(screen.lighting, uLight.innerCutOff);
-    r3d_shader_get_location(screen.lighting, uLight.outerCutOff);
-    r3d_shader_get_location(screen.lighting, uLight.shadowMapTxlSz);
-    r3d_shader_get_location(screen.lighting, uLight.shadowBias);
-    r3d_shader_get_location(screen.lighting, uLight.type);
-    r3d_shader_get_location(screen.lighting, uLight.shadow);
-
-    r3d_shader_enable(screen.lighting);
-
-    r3d_shader_set_sampler2D_slot(screen.lighting, uTexAlbedo, 0);
-    r3d_shader_set_sampler2D_slot(screen.lighting, uTexNormal, 1);
-    r3d_shader_set_sampler2D_slot(screen.lighting, uTexDepth, 2);
-    r3d_shader_set_sampler2D_slot(screen.lighting, uTexORM, 3);
-    r3d_shader_set_sampler2D_slot(screen.lighting, uTexNoise, 4);
-
-    r3d_shader_set_sampler2D_slot(screen.lighting, uLight.shadowMap, 5);
-    r3d_shader_set_samplerCube_slot(screen.lighting, uLight.shadowCubemap, 6);
+void r3d_shader_load_screen_lighting(int variant)
+{
+    // Light type and shadows are resolved at compile time, one program per feature mask
+    const char* defines[3];
+    int count = 0;
+
+    if (variant & R3D_SHADER_LIGHTING_SHADOW) defines[count++] = "#define SHADOW";
+    if (variant & R3D_SHADER_LIGHTING_SPOT) defines[count++] = "#define LIGHT_SPOT";
+    if (variant & R3D_SHADER_LIGHTING_OMNI) defines[count++] = "#define LIGHT_OMNI";
+
+    R3D.shader.screen.lighting[variant].id = r3d_shader_compile_variant(
+        VS_COMMON_SCREEN, FS_SCREEN_LIGHTING, defines, count
+    );
+
+    r3d_shader_get_location(screen.lighting[variant], uTexAlbedo);
+    r3d_shader_get_location(screen.lighting[variant], uTexNormal);
+    r3d_shader_get_location(screen.lighting[variant], uTexDepth);
+    r3d_shader_get_location(screen.lighting[variant], uTexORM);
+    r3d_shader_get_location(screen.lighting[variant], uTexNoise);
+    r3d_shader_get_location(screen.lighting[variant], uViewPosition);
+    r3d_shader_get_location(screen.lighting[variant], uMatInvProj);
+    r3d_shader_get_location(screen.lighting[variant], uMatInvView);
+
+    r3d_shader_get_location(screen.lighting[variant], uLight.matVP);
+    r3d_shader_get_location(screen.lighting[variant], uLight.shadowMap);
+    r3d_shader_get_location(screen.lighting[variant], uLight.shadowCubemap);
+    r3d_shader_get_location(screen.lighting[variant], uLight.color);
+    r3d_shader_get_location(screen.lighting[variant], uLight.position);
+    r3d_shader_get_location(screen.lighting[variant], uLight.direction);
+    r3d_shader_get_location(screen.lighting[variant], uLight.specular);
+    r3d_shader_get_location(screen.lighting[variant], uLight.energy);
+    r3d_shader_get_location(screen.lighting[variant], uLight.range);
+    r3d_shader_get_location(screen.lighting[variant], uLight.size);
+    r3d_shader_get_location(screen.lighting[variant], uLight.near);
+    r3d_shader_get_location(screen.lighting[variant], uLight.far);
+    r3d_shader_get_location(screen.lighting[variant], uLight.attenuation);
+    r3d_shader_get_location(screen.lighting[variant], uLight.innerCutOff);
+    r3d_shader_get_location(screen.lighting[variant], uLight.outerCutOff);
+    r3d_shader_get_location(screen.lighting[variant], uLight.shadowMapTxlSz);
+    r3d_shader_get_location(screen.lighting[variant], uLight.shadowBias);
+
+    r3d_shader_enable(screen.lighting[variant]);
+
+    r3d_shader_set_sampler2D_slot(screen.lighting[variant], uTexAlbedo, 0);
+    r3d_shader_set_sampler2D_slot(screen.lighting[variant], uTexNormal, 1);
+    r3d_shader_set_sampler2D_slot(screen.lighting[variant], uTexDepth, 2);
+    r3d_shader_set_sampler2D_slot(screen.lighting[variant], uTexORM, 3);
+    r3d_shader_set_sampler2D_slot(screen.lighting[variant], uTexNoise, 4);
+
+    r3d_shader_set_sampler2D_slot(screen.lighting[variant], uLight.shadowMap, 5);
+    r3d_shader_set_samplerCube_slot(screen.lighting[variant], uLight.shadowCubemap, 6);
 
     r3d_shader_disable();
 }
 
+int r3d_shader_get_lighting_variant(R3D_LightType type, bool shadow)
+{
+    int variant = 0;
+
+    if (shadow) variant |= R3D_SHADER_LIGHTING_SHADOW;
+    if (type == R3D_LIGHT_SPOT) variant |= R3D_SHADER_LIGHTING_SPOT;
+    if (type == R3D_LIGHT_OMNI) variant |= R3D_SHADER_LIGHTING_OMNI;
+
+    return variant;
+}
+
 void r3d_shader_load_screen_scene(void)
 {
-    R3D.shader.screen.scene.id = rlLoadShaderCode(VS_COMMON_SCREEN, FS_SCREEN_SCENE);
+    R3D.shader.screen.scene.id = r3d_shader_compile(VS_COMMON_SCREEN, FS_SCREEN_SCENE);
     r3d_shader_screen_scene_t* shader = &R3D.shader.screen.scene;
 
     r3d_shader_get_location(screen.scene, uTexAlbedo);
@@ -1167,7 +1665,7 @@ void r3d_shader_load_screen_scene(void)
 
 void r3d_shader_load_screen_bloom(void)
 {
-    R3D.shader.screen.bloom.id = rlLoadShaderCode(
+    R3D.shader.screen.bloom.id = r3d_shader_compile(
         VS_COMMON_SCREEN, FS_SCREEN_BLOOM
     );
 
@@ -1182,71 +1680,134 @@ void r3d_shader_load_screen_bloom(void)
     r3d_shader_disable();
 }
 
-void r3d_shader_load_screen_fog(void)
+void r3d_shader_load_screen_post(R3D_Fog fog, R3D_Tonemap tonemap)
 {
-    R3D.shader.screen.fog.id = rlLoadShaderCode(
-        VS_COMMON_SCREEN, FS_SCREEN_FOG
+    // Fog and tonemap modes are resolved at compile time, one program per combination
+    char fogDefine[32], tonemapDefine[32];
+    snprintf(fogDefine, sizeof(fogDefine), "#define FOG_MODE %i", fog);
+    snprintf(tonemapDefine, sizeof(tonemapDefine), "#define TONEMAP_MODE %i", tonemap);
+
+    const char* defines[] = { fogDefine, tonemapDefine };
+    R3D.shader.screen.post[fog][tonemap].id = r3d_shader_compile_variant(
+        VS_COMMON_SCREEN, FS_SCREEN_POST, defines, 2
     );
 
-    r3d_shader_get_location(screen.fog, uTexColor);
-    r3d_shader_get_location(screen.fog, uTexDepth);
-    r3d_shader_get_location(screen.fog, uNear);
-    r3d_shader_get_location(screen.fog, uFar);
-    r3d_shader_get_location(screen.fog, uFogMode);
-    r3d_shader_get_location(screen.fog, uFogColor);
-    r3d_shader_get_location(screen.fog, uFogStart);
-    r3d_shader_get_location(screen.fog, uFogEnd);
-    r3d_shader_get_location(screen.fog, uFogDensity);
-
-    r3d_shader_enable(screen.fog);
-    r3d_shader_set_sampler2D_slot(screen.fog, uTexColor, 0);
-    r3d_shader_set_sampler2D_slot(screen.fog, uTexDepth, 1);
+    r3d_shader_get_location(screen.post[fog][tonemap], uTexColor);
+    r3d_shader_get_location(screen.post[fog][tonemap], uTexDepth);
+    r3d_shader_get_location(screen.post[fog][tonemap], uNear);
+    r3d_shader_get_location(screen.post[fog][tonemap], uFar);
+    r3d_shader_get_location(screen.post[fog][tonemap], uFogColor);
+    r3d_shader_get_location(screen.post[fog][tonemap], uFogStart);
+    r3d_shader_get_location(screen.post[fog][tonemap], uFogEnd);
+    r3d_shader_get_location(screen.post[fog][tonemap], uFogDensity);
+    r3d_shader_get_location(screen.post[fog][tonemap], uTonemapExposure);
+    r3d_shader_get_location(screen.post[fog][tonemap], uTonemapWhite);
+    r3d_shader_get_location(screen.post[fog][tonemap], uBrightness);
+    r3d_shader_get_location(screen.post[fog][tonemap], uContrast);
+    r3d_shader_get_location(screen.post[fog][tonemap], uSaturation);
+
+    r3d_shader_enable(screen.post[fog][tonemap]);
+    r3d_shader_set_sampler2D_slot(screen.post[fog][tonemap], uTexColor, 0);
+    r3d_shader_set_sampler2D_slot(screen.post[fog][tonemap], uTexDepth, 1);
     r3d_shader_disable();
 }
 
-void r3d_shader_load_screen_tonemap(void)
+void r3d_shader_load_screen_fxaa(void)
 {
-    R3D.shader.screen.tonemap.id = rlLoadShaderCode(
-        VS_COMMON_SCREEN, FS_SCREEN_TONEMAP
+    R3D.shader.screen.fxaa.id = r3d_shader_compile(
+        VS_COMMON_SCREEN, FS_SCREEN_FXAA
     );
 
-    r3d_shader_get_location(screen.tonemap, uTexColor);
-    r3d_shader_get_location(screen.tonemap, uTonemapMode);
-    r3d_shader_get_location(screen.tonemap, uTonemapExposure);
-    r3d_shader_get_location(screen.tonemap, uTonemapWhite);
+    r3d_shader_get_location(screen.fxaa, uTexture);
+    r3d_shader_get_location(screen.fxaa, uTexelSize);
+
+    r3d_shader_enable(screen.fxaa);
+    r3d_shader_set_sampler2D_slot(screen.fxaa, uTexture, 0);
+    r3d_shader_disable();
+}
 
-    r3d_shader_enable(screen.tonemap);
-    r3d_shader_set_sampler2D_slot(screen.tonemap, uTexColor, 0);
+void r3d_shader_load_screen_taa(void)
+{
+    R3D.shader.screen.taa.id = r3d_shader_compile(
+        VS_COMMON_SCREEN, FS_SCREEN_TAA
+    );
+
+    r3d_shader_get_location(screen.taa, uTexColor);
+    r3d_shader_get_location(screen.taa, uTexDepth);
+    r3d_shader_get_location(screen.taa, uTexHistory);
+    r3d_shader_get_location(screen.taa, uMatInvViewProj);
+    r3d_shader_get_location(screen.taa, uMatPrevViewProj);
+    r3d_shader_get_location(screen.taa, uJitter);
+    r3d_shader_get_location(screen.taa, uResolution);
+    r3d_shader_get_location(screen.taa, uBlend);
+
+    r3d_shader_enable(screen.taa);
+    r3d_shader_set_sampler2D_slot(screen.taa, uTexColor, 0);
+    r3d_shader_set_sampler2D_slot(screen.taa, uTexDepth, 1);
+    r3d_shader_set_sampler2D_slot(screen.taa, uTexHistory, 2);
     r3d_shader_disable();
 }
 
-void r3d_shader_load_screen_adjustment(void)
+void r3d_shader_load_screen_oit(void)
 {
-    R3D.shader.screen.adjustment.id = rlLoadShaderCode(
-        VS_COMMON_SCREEN, FS_SCREEN_ADJUSTMENT
+    R3D.shader.screen.oit.id = r3d_shader_compile(
+        VS_COMMON_SCREEN, FS_SCREEN_OIT
     );
 
-    r3d_shader_get_location(screen.adjustment, uTexColor);
-    r3d_shader_get_location(screen.adjustment, uBrightness);
-    r3d_shader_get_location(screen.adjustment, uContrast);
-    r3d_shader_get_location(screen.adjustment, uSaturation);
+    r3d_shader_get_location(screen.oit, uTexAccum);
+    r3d_shader_get_location(screen.oit, uTexWeight);
 
-    r3d_shader_enable(screen.adjustment);
-    r3d_shader_set_sampler2D_slot(screen.adjustment, uTexColor, 0);
+    r3d_shader_enable(screen.oit);
+    r3d_shader_set_sampler2D_slot(screen.oit, uTexAccum, 0);
+    r3d_shader_set_sampler2D_slot(screen.oit, uTexWeight, 1);
     r3d_shader_disable();
 }
 
-void r3d_shader_load_screen_fxaa(void)
+void r3d_shader_load_simulate_particles(void)
 {
-    R3D.shader.screen.fxaa.id = rlLoadShaderCode(
-        VS_COMMON_SCREEN, FS_SCREEN_FXAA
+    // Output order must match the particle state layout in 'r3d_particles.c'
+    const char* varyings[] = {
+        "vModel0", "vModel1", "vModel2", "vModel3", "vColor",
+        "vPositionLifetime", "vVelocity", "vRotation",
+        "vBaseVelocity", "vBaseAngularVelocity", "vBaseScaleOpacity"
+    };
+
+    R3D.shader.simulate.particles.id = r3d_shader_compile_feedback(
+        VS_SIMULATE_PARTICLES, varyings, sizeof(varyings) / sizeof(*varyings)
     );
 
-    r3d_shader_get_location(screen.fxaa, uTexture);
-    r3d_shader_get_location(screen.fxaa, uTexelSize);
+    if (R3D.shader.simulate.particles.id == 0) {
+        return;
+    }
 
-    r3d_shader_enable(screen.fxaa);
-    r3d_shader_set_sampler2D_slot(screen.fxaa, uTexture, 0);
+    r3d_shader_get_location(simulate.particles, uTexCurves);
+    r3d_shader_get_location(simulate.particles, uSpeedCurve);
+    r3d_shader_get_location(simulate.particles, uDeltaTime);
+    r3d_shader_get_location(simulate.particles, uLifetime);
+    r3d_shader_get_location(simulate.particles, uGravity);
+    r3d_shader_get_location(simulate.particles, uSeed);
+    r3d_shader_get_location(simulate.particles, uCapacity);
+    r3d_shader_get_location(simulate.particles, uEmitStart);
+    r3d_shader_get_location(simulate.particles, uEmitCount);
+    r3d_shader_get_location(simulate.particles, uPosition);
+    r3d_shader_get_location(simulate.particles, uEmitDirection);
+    r3d_shader_get_location(simulate.particles, uEmitBinormal);
+    r3d_shader_get_location(simulate.particles, uEmitNormal);
+    r3d_shader_get_location(simulate.particles, uEmitSpeed);
+    r3d_shader_get_location(simulate.particles, uSpreadAngle);
+    r3d_shader_get_location(simulate.particles, uLifetimeVariance);
+    r3d_shader_get_location(simulate.particles, uInitialRotation);
+    r3d_shader_get_location(simulate.particles, uRotationVariance);
+    r3d_shader_get_location(simulate.particles, uInitialScale);
+    r3d_shader_get_location(simulate.particles, uScaleVariance);
+    r3d_shader_get_location(simulate.particles, uVelocityVariance);
+    r3d_shader_get_location(simulate.particles, uInitialAngularVelocity);
+    r3d_shader_get_location(simulate.particles, uAngularVelocityVariance);
+    r3d_shader_get_location(simulate.particles, uInitialColor);
+    r3d_shader_get_location(simulate.particles, uColorVariance);
+
+    r3d_shader_enable(simulate.particles);
+    r3d_shader_set_sampler1D_slot(simulate.particles, uTexCurves, 0);
     r3d_shader_disable();
 }
 
@@ -1292,8 +1853,6 @@ void r3d_texture_load_rand_noise(void)
 
 void r3d_texture_load_ssao_kernel(void)
 {
-#   define R3D_SSAO_KERNEL_SIZE 32
-
     r3d_half_t kernel[3 * R3D_SSAO_KERNEL_SIZE] = { 0 };
 
     for (int i = 0; i < R3D_SSAO_KERNEL_SIZE; i++)
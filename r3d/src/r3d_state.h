@@ -22,10 +22,20 @@
 
 #include "r3d.h"
 
+#include <stdint.h>
+
 #include "./details/r3d_frustum.h"
 #include "./details/r3d_primitives.h"
+#include "./details/r3d_drawcall.h"
+#include "./details/containers/r3d_arena.h"
 #include "./details/containers/r3d_array.h"
 #include "./details/containers/r3d_registry.h"
+#include "./details/r3d_light_cull.h"
+#include "./details/r3d_readback.h"
+#include "./details/r3d_capture.h"
+#include "./details/r3d_render_graph.h"
+#include "./details/r3d_gpu_timer.h"
+#include "./details/r3d_scene_query.h"
 
 #include "./embedded/r3d_shaders.h"
 
@@ -33,6 +43,108 @@
 
 #define R3D_GBUFFER_COUNT 4
 
+#define R3D_FRAME_ARENA_SIZE (256 * 1024)       //< Initial capacity of the frame arena, grows as needed
+
+#define R3D_DYNAMIC_RESOLUTION_STEP 0.05f       //< Scales are multiples of this step, bounds the number of distinct sizes
+#define R3D_DYNAMIC_RESOLUTION_COOLDOWN 30      //< Frames measured at a scale before it can change again
+
+#define R3D_SSAO_KERNEL_SIZE 32                 //< Must match 'KERNEL_SIZE' in the SSAO shader
+#define R3D_SSAO_TEMPORAL_SAMPLES 8             //< Kernel samples per frame in temporal mode, must divide the kernel size
+#define R3D_SSAO_TEMPORAL_BLEND 0.2f            //< Weight of the current frame against the reprojected SSAO
+
+#define R3D_TAA_JITTER_SAMPLES 16               //< Length of the Halton (2, 3) jitter sequence
+#define R3D_TAA_BLEND 0.1f                      //< Weight of a sample falling on the pixel center against the history
+
+#define R3D_SHADER_POST_FOG_VARIANTS 4          //< One variant per 'R3D_Fog' mode
+#define R3D_SHADER_POST_TONEMAP_VARIANTS 5      //< One variant per 'R3D_Tonemap' mode
+
+#define R3D_SHADER_LIGHTING_SHADOW (1 << 0)     //< Compiles the shadow sampling code
+#define R3D_SHADER_LIGHTING_SPOT (1 << 1)       //< Compiles the spot light attenuation and cone
+#define R3D_SHADER_LIGHTING_OMNI (1 << 2)       //< Compiles the omni light attenuation
+#define R3D_SHADER_LIGHTING_VARIANTS (1 << 3)   //< Number of lighting feature combinations
+
+#ifndef R3D_SHADER_CACHE_DIRECTORY
+#   define R3D_SHADER_CACHE_DIRECTORY "r3d_shader_cache"   //< Used with 'R3D_FLAG_SHADER_CACHE'
+#endif
+
+#ifndef R3D_SKYBOX_CACHE_DIRECTORY
+#   define R3D_SKYBOX_CACHE_DIRECTORY "r3d_skybox_cache"   //< Used with 'R3D_FLAG_SKYBOX_CACHE'
+#endif
+
+
+/* === Types === */
+
+// Render targets declared in the render graph, in the order of their bits in the pass masks
+typedef enum {
+    R3D_TARGET_ALBEDO,
+    R3D_TARGET_EMISSION,
+    R3D_TARGET_NORMAL,
+    R3D_TARGET_ORM,
+    R3D_TARGET_DEPTH,
+    R3D_TARGET_SSAO,
+    R3D_TARGET_DIFFUSE,             //< Transient, dead once the deferred lighting is resolved into the scene
+    R3D_TARGET_SPECULAR,            //< Transient, dead once the deferred lighting is resolved into the scene
+    R3D_TARGET_SCENE,
+    R3D_TARGET_OIT,                 //< Accumulation and weight of the transparent surfaces
+    R3D_TARGET_BLOOM,
+    R3D_TARGET_HISTORY,             //< Persistent, the TAA output kept for the next frame
+    R3D_TARGET_POST_SOURCE,         //< Transient, born when the post-processing starts
+    R3D_TARGET_POST_TARGET,         //< Transient, born when the post-processing starts
+    R3D_TARGET_COUNT
+} r3d_target_t;
+
+// Layout of one particle in the GPU state buffers, in the output order of the simulation shader
+// The first two members are read directly as instance transform and color when drawing
+typedef struct {
+    Vector4 model[4];               //< Rows of the particle transform
+    unsigned int color;             //< RGBA color, alpha scaled by the opacity curve
+    Vector4 positionLifetime;       //< Position and remaining lifetime
+    Vector3 velocity;
+    Vector3 rotation;               //< Radians
+    Vector3 baseVelocity;
+    Vector3 baseAngularVelocity;    //< Degrees per second
+    Vector4 baseScaleOpacity;       //< Initial scale and opacity (0-255)
+} r3d_particle_gpu_t;
+
+// Per-instance data of a sprite batch, transforms are given to the GPU before billboarding
+typedef struct {
+    Matrix transform;
+    Vector4 texCoord;               //< UV offset in xy and scale in zw of the current frame
+} r3d_sprite_instance_t;
+
+// Everything that must match for two sprites to be drawn by the same instanced call
+typedef struct {
+    unsigned int shader;
+    unsigned int textures[6];       //< Albedo, normal, emission, occlusion, roughness and metalness maps
+    Color albedo;
+    Color emission;
+    float values[4];                //< Emission, occlusion, roughness and metalness factors
+    R3D_BillboardMode billboardMode;
+    R3D_ShadowCastMode shadowCastMode;
+    R3D_BlendMode blendMode;
+    float alphaScissorThreshold;
+    int forward;
+} r3d_sprite_batch_key_t;
+
+// Camera, destination and visible lights of one view rendered by 'R3D_End'
+typedef struct {
+    Rectangle viewport;             //< Destination area in pixels, top-left origin, a zero size covers everything
+    float scale;                    //< Scale of the internal resolution, below 1 the view renders to its own targets
+    Matrix view, invView;
+    Matrix proj, invProj;
+    Vector3 position;
+    r3d_frustum_t frustum;
+    BoundingBox frustumAABB;
+    r3d_array_t lights;             //< Array of 'r3d_light_batched_t' in the frame arena, filled by 'R3D_End'
+} r3d_view_t;
+
+typedef struct {
+    r3d_sprite_batch_key_t key;
+    uint64_t hash;
+    r3d_drawcall_t call;            //< Shared state, instance data is assigned when the batch is flushed
+    r3d_array_t instances;          //< Array of 'r3d_sprite_instance_t' in the frame arena
+} r3d_sprite_batch_t;
+
 
 /* === Global r3d state === */
 
@@ -44,10 +156,11 @@ extern struct R3D_State {
         bool TEX_RGB16F;
         bool TEX_RGB32F;
         bool TEX_R11G11B10F;
+        bool PROGRAM_BINARY;
     } support;
 
     // Framebuffers
-    struct {
+    struct r3d_framebuffers_t {
 
         // G-Buffer
         struct r3d_fb_gbuffer_t {
@@ -64,6 +177,8 @@ extern struct R3D_State {
             unsigned int id;
             unsigned int source;            ///< R[8] -> Used for initial SSAO rendering + blur effect
             unsigned int target;            ///< R[8] -> Used for initial SSAO rendering + blur effect
+            unsigned int history;           ///< RG[16|16] -> Accumulated SSAO and view distance of the last frame (temporal mode)
+            unsigned int accumulated;       ///< RG[16|16] -> Accumulated SSAO and view distance of this frame (temporal mode)
         } pingPongSSAO;
 
         // Deferred lighting
@@ -104,22 +219,48 @@ extern struct R3D_State {
             unsigned int target;            ///< RGB[11|11|10] (or 16F || 32F || 8UI)
         } post;
 
+        // Temporal anti-aliasing ping-pong buffer (output resolution)
+        struct r3d_fb_pingpong_taa_t {
+            unsigned int id;
+            unsigned int source;            ///< RGB[11|11|10] (or 16F || 32F || 8UI) -> History, resolved last frame
+            unsigned int target;            ///< RGB[11|11|10] (or 16F || 32F || 8UI) -> Resolved this frame
+        } taa;
+
+        // Weighted blended transparency targets, sharing the G-buffer depth (internal resolution)
+        struct r3d_fb_oit_t {
+            unsigned int id;
+            unsigned int accum;             ///< RGBA[16|16|16|16]F (or 32F) -> Weighted premultiplied color, revealage in alpha
+            unsigned int weight;            ///< R[16]F (or 32F) -> Sum of the weights
+        } oit;
+
         // Custom target (optional)
         RenderTexture customTarget;
 
+        // Storage of the transient targets, indexed by render graph slot
+        unsigned int transient[R3D_RENDER_GRAPH_MAX_RESOURCES];
+
     } framebuffer;
 
     // Containers
     struct {
 
+        r3d_arena_t frameArena;     //< Backs the per-frame containers below, reset by 'R3D_Begin'
+
         r3d_array_t aDrawDeferred;
         r3d_array_t aDrawDeferredInst;
 
         r3d_array_t aDrawForward;
         r3d_array_t aDrawForwardInst;
 
+        r3d_array_t aSpriteBatches;
+
         r3d_registry_t rLights;
         r3d_array_t aLightBatch;
+        r3d_light_cull_t lightCull;
+
+        r3d_render_graph_t renderGraph;
+
+        r3d_scene_query_t sceneQuery;   //< Meshes of the last frame, gathered with 'R3D_FLAG_SCENE_QUERIES'
 
     } container;
 
@@ -152,17 +293,39 @@ extern struct R3D_State {
         // Screen shaders
         struct {
             r3d_shader_screen_ssao_t ssao;
+            r3d_shader_screen_ssao_temporal_t ssaoTemporal;
             r3d_shader_screen_ambient_ibl_t ambientIbl;
             r3d_shader_screen_ambient_t ambient;
-            r3d_shader_screen_lighting_t lighting;
+            r3d_shader_screen_lighting_t lighting[R3D_SHADER_LIGHTING_VARIANTS];
             r3d_shader_screen_scene_t scene;
             r3d_shader_screen_bloom_t bloom;
-            r3d_shader_screen_fog_t fog;
-            r3d_shader_screen_tonemap_t tonemap;
-            r3d_shader_screen_adjustment_t adjustment;
+            r3d_shader_screen_post_t post[R3D_SHADER_POST_FOG_VARIANTS][R3D_SHADER_POST_TONEMAP_VARIANTS];
             r3d_shader_screen_fxaa_t fxaa;
+            r3d_shader_screen_taa_t taa;
+            r3d_shader_screen_oit_t oit;
         } screen;
 
+        // Simulation shaders, run with rasterization disabled
+        struct {
+            r3d_shader_simulate_particles_t particles;
+        } simulate;
+
+        // Compilation statistics
+        struct {
+            int programCount;           //< Total number of programs compiled
+            int variantCount;           //< Number of programs compiled from a feature mask
+            double compileTime;         //< Accumulated compile and link time (seconds)
+            double maxCompileTime;      //< Slowest single program compile time (seconds)
+            int cacheHits;              //< Number of programs loaded from the binary cache
+            double cacheSavedTime;      //< Source compile time avoided by the binary cache (seconds)
+        } stats;
+
+        // Program binary cache
+        struct {
+            bool enabled;
+            uint64_t driverHash;            //< Hash of the GL vendor, renderer and version strings
+        } cache;
+
     } shader;
 
     // Environment data
@@ -179,6 +342,7 @@ extern struct R3D_State {
         float ssaoRadius;           // (pre-light pass)
         float ssaoBias;             // (pre-light pass)
         int ssaoIterations;         // (pre-light pass)
+        bool ssaoTemporal;          // (pre-light pass)
 
         R3D_Bloom bloomMode;        // (post pass)
         float bloomIntensity;       // (post pass)
@@ -217,6 +381,15 @@ extern struct R3D_State {
         r3d_primitive_t cube;
     } primitive;
 
+    // Asynchronous readbacks
+    struct {
+        r3d_readback_ring_t requests;   //< Requests made through 'R3D_RequestReadback'
+        r3d_readback_ring_t capture;    //< Frames copied for the capture writer, fetched in order
+        r3d_capture_t* writer;          //< Y4M writer, NULL when no capture is running
+        int captureWidth;
+        int captureHeight;
+    } readback;
+
     // State data
     struct {
 
@@ -233,19 +406,84 @@ extern struct R3D_State {
             BoundingBox aabb;
         } frustum;
 
+        // Views of the frame, the camera transformations and the frustum above are those of the current one
+        struct {
+            r3d_view_t list[R3D_MAX_VIEWS];
+            int count;
+            int current;                //< View being rendered, 0 outside of 'R3D_End'
+            r3d_array_t shadowLights;   //< Lights seen by any view that cast shadows, 'r3d_light_batched_t' in the frame arena
+        } views;
+
         // Scene data
         struct {
             BoundingBox bounds;
         } scene;
 
         // Resolution
-        struct {
+        struct r3d_resolution_t {
             int width;
             int height;
             float texelX;
             float texelY;
+            int outputWidth;            //< Resolution of the post-processing, the base resolution when TAA upsamples
+            int outputHeight;
         } resolution;
 
+        // Targets of the views rendered at a reduced resolution, swapped with the full ones while they render
+        struct r3d_view_targets_t {
+            struct r3d_framebuffers_t framebuffer;
+            struct r3d_resolution_t resolution;     //< Zero while the targets are not loaded
+        } viewTargets[R3D_MAX_VIEWS];
+
+        // Dynamic resolution
+        struct r3d_dynamic_resolution_t {
+            bool enabled;
+            float targetTime;           //< Frame time budget in milliseconds
+            float minScale;
+            float maxScale;
+            float scale;                //< Current scale applied to the base resolution
+            float frameTime;            //< Filtered frame time in milliseconds, 0 until measured
+            int cooldown;               //< Frames left before the scale can change again
+            int baseWidth;              //< Resolution given to 'R3D_Init' or 'R3D_UpdateResolution'
+            int baseHeight;
+        } dynamicResolution;
+
+        // Frame statistics, the counters are reset by 'R3D_Begin'
+        struct r3d_stats_t {
+            int drawCalls;              //< Mesh and sprite draws, shadow maps included
+            int instances;
+            int triangles;
+            int lights;                 //< Lights found visible by the culling, summed over the views
+            double cpuStart;            //< Time of the last 'R3D_Begin', in seconds
+            double cpuTime;             //< Time spent between the last 'R3D_Begin' and 'R3D_End', in milliseconds
+            double gpuTime;             //< Last GPU time of 'R3D_End' collected, in milliseconds
+            bool gpuTimeUpdated;        //< True if 'gpuTime' was collected by the last 'R3D_Begin'
+            r3d_gpu_timer_t gpuTimer;
+            double passCpuStart;
+            bool passExecuted[R3D_RENDER_GRAPH_MAX_PASSES];    //< True if the pass ran for any view
+            double passCpuTime[R3D_RENDER_GRAPH_MAX_PASSES];   //< Milliseconds summed over the views, indexed like the render graph passes
+            double passGpuTime[R3D_RENDER_GRAPH_MAX_PASSES];   //< Milliseconds, only measured with 'R3D_FLAG_PASS_TIMINGS'
+            r3d_gpu_timer_t passGpuTimers[R3D_RENDER_GRAPH_MAX_PASSES];
+        } stats;
+
+        // Temporal SSAO
+        struct {
+            Matrix prevViewProj;        //< View-projection of the frame in the history
+            Vector3 prevPosition;       //< Camera position of the frame in the history
+            unsigned int frameIndex;    //< Selects the kernel subset and the noise offset
+            bool historyValid;          //< False until a frame has been accumulated since the targets were loaded
+        } ssaoHistory;
+
+        // Temporal anti-aliasing
+        struct {
+            Matrix viewProj;            //< Unjittered view-projection of the current frame
+            Matrix invViewProj;
+            Matrix prevViewProj;        //< Unjittered view-projection of the frame in the history
+            Vector2 jitter;             //< Sub-pixel offset of the current frame, in UV units
+            unsigned int frameIndex;    //< Position in the jitter sequence
+            bool historyValid;          //< False until a frame has been resolved since the targets were loaded
+        } taa;
+
         // Render config
         struct {
             R3D_RenderMode mode;
@@ -253,6 +491,7 @@ extern struct R3D_State {
             R3D_ShadowCastMode shadowCastMode;
             R3D_BillboardMode billboardMode;
             float alphaScissorThreshold;
+            int queryId;
         } render;
 
         // Miscellaneous flags
@@ -292,6 +531,8 @@ void r3d_framebuffer_load_deferred(int width, int height);
 void r3d_framebuffer_load_scene(int width, int height);
 void r3d_framebuffer_load_mipchain_bloom(int width, int height);
 void r3d_framebuffer_load_pingpong_post(int width, int height);
+void r3d_framebuffer_load_pingpong_taa(int width, int height);
+void r3d_framebuffer_load_oit(int width, int height);
 
 void r3d_framebuffer_unload_gbuffer(void);
 void r3d_framebuffer_unload_pingpong_ssao(void);
@@ -299,6 +540,8 @@ void r3d_framebuffer_unload_deferred(void);
 void r3d_framebuffer_unload_scene(void);
 void r3d_framebuffer_unload_mipchain_bloom(void);
 void r3d_framebuffer_unload_pingpong_post(void);
+void r3d_framebuffer_unload_pingpong_taa(void);
+void r3d_framebuffer_unload_oit(void);
 
 
 /* === Shader loading functions === */
@@ -319,15 +562,19 @@ void r3d_shader_load_raster_depth_inst(void);
 void r3d_shader_load_raster_depth_cube(void);
 void r3d_shader_load_raster_depth_cube_inst(void);
 void r3d_shader_load_screen_ssao(void);
+void r3d_shader_load_screen_ssao_temporal(void);
 void r3d_shader_load_screen_ambient_ibl(void);
 void r3d_shader_load_screen_ambient(void);
-void r3d_shader_load_screen_lighting(void);
+void r3d_shader_load_screen_lighting(int variant);
 void r3d_shader_load_screen_scene(void);
 void r3d_shader_load_screen_bloom(void);
-void r3d_shader_load_screen_fog(void);
-void r3d_shader_load_screen_tonemap(void);
-void r3d_shader_load_screen_adjustment(void);
+void r3d_shader_load_screen_post(R3D_Fog fog, R3D_Tonemap tonemap);
 void r3d_shader_load_screen_fxaa(void);
+void r3d_shader_load_screen_taa(void);
+void r3d_shader_load_screen_oit(void);
+void r3d_shader_load_simulate_particles(void);
+
+int r3d_shader_get_lighting_variant(R3D_LightType type, bool shadow);
 
 
 /* === Texture loading functions === */
@@ -150,8 +150,8 @@ Texture2D R3D_GetBufferColor(void)
 {
     Texture2D texture = { 0 };
     texture.id = R3D.framebuffer.post.target;
-    texture.width = R3D.state.resolution.width;
-    texture.height = R3D.state.resolution.height;
+    texture.width = R3D.state.resolution.outputWidth;
+    texture.height = R3D.state.resolution.outputHeight;
     texture.mipmaps = 1;
     texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8;
     return texture;
@@ -179,6 +179,60 @@ Texture2D R3D_GetBufferDepth(void)
     return texture;
 }
 
+unsigned int R3D_RequestReadback(R3D_ReadbackBuffer buffer)
+{
+    bool depth = (buffer == R3D_READBACK_DEPTH);
+
+    // The color is read after post-processing, at the output resolution
+    unsigned int request = r3d_readback_push(
+        &R3D.readback.requests,
+        depth ? R3D.framebuffer.gBuffer.id : R3D.framebuffer.post.id,
+        depth ? R3D.state.resolution.width : R3D.state.resolution.outputWidth,
+        depth ? R3D.state.resolution.height : R3D.state.resolution.outputHeight,
+        depth
+    );
+
+    if (request == 0) {
+        TraceLog(LOG_WARNING, "R3D: Too many pending readbacks, retrieve their results before requesting new ones");
+    }
+
+    return request;
+}
+
+bool R3D_IsReadbackReady(unsigned int request)
+{
+    return r3d_readback_poll(&R3D.readback.requests, request, false) == R3D_READBACK_STATUS_READY;
+}
+
+bool R3D_GetReadbackImage(unsigned int request, Image* image, bool wait)
+{
+    r3d_readback_slot_t* slot = r3d_readback_find(&R3D.readback.requests, request);
+    if (slot == NULL) {
+        TraceLog(LOG_WARNING, "R3D: Unknown readback request [ID %u]", request);
+        return false;
+    }
+
+    if (r3d_readback_poll(&R3D.readback.requests, request, wait) != R3D_READBACK_STATUS_READY) {
+        return false;
+    }
+
+    Image result = { 0 };
+    result.width = slot->width;
+    result.height = slot->height;
+    result.mipmaps = 1;
+    result.format = (slot->pixelSize == 3) ? PIXELFORMAT_UNCOMPRESSED_R8G8B8 : PIXELFORMAT_UNCOMPRESSED_R32;
+    result.data = RL_MALLOC(slot->width * slot->height * slot->pixelSize);
+
+    if (r3d_readback_fetch(&R3D.readback.requests, request, result.data, false) != R3D_READBACK_STATUS_READY) {
+        RL_FREE(result.data);
+        return false;
+    }
+
+    *image = result;
+
+    return true;
+}
+
 Matrix R3D_GetMatrixView(void)
 {
     return R3D.state.transform.view;
@@ -281,6 +335,10 @@ void R3D_DrawBufferORM(float x, float y, float w, float h)
 
 void R3D_DrawBufferSSAO(float x, float y, float w, float h)
 {
+    if (R3D.framebuffer.pingPongSSAO.id == 0) {
+        return;
+    }
+
     Texture2D tex = {
         .id = R3D.framebuffer.pingPongSSAO.target,
         .width = R3D.state.resolution.width / 2,
@@ -301,6 +359,10 @@ void R3D_DrawBufferSSAO(float x, float y, float w, float h)
 
 void R3D_DrawBufferBloom(float x, float y, float w, float h)
 {
+    if (R3D.framebuffer.mipChainBloom.id == 0) {
+        return;
+    }
+
     Texture2D tex = {
         .id = R3D.framebuffer.mipChainBloom.mipChain[0].id,
         .width = R3D.state.resolution.width / 2,